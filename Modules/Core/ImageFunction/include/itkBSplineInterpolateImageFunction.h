@@ -160,21 +160,31 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override
   {
-    // Don't know thread information, make evaluateIndex, weights on the stack.
-    // Slower, but safer.
-    vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
-    vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
-
-    // Pass evaluateIndex, weights by reference. They're only good as long
-    // as this method is in scope.
-    return this->EvaluateAtContinuousIndexInternal(index, evaluateIndex, weights);
+    // The working space of the supported spline orders is on the stack, so
+    // no thread information is needed.
+    OutputType value;
+    this->EvaluateAtContinuousIndicesWithSplineOrder(&index, &value, 1);
+    return value;
   }
 
   virtual OutputType
-  EvaluateAtContinuousIndex(const ContinuousIndexType & x, ThreadIdType threadId) const
+  EvaluateAtContinuousIndex(const ContinuousIndexType & x, ThreadIdType itkNotUsed(threadId)) const
+  {
+    return this->EvaluateAtContinuousIndex(x);
+  }
+
+  /** Evaluate the function at a batch of ContinuousIndex positions.
+   *
+   * The weights along a dimension are only computed again when the
+   * coordinate along this dimension differs from that of the previous
+   * position, which saves most of the weight computations along the scan
+   * lines of an axis-aligned resampling. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
   {
-    // Pass evaluateIndex, weights by reference. Different threadIDs get different instances.
-    return this->EvaluateAtContinuousIndexInternal(x, m_ThreadedEvaluateIndex[threadId], m_ThreadedWeights[threadId]);
+    this->EvaluateAtContinuousIndicesWithSplineOrder(indices, values, numberOfIndices);
   }
 
   CovariantVectorType
@@ -379,6 +389,39 @@ private:
                        vnl_matrix<double> &        weights,
                        unsigned int                splineOrder) const;
 
+  /** Evaluates the interpolation at the positions with the implementation
+   * of EvaluateAtContinuousIndicesWithFixedOrder() for m_SplineOrder. */
+  void
+  EvaluateAtContinuousIndicesWithSplineOrder(const ContinuousIndexType * indices,
+                                             OutputType *                values,
+                                             SizeValueType               numberOfIndices) const;
+
+  /** Evaluates the interpolation with a spline order known at compile time.
+   * The weights and the offsets of the coefficients in the region of support
+   * are kept in fixed size arrays on the stack, and the weighted sum is
+   * computed separably, one dimension at a time. */
+  template <unsigned int VSplineOrder>
+  void
+  EvaluateAtContinuousIndicesWithFixedOrder(const ContinuousIndexType * indices,
+                                            OutputType *                values,
+                                            SizeValueType               numberOfIndices) const;
+
+  /** Determines the weights of a spline of order VSplineOrder, for the
+   * distance w of the position to the point of the region of support from
+   * which the weights of SetInterpolationWeights() are computed. */
+  template <unsigned int VSplineOrder>
+  static void
+  SetFixedOrderInterpolationWeights(double w, FixedArray<double, VSplineOrder + 1> & weights);
+
+  /** Sums the coefficients at the offsets of the region of support along
+   * the dimensions up to VDimension, weighted by the product of the weights
+   * along these dimensions. */
+  template <unsigned int VDimension, unsigned int VSplineOrder>
+  static double
+  SumWeightedCoefficients(const CoefficientDataType *                           coefficients,
+                          const FixedArray<double, VSplineOrder + 1> *          weights,
+                          const FixedArray<OffsetValueType, VSplineOrder + 1> * offsets);
+
   /** Precomputation for converting the 1D index of the interpolation
    *  neighborhood to an N-dimensional index. */
   void
@@ -530,6 +530,200 @@ BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::Evalua
   return (interpolated);
 }
 
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::EvaluateAtContinuousIndicesWithSplineOrder(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  switch (m_SplineOrder)
+  {
+    case 0:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<0>(indices, values, numberOfIndices);
+      break;
+    case 1:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<1>(indices, values, numberOfIndices);
+      break;
+    case 2:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<2>(indices, values, numberOfIndices);
+      break;
+    case 3:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<3>(indices, values, numberOfIndices);
+      break;
+    case 4:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<4>(indices, values, numberOfIndices);
+      break;
+    case 5:
+      this->EvaluateAtContinuousIndicesWithFixedOrder<5>(indices, values, numberOfIndices);
+      break;
+    default:
+    {
+      // Reports the unsupported spline order
+      vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+      vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        values[i] = this->EvaluateAtContinuousIndexInternal(indices[i], evaluateIndex, weights);
+      }
+      break;
+    }
+  }
+}
+
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+template <unsigned int VSplineOrder>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::EvaluateAtContinuousIndicesWithFixedOrder(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  constexpr unsigned int SupportSize = VSplineOrder + 1;
+  constexpr float        halfOffset = VSplineOrder & 1 ? 0.0 : 0.5;
+
+  const IndexType               startIndex = this->GetStartIndex();
+  const IndexType               endIndex = this->GetEndIndex();
+  const IndexType               bufferStart = m_Coefficients->GetBufferedRegion().GetIndex();
+  const OffsetValueType * const offsetTable = m_Coefficients->GetOffsetTable();
+  const CoefficientDataType *   coefficients = m_Coefficients->GetBufferPointer();
+
+  FixedArray<FixedArray<double, SupportSize>, ImageDimension>          weights;
+  FixedArray<FixedArray<OffsetValueType, SupportSize>, ImageDimension> offsets;
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    const ContinuousIndexType & x = indices[i];
+    for (unsigned int n = 0; n < ImageDimension; ++n)
+    {
+      if (i > 0 && Math::ExactlyEquals(x[n], indices[i - 1][n]))
+      {
+        continue;
+      }
+
+      // Region of support, weights and mirror boundary conditions, as in
+      // DetermineRegionOfSupport(), SetInterpolationWeights() and
+      // ApplyMirrorBoundaryConditions()
+      const auto supportCenter = static_cast<IndexValueType>(std::floor(static_cast<float>(x[n]) + halfOffset));
+      SetFixedOrderInterpolationWeights<VSplineOrder>(x[n] - static_cast<double>(supportCenter), weights[n]);
+
+      IndexValueType evaluateIndex = supportCenter - static_cast<IndexValueType>(VSplineOrder / 2);
+      for (unsigned int k = 0; k < SupportSize; ++k, ++evaluateIndex)
+      {
+        IndexValueType mirroredIndex = evaluateIndex;
+        if (m_DataLength[n] == 1)
+        {
+          mirroredIndex = startIndex[n];
+        }
+        else
+        {
+          if (mirroredIndex < startIndex[n])
+          {
+            mirroredIndex = startIndex[n] + (startIndex[n] - mirroredIndex);
+          }
+          if (mirroredIndex >= endIndex[n])
+          {
+            mirroredIndex = endIndex[n] - (mirroredIndex - endIndex[n]);
+          }
+        }
+        offsets[n][k] = (mirroredIndex - bufferStart[n]) * offsetTable[n];
+      }
+    }
+
+    values[i] = static_cast<OutputType>(
+      SumWeightedCoefficients<ImageDimension - 1, VSplineOrder>(coefficients, weights.data(), offsets.data()));
+  }
+}
+
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+template <unsigned int VDimension, unsigned int VSplineOrder>
+double
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::SumWeightedCoefficients(
+  const CoefficientDataType *                           coefficients,
+  const FixedArray<double, VSplineOrder + 1> *          weights,
+  const FixedArray<OffsetValueType, VSplineOrder + 1> * offsets)
+{
+  double sum = 0.0;
+  for (unsigned int k = 0; k <= VSplineOrder; ++k)
+  {
+    if constexpr (VDimension == 0)
+    {
+      sum += weights[0][k] * coefficients[offsets[0][k]];
+    }
+    else
+    {
+      sum += weights[VDimension][k] * SumWeightedCoefficients<VDimension - 1, VSplineOrder>(
+                                        coefficients + offsets[VDimension][k], weights, offsets);
+    }
+  }
+  return sum;
+}
+
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+template <unsigned int VSplineOrder>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::SetFixedOrderInterpolationWeights(
+  double                                 w,
+  FixedArray<double, VSplineOrder + 1> & weights)
+{
+  // Same computations as in SetInterpolationWeights()
+  if constexpr (VSplineOrder == 0)
+  {
+    weights[0] = 1; // implements nearest neighbor
+  }
+  else if constexpr (VSplineOrder == 1)
+  {
+    weights[1] = w;
+    weights[0] = 1.0 - w;
+  }
+  else if constexpr (VSplineOrder == 2)
+  {
+    weights[1] = 0.75 - w * w;
+    weights[2] = 0.5 * (w - weights[1] + 1.0);
+    weights[0] = 1.0 - weights[1] - weights[2];
+  }
+  else if constexpr (VSplineOrder == 3)
+  {
+    weights[3] = (1.0 / 6.0) * w * w * w;
+    weights[0] = (1.0 / 6.0) + 0.5 * w * (w - 1.0) - weights[3];
+    weights[2] = w + weights[0] - 2.0 * weights[3];
+    weights[1] = 1.0 - weights[0] - weights[2] - weights[3];
+  }
+  else if constexpr (VSplineOrder == 4)
+  {
+    const double w2 = w * w;
+    const double t = (1.0 / 6.0) * w2;
+    weights[0] = 0.5 - w;
+    weights[0] *= weights[0];
+    weights[0] *= (1.0 / 24.0) * weights[0];
+    const double t0 = w * (t - 11.0 / 24.0);
+    const double t1 = 19.0 / 96.0 + w2 * (0.25 - t);
+    weights[1] = t1 + t0;
+    weights[3] = t1 - t0;
+    weights[4] = weights[0] + t0 + 0.5 * w;
+    weights[2] = 1.0 - weights[0] - weights[1] - weights[3] - weights[4];
+  }
+  else
+  {
+    static_assert(VSplineOrder == 5, "SplineOrder must be between 0 and 5.");
+    double w2 = w * w;
+    weights[5] = (1.0 / 120.0) * w * w2 * w2;
+    w2 -= w;
+    const double w4 = w2 * w2;
+    w -= 0.5;
+    const double t = w2 * (w2 - 3.0);
+    weights[0] = (1.0 / 24.0) * (1.0 / 5.0 + w2 + w4) - weights[5];
+    double t0 = (1.0 / 24.0) * (w2 * (w2 - 5.0) + 46.0 / 5.0);
+    double t1 = (-1.0 / 12.0) * w * (t + 4.0);
+    weights[2] = t0 + t1;
+    weights[3] = t0 - t1;
+    t0 = (1.0 / 16.0) * (9.0 / 5.0 - t);
+    t1 = (1.0 / 24.0) * w * (w4 - w2 - 5.0);
+    weights[1] = t0 + t1;
+    weights[4] = t0 - t1;
+  }
+}
+
 template <typename TImageType, typename TCoordRep, typename TCoefficientType>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::
@@ -40,6 +40,14 @@ namespace itk
  *   2. Alpha - a scalar specifying the cutoff distance over which the function
  *      is calculated.
  *
+ * The interpolation kernel is separable: the region of the image over
+ * which it is evaluated is read directly from the buffer, and the sums
+ * over it are computed from the sums of each line along the first
+ * dimension, weighted by the error function arrays of that dimension.
+ * EvaluateAtContinuousIndices() only computes the error function array
+ * along a dimension again when the coordinate along it differs from the
+ * one of the previous position.
+ *
  * This work was originally described in the Insight Journal article:
  * P. Yushkevich, N. Tustison, J. Gee, Gaussian interpolation.
  * \sa{https://www.insight-journal.org/browse/publication/705}
@@ -152,6 +160,13 @@ public:
     return this->EvaluateAtContinuousIndex(cindex, nullptr);
   }
 
+  /** Evaluate at a batch of indices, reusing the error function array
+   * along a dimension while the coordinate along it does not change. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   SizeType
   GetRadius() const override;
 
@@ -178,6 +193,15 @@ protected:
                             vnl_vector<RealType> & gerfArray,
                             bool                   evaluateGradient = false) const;
 
+  /** Evaluate the function over the region, given the error function
+   * arrays of each dimension, and its gradient when grad is not null, in
+   * which case gerfArray holds the arrays of the derivative. */
+  virtual OutputType
+  EvaluateWithErrorFunctionArrays(const RegionType &           region,
+                                  const vnl_vector<RealType> * erfArray,
+                                  const vnl_vector<RealType> * gerfArray,
+                                  OutputType *                 grad) const;
+
   /** Set/Get the bounding box starting point. */
   itkSetMacro(BoundingBoxStart, ArrayType);
   itkGetConstMacro(BoundingBoxStart, ArrayType);
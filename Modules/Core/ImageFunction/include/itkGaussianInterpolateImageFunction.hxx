@@ -31,6 +31,7 @@
 
 
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkMath.h"
 
 namespace itk
 {
@@ -107,58 +108,140 @@ GaussianInterpolateImageFunction<TImageType, TCoordRep>::EvaluateAtContinuousInd
     this->ComputeErrorFunctionArray(region, d, cindex[d], erfArray[d], gerfArray[d], grad != nullptr);
   }
 
+  return this->EvaluateWithErrorFunctionArrays(region, erfArray, gerfArray, grad);
+}
+
+template <typename TImageType, typename TCoordRep>
+void
+GaussianInterpolateImageFunction<TImageType, TCoordRep>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  SizeValueType               numberOfIndices) const
+{
+  vnl_vector<RealType> erfArray[ImageDimension];
+  vnl_vector<RealType> gerfArray[ImageDimension];
+
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    const ContinuousIndexType & cindex = indices[i];
+    const RegionType            region = this->ComputeInterpolationRegion(cindex);
+
+    // The extent of the region and the ERF difference array along a
+    // dimension only depend on the coordinate along that dimension
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (i > 0 && Math::ExactlyEquals(cindex[d], indices[i - 1][d]))
+      {
+        continue;
+      }
+      this->ComputeErrorFunctionArray(region, d, cindex[d], erfArray[d], gerfArray[d], false);
+    }
+    values[i] = this->EvaluateWithErrorFunctionArrays(region, erfArray, gerfArray, nullptr);
+  }
+}
+
+template <typename TImageType, typename TCoordRep>
+auto
+GaussianInterpolateImageFunction<TImageType, TCoordRep>::EvaluateWithErrorFunctionArrays(
+  const RegionType &           region,
+  const vnl_vector<RealType> * erfArray,
+  const vnl_vector<RealType> * gerfArray,
+  OutputType *                 grad) const -> OutputType
+{
+  // The weights are separable, so their sums are the products of the sums
+  // of the ERF difference arrays
+  RealType  sum_m = 1.0;
+  ArrayType erfSum;
+  ArrayType gerfSum;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    erfSum[d] = erfArray[d].sum();
+    sum_m *= erfSum[d];
+    if (grad)
+    {
+      gerfSum[d] = gerfArray[d].sum();
+    }
+  }
+
   RealType  sum_me = 0.0;
-  RealType  sum_m = 0.0;
   ArrayType dsum_me;
   ArrayType dsum_m;
-  ArrayType dw;
 
-  dsum_m.Fill(0.0);
   dsum_me.Fill(0.0);
-  dw.Fill(0.0);
-
-  for (ImageRegionConstIteratorWithIndex<InputImageType> It(this->GetInputImage(), region); !It.IsAtEnd(); ++It)
+  if (grad)
   {
-    unsigned int j = It.GetIndex()[0] - region.GetIndex()[0];
-    RealType     w = erfArray[0][j];
-    if (grad)
+    for (unsigned int q = 0; q < ImageDimension; ++q)
     {
-      dw[0] = gerfArray[0][j];
-      for (unsigned int d = 1; d < ImageDimension; ++d)
+      dsum_m[q] = gerfSum[q];
+      for (unsigned int d = 0; d < ImageDimension; ++d)
       {
-        dw[d] = erfArray[0][j];
+        if (d != q)
+        {
+          dsum_m[q] *= erfSum[d];
+        }
       }
     }
-    for (unsigned int d = 1; d < ImageDimension; ++d)
+  }
+
+  // Sum the pixels of each line of the region along the first dimension,
+  // weighted by the ERF differences of that dimension, then weight the sum
+  // of the line by the ERF differences of the other dimensions
+  const SizeValueType lineLength = region.GetSize(0);
+  SizeValueType       numberOfLines = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
+  {
+    numberOfLines *= region.GetSize(d);
+  }
+
+  if (lineLength > 0 && numberOfLines > 0)
+  {
+    const InputImageType * const  image = this->GetInputImage();
+    const auto * const            firstPixel = image->GetBufferPointer() + image->ComputeOffset(region.GetIndex());
+    const OffsetValueType * const offsetTable = image->GetOffsetTable();
+    auto                          accessor = image->GetNeighborhoodAccessor();
+    accessor.SetBegin(image->GetBufferPointer());
+
+    SizeValueType position[ImageDimension]{};
+    for (SizeValueType line = 0; line < numberOfLines; ++line)
     {
-      j = It.GetIndex()[d] - region.GetIndex()[d];
-      w *= erfArray[d][j];
+      const auto *  linePixel = firstPixel;
+      RealType      lineWeight = 1.0;
+      SizeValueType remainder = line;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        position[d] = remainder % region.GetSize(d);
+        remainder /= region.GetSize(d);
+        linePixel += static_cast<OffsetValueType>(position[d]) * offsetTable[d];
+        lineWeight *= erfArray[d][position[d]];
+      }
+
+      RealType lineSum = 0.0;
+      RealType lineGradientSum = 0.0;
+      for (SizeValueType j = 0; j < lineLength; ++j)
+      {
+        const RealType V = accessor.Get(linePixel + j);
+        lineSum += V * erfArray[0][j];
+        if (grad)
+        {
+          lineGradientSum += V * gerfArray[0][j];
+        }
+      }
+      sum_me += lineWeight * lineSum;
+
       if (grad)
       {
-        for (unsigned int q = 0; q < ImageDimension; ++q)
+        dsum_me[0] += lineWeight * lineGradientSum;
+        for (unsigned int q = 1; q < ImageDimension; ++q)
         {
-          if (d == q)
+          RealType dw = lineSum;
+          for (unsigned int d = 1; d < ImageDimension; ++d)
           {
-            dw[q] *= gerfArray[d][j];
-          }
-          else
-          {
-            dw[q] *= erfArray[d][j];
+            dw *= (d == q) ? gerfArray[d][position[d]] : erfArray[d][position[d]];
           }
+          dsum_me[q] += dw;
         }
       }
     }
-    RealType V = It.Get();
-    sum_me += V * w;
-    sum_m += w;
-    if (grad)
-    {
-      for (unsigned int q = 0; q < ImageDimension; ++q)
-      {
-        dsum_me[q] += V * dw[q];
-        dsum_m[q] += dw[q];
-      }
-    }
   }
   RealType rc = sum_me / sum_m;
 
@@ -186,9 +269,10 @@ GaussianInterpolateImageFunction<TImageType, TCoordRep>::ComputeErrorFunctionArr
   erfArray.set_size(region.GetSize()[dimension]);
   gerfArray.set_size(region.GetSize()[dimension]);
 
-  // Start at the first voxel
-  RealType t = (this->m_BoundingBoxStart[dimension] - cindex + static_cast<RealType>(region.GetIndex()[dimension])) *
-               this->m_ScalingFactor[dimension];
+  // Start at the lower edge of the first voxel of the region, whose index
+  // already accounts for the start of the image
+  RealType t =
+    (static_cast<RealType>(region.GetIndex()[dimension]) - 0.5 - cindex) * this->m_ScalingFactor[dimension];
   RealType e_last = vnl_erf(t);
   RealType g_last = 0.0;
   if (evaluateGradient)
@@ -113,6 +113,26 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override = 0;
 
+  /** Interpolate the image at a batch of continuous index positions
+   *
+   * Sets values[i] to the interpolated image intensity at indices[i], for
+   * each of the numberOfIndices positions. No bounds checking is done: all
+   * the positions are assumed to lie within the image buffer.
+   *
+   * The default implementation calls EvaluateAtContinuousIndex() for each
+   * position. Subclasses may override it to avoid the virtual call per
+   * position, and to read the pixel buffer directly. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+    }
+  }
+
   /** Interpolate the image at an index position.
    *
    * Simply returns the image value at the
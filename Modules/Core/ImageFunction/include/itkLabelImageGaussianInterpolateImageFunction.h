@@ -51,8 +51,17 @@ namespace itk
  * \li \c Alpha - a scalar specifying the cutoff distance over which the function
  *      is calculated.
  *
+ * The weights of the labels are only accumulated for the labels found in the
+ * region within the cutoff distance, which usually holds a few labels even when
+ * the image has hundreds of them, so the cost of an interpolation does not grow
+ * with the number of labels of the image. The pixels are read directly from the
+ * buffer, and when the function is called through EvaluateAtContinuousIndices(),
+ * as ResampleImageFilter does, the error function arrays are shared by the
+ * positions with the same coordinate along a dimension.
+ *
  * \note The input image can be of any type, but the number of unique intensity values
- * in the image will determine the amount of memory needed to complete each interpolation.
+ * in the region within the cutoff distance will determine the amount of memory
+ * needed to complete each interpolation.
  *
  *
  * \author Paul Yushkevich
@@ -108,25 +117,20 @@ public:
   /** Array type alias support */
   using typename Superclass::ArrayType;
 
-  /**
-   * Evaluate at the given index
-   */
-  OutputType
-  EvaluateAtContinuousIndex(const ContinuousIndexType & cindex) const override
-  {
-    return this->EvaluateAtContinuousIndex(cindex, nullptr);
-  }
-
 protected:
   LabelImageGaussianInterpolateImageFunction() = default;
   ~LabelImageGaussianInterpolateImageFunction() override = default;
 
-private:
+  using typename Superclass::RegionType;
+
   /**
-   * Evaluate function value at the given index
+   * Evaluate the label of largest weight over the region
    */
   OutputType
-  EvaluateAtContinuousIndex(const ContinuousIndexType &, OutputType *) const override;
+  EvaluateWithErrorFunctionArrays(const RegionType &           region,
+                                  const vnl_vector<RealType> * erfArray,
+                                  const vnl_vector<RealType> * gerfArray,
+                                  OutputType *                 grad) const override;
 };
 
 } // end namespace itk
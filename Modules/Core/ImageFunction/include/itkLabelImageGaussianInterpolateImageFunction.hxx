@@ -29,67 +29,121 @@
 #ifndef itkLabelImageGaussianInterpolateImageFunction_hxx
 #define itkLabelImageGaussianInterpolateImageFunction_hxx
 
+#include <array>
+#include <utility> // For pair.
+#include <vector>
 
 namespace itk
 {
 
 template <typename TInputImage, typename TCoordRep, typename TPixelCompare>
 auto
-LabelImageGaussianInterpolateImageFunction<TInputImage, TCoordRep, TPixelCompare>::EvaluateAtContinuousIndex(
-  const ContinuousIndexType & cindex,
-  OutputType *                itkNotUsed(grad)) const -> OutputType
+LabelImageGaussianInterpolateImageFunction<TInputImage, TCoordRep, TPixelCompare>::EvaluateWithErrorFunctionArrays(
+  const RegionType &           region,
+  const vnl_vector<RealType> * erfArray,
+  const vnl_vector<RealType> * itkNotUsed(gerfArray),
+  OutputType *                 itkNotUsed(grad)) const -> OutputType
 {
-  vnl_vector<RealType> erfArray[ImageDimension];
-  vnl_vector<RealType> gerfArray[ImageDimension];
+  RealType   wmax = 0.0;
+  OutputType Vmax{};
 
-  typename Superclass::RegionType region = this->ComputeInterpolationRegion(cindex);
+  // The labels encountered inside the search region, with their weights.
+  // A region usually holds a handful of labels whatever the number of
+  // labels in the image, so they are kept in a small array searched
+  // linearly, starting from the label of the previous voxel, and only
+  // moved to the heap when the array is full.
+  using LabelWeightType = std::pair<OutputType, RealType>;
+  constexpr unsigned int                     LocalCapacity = 16;
+  std::array<LabelWeightType, LocalCapacity> localLabels;
+  std::vector<LabelWeightType>               heapLabels;
+  LabelWeightType *                          labels = localLabels.data();
+  SizeValueType                              numberOfLabels = 0;
+  SizeValueType                              capacity = LocalCapacity;
+  SizeValueType                              lastLabel = 0;
+  const TPixelCompare                        compare{};
 
-  // Compute the ERF difference arrays
-  for (unsigned int d = 0; d < ImageDimension; ++d)
+  const SizeValueType lineLength = region.GetSize(0);
+  SizeValueType       numberOfLines = 1;
+  for (unsigned int d = 1; d < ImageDimension; ++d)
   {
-    this->ComputeErrorFunctionArray(region, d, cindex[d], erfArray[d], gerfArray[d], false);
+    numberOfLines *= region.GetSize(d);
+  }
+  if (lineLength == 0 || numberOfLines == 0)
+  {
+    return Vmax;
   }
 
-  RealType   wmax = 0.0;
-  OutputType Vmax{};
-
-  // Create a map object to store weights for each label encountered
-  // inside the search region. This is not as efficient as having a
-  // linear list of labels, but probably not a huge deal compared to
-  // having to evaluate the erf function
-  using WeightMapType = std::map<OutputType, RealType, TPixelCompare>;
-  WeightMapType weightMap;
+  const InputImageType * const  image = this->GetInputImage();
+  const auto * const            firstPixel = image->GetBufferPointer() + image->ComputeOffset(region.GetIndex());
+  const OffsetValueType * const offsetTable = image->GetOffsetTable();
+  auto                          accessor = image->GetNeighborhoodAccessor();
+  accessor.SetBegin(image->GetBufferPointer());
 
-  for (ImageRegionConstIteratorWithIndex<InputImageType> It(this->GetInputImage(), region); !It.IsAtEnd(); ++It)
+  SizeValueType position[ImageDimension]{};
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
   {
-    unsigned int j = It.GetIndex()[0] - region.GetIndex()[0];
-    RealType     w = erfArray[0][j];
+    const auto *  linePixel = firstPixel;
+    SizeValueType remainder = line;
     for (unsigned int d = 1; d < ImageDimension; ++d)
     {
-      j = It.GetIndex()[d] - region.GetIndex()[d];
-      w *= erfArray[d][j];
+      position[d] = remainder % region.GetSize(d);
+      remainder /= region.GetSize(d);
+      linePixel += static_cast<OffsetValueType>(position[d]) * offsetTable[d];
     }
 
-    const OutputType V = It.Get();
-    auto             it = weightMap.find(V);
-    RealType         wtest = 0.0;
-
-    if (it != weightMap.end())
+    for (SizeValueType j = 0; j < lineLength; ++j)
     {
-      it->second += w;
-      wtest = it->second;
-    }
-    else
-    {
-      weightMap.insert(std::make_pair(V, w));
-      wtest = w;
-    }
+      RealType w = erfArray[0][j];
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        w *= erfArray[d][position[d]];
+      }
+      if (w == 0.0)
+      {
+        continue;
+      }
 
-    // Keep track of the max value
-    if (wtest > wmax)
-    {
-      wmax = wtest;
-      Vmax = V;
+      const OutputType V = accessor.Get(linePixel + j);
+
+      // Find the label, the labels being equal when neither compares
+      // less than the other, as for the keys of a map
+      SizeValueType k = lastLabel;
+      if (k >= numberOfLabels || compare(V, labels[k].first) || compare(labels[k].first, V))
+      {
+        for (k = 0; k < numberOfLabels; ++k)
+        {
+          if (!compare(V, labels[k].first) && !compare(labels[k].first, V))
+          {
+            break;
+          }
+        }
+      }
+
+      if (k < numberOfLabels)
+      {
+        labels[k].second += w;
+      }
+      else
+      {
+        if (numberOfLabels == capacity)
+        {
+          capacity *= 2;
+          std::vector<LabelWeightType> grownLabels(labels, labels + numberOfLabels);
+          grownLabels.resize(capacity);
+          heapLabels.swap(grownLabels);
+          labels = heapLabels.data();
+        }
+        labels[k] = std::make_pair(V, w);
+        ++numberOfLabels;
+      }
+      lastLabel = k;
+
+      // Keep track of the max value
+      if (labels[k].second > wmax)
+      {
+        wmax = labels[k].second;
+        Vmax = V;
+      }
     }
   }
   return Vmax;
@@ -19,8 +19,12 @@
 #define itkLinearInterpolateImageFunction_h
 
 #include "itkInterpolateImageFunction.h"
+#include "itkImage.h"
 #include "itkVariableLengthVector.h"
 
+#include <algorithm>
+#include <type_traits>
+
 namespace itk
 {
 /**
@@ -103,6 +107,31 @@ public:
     return this->EvaluateOptimized(Dispatch<ImageDimension>(), index);
   }
 
+  /** Evaluate the function at a batch of ContinuousIndex positions
+   *
+   * Gives the same values as EvaluateAtContinuousIndex(). For scalar
+   * images of up to three dimensions, the neighbors are read directly from
+   * the pixel buffer, without branches on the position, so that the loop
+   * over the positions can be vectorized by the compiler. All the
+   * positions are assumed to lie within the image buffer. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
+  {
+    if constexpr (IsScalarImage && ImageDimension <= 3)
+    {
+      this->EvaluateInBuffer(indices, values, numberOfIndices);
+    }
+    else
+    {
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        values[i] = this->EvaluateOptimized(Dispatch<ImageDimension>(), indices[i]);
+      }
+    }
+  }
+
   SizeType
   GetRadius() const override
   {
@@ -116,6 +145,68 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
 private:
+  /** Whether the pixels can be read directly from the buffer of an Image. */
+  static constexpr bool IsScalarImage =
+    std::is_same_v<TInputImage, Image<typename TInputImage::PixelType, ImageDimension>> &&
+    std::is_arithmetic_v<typename TInputImage::PixelType>;
+
+  /** Batched evaluation for scalar images. As in EvaluateOptimized(), no
+   * interpolation is done along a dimension when the distance is not
+   * positive, or when the pixel is at the end of the buffer: the neighbor is
+   * then the pixel itself, and the interpolation step is replaced by a
+   * select, so that infinite values are preserved. */
+  void
+  EvaluateInBuffer(const ContinuousIndexType * indices, OutputType * values, SizeValueType numberOfIndices) const
+  {
+    constexpr unsigned int NumberOfCorners = 1u << ImageDimension;
+
+    const TInputImage * const                     inputImagePtr = this->GetInputImage();
+    const typename TInputImage::PixelType * const buffer = inputImagePtr->GetBufferPointer();
+    const OffsetValueType * const                 offsetTable = inputImagePtr->GetOffsetTable();
+    const IndexType                               bufferStart = inputImagePtr->GetBufferedRegion().GetIndex();
+
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      const ContinuousIndexType & index = indices[i];
+
+      InternalComputationType distance[ImageDimension];
+      OffsetValueType         step[ImageDimension];
+      bool                    interpolate[ImageDimension];
+      OffsetValueType         offset = 0;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        IndexValueType basei = Math::Floor<IndexValueType>(index[d]);
+        basei = std::max(basei, this->m_StartIndex[d]);
+        distance[d] = index[d] - static_cast<InternalComputationType>(basei);
+        interpolate[d] = distance[d] > 0. && basei < this->m_EndIndex[d];
+        step[d] = interpolate[d] ? offsetTable[d] : 0;
+        offset += (basei - bufferStart[d]) * offsetTable[d];
+      }
+
+      // Gather the corners, bit d of the corner number selecting the
+      // neighbor along dimension d, then reduce along x, y and z in turn.
+      RealType corners[NumberOfCorners];
+      for (unsigned int c = 0; c < NumberOfCorners; ++c)
+      {
+        OffsetValueType cornerOffset = offset;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          cornerOffset += ((c >> d) & 1u) ? step[d] : 0;
+        }
+        corners[c] = static_cast<RealType>(buffer[cornerOffset]);
+      }
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        for (unsigned int c = 0; c < (NumberOfCorners >> (d + 1)); ++c)
+        {
+          corners[c] =
+            interpolate[d] ? corners[2 * c] + (corners[2 * c + 1] - corners[2 * c]) * distance[d] : corners[2 * c];
+        }
+      }
+      values[i] = static_cast<OutputType>(corners[0]);
+    }
+  }
+
   struct DispatchBase
   {};
   template <unsigned int>
@@ -19,6 +19,9 @@
 #define itkNearestNeighborInterpolateImageFunction_h
 
 #include "itkInterpolateImageFunction.h"
+#include "itkImage.h"
+
+#include <type_traits>
 
 namespace itk
 {
@@ -89,6 +92,46 @@ public:
     return static_cast<OutputType>(this->GetInputImage()->GetPixel(nindex));
   }
 
+  /** Evaluate the function at a batch of ContinuousIndex positions
+   *
+   * Gives the same values as EvaluateAtContinuousIndex(). For scalar
+   * images, the pixels are read directly from the buffer. All the positions
+   * are assumed to lie within the image buffer. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override
+  {
+    using PixelType = typename TInputImage::PixelType;
+
+    if constexpr (std::is_same_v<TInputImage, Image<PixelType, ImageDimension>> && std::is_arithmetic_v<PixelType>)
+    {
+      const TInputImage * const     inputImagePtr = this->GetInputImage();
+      const PixelType * const       buffer = inputImagePtr->GetBufferPointer();
+      const OffsetValueType * const offsetTable = inputImagePtr->GetOffsetTable();
+      const IndexType               bufferStart = inputImagePtr->GetBufferedRegion().GetIndex();
+
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        OffsetValueType offset = 0;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          offset += (Math::Round<IndexValueType>(indices[i][d]) - bufferStart[d]) * offsetTable[d];
+        }
+        values[i] = static_cast<OutputType>(buffer[offset]);
+      }
+    }
+    else
+    {
+      IndexType nindex;
+      for (SizeValueType i = 0; i < numberOfIndices; ++i)
+      {
+        this->ConvertContinuousIndexToNearestIndex(indices[i], nindex);
+        values[i] = static_cast<OutputType>(this->GetInputImage()->GetPixel(nindex));
+      }
+    }
+  }
+
   SizeType
   GetRadius() const override
   {
@@ -20,6 +20,7 @@
 
 
 #include "itkMath.h"
+#include <algorithm> // For max and min.
 
 namespace itk
 {
@@ -38,13 +39,29 @@ VectorLinearInterpolateImageFunction<TInputImage, TCoordRep>::EvaluateAtContinuo
   // Compute base index = closet index below point
   // Compute distance from point to base index
   //
-  IndexType                 baseIndex;
-  InternalComputationType   distance[ImageDimension];
-  const TInputImage * const inputImgPtr = this->GetInputImage();
+  // The offsets in the buffer of the lower and upper neighbors along each
+  // dimension are computed once, so that the neighbors are read directly
+  // from the buffer.
+  //
+  const TInputImage * const     inputImgPtr = this->GetInputImage();
+  const auto * const            buffer = inputImgPtr->GetBufferPointer();
+  const auto                    accessor = inputImgPtr->GetPixelAccessor();
+  const OffsetValueType * const offsetTable = inputImgPtr->GetOffsetTable();
+  const IndexType &             bufferStart = inputImgPtr->GetBufferedRegion().GetIndex();
+  InternalComputationType       distance[ImageDimension];
+  OffsetValueType               lowerOffset[ImageDimension];
+  OffsetValueType               upperOffset[ImageDimension];
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
-    baseIndex[dim] = Math::Floor<IndexValueType>(index[dim]);
-    distance[dim] = index[dim] - static_cast<InternalComputationType>(baseIndex[dim]);
+    const auto baseIndex = Math::Floor<IndexValueType>(index[dim]);
+    distance[dim] = index[dim] - static_cast<InternalComputationType>(baseIndex);
+
+    // Take care of the cases where the pixel is just in the outer lower or
+    // upper boundary of the image grid.
+    const IndexValueType lowerIndex = std::max(baseIndex, this->m_StartIndex[dim]);
+    const IndexValueType upperIndex = std::min(baseIndex + 1, this->m_EndIndex[dim]);
+    lowerOffset[dim] = (lowerIndex - bufferStart[dim]) * offsetTable[dim];
+    upperOffset[dim] = (upperIndex - bufferStart[dim]) * offsetTable[dim];
   }
 
   /**
@@ -62,31 +79,19 @@ VectorLinearInterpolateImageFunction<TInputImage, TCoordRep>::EvaluateAtContinuo
   {
     InternalComputationType overlap = 1.0;   // fraction overlap
     unsigned int            upper = counter; // each bit indicates upper/lower neighbour
+    OffsetValueType         neighOffset = 0;
 
-    IndexType neighIndex;
-    // get neighbor index and overlap fraction
+    // get neighbor offset and overlap fraction
     for (unsigned int dim = 0; dim < ImageDimension; ++dim)
     {
       if (upper & 1)
       {
-        neighIndex[dim] = baseIndex[dim] + 1;
-        // Take care of the case where the pixel is just
-        // in the outer upper boundary of the image grid.
-        if (neighIndex[dim] > this->m_EndIndex[dim])
-        {
-          neighIndex[dim] = this->m_EndIndex[dim];
-        }
+        neighOffset += upperOffset[dim];
         overlap *= distance[dim];
       }
       else
       {
-        neighIndex[dim] = baseIndex[dim];
-        // Take care of the case where the pixel is just
-        // in the outer lower boundary of the image grid.
-        if (neighIndex[dim] < this->m_StartIndex[dim])
-        {
-          neighIndex[dim] = this->m_StartIndex[dim];
-        }
+        neighOffset += lowerOffset[dim];
         overlap *= 1.0 - distance[dim];
       }
       upper >>= 1;
@@ -95,7 +100,7 @@ VectorLinearInterpolateImageFunction<TInputImage, TCoordRep>::EvaluateAtContinuo
     // get neighbor value only if overlap is not zero
     if (overlap)
     {
-      const PixelType & input = inputImgPtr->GetPixel(neighIndex);
+      const PixelType input = accessor.Get(buffer[neighOffset]);
       for (unsigned int k = 0; k < Dimension; ++k)
       {
         output[k] += overlap * static_cast<InternalComputationType>(input[k]);
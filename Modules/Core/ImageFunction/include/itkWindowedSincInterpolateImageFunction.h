@@ -231,23 +231,29 @@ private:
  * The fifth (TCoordRep) is again standard for interpolating functions,
  * and should be float or double.
  *
- * \par CAVEATS
+ * \par IMPLEMENTATION
  *
- * There are a few improvements that an enthusiastic ITK developer
- * could make to this filter. One issue is with the way that the kernel
- * is applied. The computational expense comes from two sources:
- * computing the kernel weights K(t) and multiplying the pixels in the
- * window by the kernel weights. The first is done more or less
- * efficiently in \f$ 2 m d \f$ operations (where d is the
- * dimensionality of the image). The second can be done
- * better. Presently, each pixel \f$ I(i,j,k) \f$ is multiplied by the
- * weights \f$ K(x-i), K(y-j), K(z-k) \f$ and added to the running
- * total. This results in \f$ d (2m)^d \f$ multiplication
- * operations. However, by keeping intermediate sums, it would be
- * possible to do the operation in \f$ O ( (2m)^d ) \f$
- * operations. This would require some creative coding. In addition, in
- * the case when one of the coordinates is integer, the computation
- * could be reduced by an order of magnitude.
+ * The computational expense comes from two sources: computing the
+ * kernel weights K(t) and multiplying the pixels in the window by the
+ * kernel weights. The weights are computed in \f$ 2 m d \f$ window
+ * function evaluations (where d is the dimensionality of the image),
+ * the sine of the sinc function only being computed once per dimension
+ * since \f$ \sin(\pi (t + k)) = (-1)^k \sin(\pi t) \f$. When the
+ * window lies inside the buffered region, the pixels are read directly
+ * from the buffer and the kernel is applied separably: each line of the
+ * window along the first dimension is summed with the weights of that
+ * dimension, then multiplied by the product of the weights along the
+ * other dimensions, which takes \f$ O ( (2m)^d ) \f$ operations instead
+ * of \f$ d (2m)^d \f$. The lines with a zero weight, as when one of the
+ * coordinates is integer, are skipped. Near the image boundary, the
+ * pixels are read through the boundary condition.
+ *
+ * \par
+ * EvaluateAtContinuousIndices() only computes the weights along a
+ * dimension again when the coordinate along it differs from the one of
+ * the previous position, so the weights along all but the first
+ * dimension are shared by the positions of a scan line of an
+ * axis-aligned resampling.
  *
  * \sa LinearInterpolateImageFunction ResampleImageFilter
  * \sa Function::HammingWindowFunction
@@ -318,6 +324,16 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override;
 
+  /** Evaluate the function at a batch of ContinuousIndex positions.
+   *
+   * The weights along a dimension are only computed again when the
+   * coordinate along that dimension differs from the one of the previous
+   * position. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const override;
+
   SizeType
   GetRadius() const override
   {
@@ -352,14 +368,18 @@ private:
   /** Index into the weights array for each offset */
   unsigned int m_WeightOffsetTable[m_OffsetTableSize][ImageDimension]{};
 
-  /** The sinc function */
-  inline double
-  Sinc(double x) const
-  {
-    const double px = itk::Math::pi * x;
+  /** The kernel weights along each dimension */
+  using WeightsType = FixedArray<FixedArray<double, m_WindowSize>, ImageDimension>;
 
-    return (x == 0.0) ? 1.0 : std::sin(px) / px;
-  }
+  /** Compute the kernel weights along a dimension, for the distance of the
+   * position to the pixel below it. */
+  void
+  ComputeWeights(double distance, FixedArray<double, m_WindowSize> & weights) const;
+
+  /** Sum the pixels of the window above baseIndex, weighted by the product
+   * of their weights along each dimension. */
+  OutputType
+  EvaluateWithWeights(const IndexType & baseIndex, const WeightsType & weights) const;
 };
 } // namespace itk
 
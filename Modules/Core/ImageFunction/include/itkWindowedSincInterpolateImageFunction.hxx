@@ -133,59 +133,158 @@ auto
 WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordRep>::
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const -> OutputType
 {
-  IndexType baseIndex;
-  double    distance[ImageDimension];
-
   // Compute the integer index based on the continuous one by
   // 'flooring' the index
+  IndexType   baseIndex;
+  WeightsType weights;
   for (unsigned int dim = 0; dim < ImageDimension; ++dim)
   {
     baseIndex[dim] = Math::Floor<IndexValueType>(index[dim]);
-    distance[dim] = index[dim] - static_cast<double>(baseIndex[dim]);
+    this->ComputeWeights(index[dim] - static_cast<double>(baseIndex[dim]), weights[dim]);
   }
 
-  // Position the neighborhood at the index of interest
-  Size<ImageDimension> radius;
-  radius.Fill(VRadius);
-  IteratorType nit(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
-  nit.SetLocation(baseIndex);
+  return this->EvaluateWithWeights(baseIndex, weights);
+}
 
-  // Compute the sinc function for each dimension
-  double xWeight[ImageDimension][2 * VRadius];
-  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordRep>
+void
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordRep>::
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              SizeValueType               numberOfIndices) const
+{
+  IndexType   baseIndex;
+  WeightsType weights;
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
   {
-    // x is the offset, hence the parameter of the kernel
-    double x = distance[dim] + VRadius;
-
-    // If distance is zero, i.e. the index falls precisely on the
-    // pixel boundary, the weights form a delta function.
-    if (distance[dim] == 0.0)
+    const ContinuousIndexType & index = indices[i];
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
     {
-      for (unsigned int i = 0; i < m_WindowSize; ++i)
+      if (i > 0 && Math::ExactlyEquals(index[dim], indices[i - 1][dim]))
       {
-        xWeight[dim][i] = static_cast<int>(i) == VRadius - 1 ? 1 : 0;
+        continue;
       }
+      baseIndex[dim] = Math::Floor<IndexValueType>(index[dim]);
+      this->ComputeWeights(index[dim] - static_cast<double>(baseIndex[dim]), weights[dim]);
     }
-    else
+    values[i] = this->EvaluateWithWeights(baseIndex, weights);
+  }
+}
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordRep>
+void
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordRep>::
+  ComputeWeights(double distance, FixedArray<double, m_WindowSize> & weights) const
+{
+  // If distance is zero, i.e. the index falls precisely on the
+  // pixel boundary, the weights form a delta function.
+  if (distance == 0.0)
+  {
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
     {
-      // i is the relative offset in dimension dim.
-      for (unsigned int i = 0; i < m_WindowSize; ++i)
+      weights[i] = i == VRadius - 1 ? 1.0 : 0.0;
+    }
+    return;
+  }
+
+  // The offsets x of the window are (dist + rad - 1, ..., dist - rad),
+  // i.e. all x such that itk::Math::abs(x) <= rad. They all differ from
+  // dist by an integer, so sin(pi x) = +/- sin(pi dist), the sign
+  // alternating from one offset to the next.
+  const double sinPiDistance = std::sin(itk::Math::pi * distance);
+  double       sign = (VRadius - 1) % 2 == 0 ? 1.0 : -1.0;
+  double       x = distance + VRadius;
+  for (unsigned int i = 0; i < m_WindowSize; ++i)
+  {
+    x -= 1.0;
+
+    // Compute the weight for this m, x being non-zero
+    weights[i] = m_WindowFunction(x) * sign * sinPiDistance / (itk::Math::pi * x);
+    sign = -sign;
+  }
+}
+
+template <typename TInputImage,
+          unsigned int VRadius,
+          typename TWindowFunction,
+          typename TBoundaryCondition,
+          typename TCoordRep>
+auto
+WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBoundaryCondition, TCoordRep>::
+  EvaluateWithWeights(const IndexType & baseIndex, const WeightsType & weights) const -> OutputType
+{
+  using PixelType = typename NumericTraits<typename TInputImage::PixelType>::RealType;
+
+  const ImageType * const image = this->GetInputImage();
+
+  // The window spans the pixels from baseIndex - (rad - 1) to
+  // baseIndex + rad along each dimension
+  IndexType windowStart;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    windowStart[dim] = baseIndex[dim] - static_cast<IndexValueType>(VRadius - 1);
+  }
+  const ImageRegion<ImageDimension> windowRegion(windowStart, SizeType::Filled(m_WindowSize));
+
+  PixelType xPixelValue{};
+  if (image->GetBufferedRegion().IsInside(windowRegion))
+  {
+    // Read the pixels directly from the buffer, summing each line of the
+    // window along the first dimension before multiplying the sum by the
+    // weights along the other dimensions
+    const auto * const            firstPixel = image->GetBufferPointer() + image->ComputeOffset(windowStart);
+    const OffsetValueType * const offsetTable = image->GetOffsetTable();
+    auto                          accessor = image->GetNeighborhoodAccessor();
+    accessor.SetBegin(image->GetBufferPointer());
+
+    constexpr unsigned int numberOfLines = m_OffsetTableSize / m_WindowSize;
+    for (unsigned int line = 0; line < numberOfLines; ++line)
+    {
+      const auto * linePixel = firstPixel;
+      double       lineWeight = 1.0;
+      unsigned int remainder = line;
+      for (unsigned int dim = 1; dim < ImageDimension; ++dim)
+      {
+        const unsigned int position = remainder % m_WindowSize;
+        remainder /= m_WindowSize;
+        linePixel += static_cast<OffsetValueType>(position) * offsetTable[dim];
+        lineWeight *= weights[dim][position];
+      }
+      if (lineWeight == 0.0)
       {
-        // Increment the offset, taking it through the range
-        // (dist + rad - 1, ..., dist - rad), i.e. all x
-        // such that itk::Math::abs(x) <= rad
-        x -= 1.0;
+        continue;
+      }
 
-        // Compute the weight for this m
-        xWeight[dim][i] = m_WindowFunction(x) * Sinc(x);
+      PixelType lineValue{};
+      for (unsigned int i = 0; i < m_WindowSize; ++i)
+      {
+        PixelType xVal = accessor.Get(linePixel + i);
+        xVal *= weights[0][i];
+        lineValue += xVal;
       }
+      lineValue *= lineWeight;
+      xPixelValue += lineValue;
     }
+    return static_cast<OutputType>(xPixelValue);
   }
 
+  // Position the neighborhood at the index of interest, so that the
+  // boundary condition applies to the pixels outside of the image
+  Size<ImageDimension> radius;
+  radius.Fill(VRadius);
+  IteratorType nit(radius, image, image->GetBufferedRegion());
+  nit.SetLocation(baseIndex);
+
   // Iterate over the neighborhood, taking the correct set
   // of weights in each dimension
-  using PixelType = typename NumericTraits<typename TInputImage::PixelType>::RealType;
-  PixelType xPixelValue{};
   for (unsigned int j = 0; j < m_OffsetTableSize; ++j)
   {
     // Get the offset for this neighbor
@@ -194,11 +293,10 @@ WindowedSincInterpolateImageFunction<TInputImage, VRadius, TWindowFunction, TBou
     // Get the intensity value at the pixel
     PixelType xVal = nit.GetPixel(off);
 
-    // Multiply the intensity by each of the weights. Gotta hope
-    // that the compiler will unwrap this loop and pipeline this!
+    // Multiply the intensity by each of the weights.
     for (unsigned int dim = 0; dim < ImageDimension; ++dim)
     {
-      xVal *= xWeight[dim][m_WeightOffsetTable[j][dim]];
+      xVal *= weights[dim][m_WeightOffsetTable[j][dim]];
     }
 
     // Increment the pixel value
@@ -0,0 +1,112 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkBSplineInterpolateImageFunction.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Checks that the values given by EvaluateAtContinuousIndex(), for each
+// spline order, match those given by the generic implementation of
+// EvaluateValueAndDerivativeAtContinuousIndex(), and that the batched
+// evaluation along a scan line gives the same values.
+template <typename TImage>
+void
+Expect_fixed_order_evaluation_matches_generic_evaluation(const typename TImage::SizeType & imageSize)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  using InterpolatorType = itk::BSplineInterpolateImageFunction<TImage>;
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  typename TImage::IndexType start;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    start[d] = static_cast<itk::IndexValueType>(d) - 1;
+  }
+  const auto image = TImage::New();
+  image->SetRegions({ start, imageSize });
+  image->Allocate();
+
+  std::mt19937                           randomEngine;
+  std::uniform_real_distribution<double> pixelDistribution(-100.0, 100.0);
+  for (auto & pixel : itk::ImageBufferRange<TImage>{ *image })
+  {
+    pixel = static_cast<typename TImage::PixelType>(pixelDistribution(randomEngine));
+  }
+
+  const auto interpolator = InterpolatorType::New();
+
+  for (unsigned int splineOrder = 0; splineOrder <= 5; ++splineOrder)
+  {
+    interpolator->SetSplineOrder(splineOrder);
+    interpolator->SetInputImage(image);
+
+    const ContinuousIndexType & startIndex = interpolator->GetStartContinuousIndex();
+    const ContinuousIndexType & endIndex = interpolator->GetEndContinuousIndex();
+
+    // Scan lines along the first dimension, at random positions across it
+    std::vector<ContinuousIndexType> positions;
+    for (unsigned int line = 0; line < 10; ++line)
+    {
+      ContinuousIndexType position;
+      for (unsigned int d = 1; d < Dimension; ++d)
+      {
+        position[d] = std::uniform_real_distribution<double>(startIndex[d], endIndex[d])(randomEngine);
+      }
+      for (double x = startIndex[0]; x < endIndex[0]; x += 0.3)
+      {
+        position[0] = x;
+        positions.push_back(position);
+      }
+    }
+
+    std::vector<double> values(positions.size());
+    interpolator->EvaluateAtContinuousIndices(positions.data(), values.data(), positions.size());
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+      double                                         expected;
+      typename InterpolatorType::CovariantVectorType derivative;
+      interpolator->EvaluateValueAndDerivativeAtContinuousIndex(positions[i], expected, derivative);
+
+      const double value = interpolator->EvaluateAtContinuousIndex(positions[i]);
+      EXPECT_NEAR(value, expected, 1e-10 * (1.0 + std::abs(expected)))
+        << "spline order " << splineOrder << " at " << positions[i];
+      EXPECT_EQ(values[i], value) << "spline order " << splineOrder << " at " << positions[i];
+    }
+  }
+}
+} // namespace
+
+
+TEST(BSplineInterpolateImageFunction, FixedOrderEvaluationMatchesGenericEvaluation)
+{
+  Expect_fixed_order_evaluation_matches_generic_evaluation<itk::Image<float, 1>>({ { 9 } });
+  Expect_fixed_order_evaluation_matches_generic_evaluation<itk::Image<float, 2>>({ { 8, 6 } });
+  Expect_fixed_order_evaluation_matches_generic_evaluation<itk::Image<short, 3>>({ { 7, 5, 4 } });
+
+  // A single pixel along one of the dimensions
+  Expect_fixed_order_evaluation_matches_generic_evaluation<itk::Image<float, 2>>({ { 8, 1 } });
+}
@@ -0,0 +1,403 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkGaussianInterpolateImageFunction.h"
+#include "itkLabelImageGaussianInterpolateImageFunction.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkWindowedSincInterpolateImageFunction.h"
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkVectorImage.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Creates an image with random pixel values, whose buffered region does not
+// start at the zero index.
+template <typename TImage>
+typename TImage::Pointer
+CreateRandomImage(const typename TImage::SizeType & imageSize, std::mt19937 & randomEngine)
+{
+  typename TImage::IndexType start;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    start[d] = static_cast<itk::IndexValueType>(d) * 3 - 2;
+  }
+  const auto image = TImage::New();
+  image->SetRegions({ start, imageSize });
+  image->Allocate();
+  std::uniform_int_distribution<int> distribution(-100, 100);
+  for (auto & pixel : itk::ImageBufferRange<TImage>{ *image })
+  {
+    pixel = static_cast<typename TImage::PixelType>(distribution(randomEngine));
+  }
+  return image;
+}
+
+
+// Random positions inside the buffer, together with the extreme positions
+// along each dimension, and positions on the pixel centers.
+template <typename TInterpolator>
+std::vector<typename TInterpolator::ContinuousIndexType>
+CreatePositions(const TInterpolator & interpolator, std::mt19937 & randomEngine)
+{
+  using ContinuousIndexType = typename TInterpolator::ContinuousIndexType;
+  using ValueType = typename ContinuousIndexType::ValueType;
+  constexpr unsigned int Dimension = TInterpolator::ImageDimension;
+
+  const ContinuousIndexType & start = interpolator.GetStartContinuousIndex();
+  const ContinuousIndexType & end = interpolator.GetEndContinuousIndex();
+
+  std::vector<ContinuousIndexType> positions;
+  for (unsigned int i = 0; i < 200; ++i)
+  {
+    ContinuousIndexType position;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const ValueType last = std::nextafter(end[d], start[d]);
+      position[d] = std::min(
+        static_cast<ValueType>(std::uniform_real_distribution<double>(start[d], end[d])(randomEngine)), last);
+      if (i % 4 == 1)
+      {
+        position[d] = start[d];
+      }
+      else if (i % 4 == 2)
+      {
+        position[d] = last;
+      }
+      else if (i % 8 == 3)
+      {
+        position[d] = std::round(position[d]);
+      }
+    }
+    positions.push_back(position);
+  }
+  return positions;
+}
+
+
+template <typename TInterpolator>
+void
+Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex(
+  const typename TInterpolator::InputImageType * image,
+  std::mt19937 &                                 randomEngine)
+{
+  const auto interpolator = TInterpolator::New();
+  interpolator->SetInputImage(image);
+
+  const auto positions = CreatePositions(*interpolator, randomEngine);
+  std::vector<typename TInterpolator::OutputType> values(positions.size());
+  interpolator->EvaluateAtContinuousIndices(positions.data(), values.data(), positions.size());
+
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    ASSERT_TRUE(interpolator->IsInsideBuffer(positions[i]));
+    EXPECT_EQ(values[i], interpolator->EvaluateAtContinuousIndex(positions[i])) << "at " << positions[i];
+  }
+}
+
+
+template <typename TImage>
+void
+Expect_batched_interpolation_is_exact(const typename TImage::SizeType & imageSize)
+{
+  std::mt19937 randomEngine;
+  const auto   image = CreateRandomImage<TImage>(imageSize, randomEngine);
+
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<TImage>>(image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<TImage, float>>(image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<
+    itk::NearestNeighborInterpolateImageFunction<TImage>>(image, randomEngine);
+}
+
+
+// Windowed sinc interpolation computed term by term, as the sum over the
+// window of the pixels times the product of the kernel weights, the pixels
+// outside of the image being those of the nearest border.
+template <typename TImage, unsigned int VRadius, typename TWindowFunction>
+double
+ComputeWindowedSincReference(const TImage & image, const itk::ContinuousIndex<double, TImage::ImageDimension> & x)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  const auto &           bufferedRegion = image.GetBufferedRegion();
+
+  typename TImage::IndexType windowStart;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    windowStart[d] = static_cast<itk::IndexValueType>(std::floor(x[d])) - static_cast<itk::IndexValueType>(VRadius - 1);
+  }
+
+  constexpr unsigned int windowSize = 2 * VRadius;
+  const TWindowFunction  window{};
+  double                 value = 0.0;
+  for (unsigned int n = 0; n < itk::Math::UnsignedPower(windowSize, Dimension); ++n)
+  {
+    typename TImage::IndexType pixelIndex;
+    double                     weight = 1.0;
+    for (unsigned int d = 0, remainder = n; d < Dimension; ++d, remainder /= windowSize)
+    {
+      pixelIndex[d] = windowStart[d] + remainder % windowSize;
+      const double t = x[d] - static_cast<double>(pixelIndex[d]);
+      weight *= t == 0.0 ? 1.0 : window(t) * std::sin(itk::Math::pi * t) / (itk::Math::pi * t);
+      const itk::IndexValueType last =
+        bufferedRegion.GetIndex(d) + static_cast<itk::IndexValueType>(bufferedRegion.GetSize(d)) - 1;
+      pixelIndex[d] = std::clamp(pixelIndex[d], bufferedRegion.GetIndex(d), last);
+    }
+    value += weight * image.GetPixel(pixelIndex);
+  }
+  return value;
+}
+
+
+// Gaussian interpolation computed term by term over the region within the
+// cut-off distance, for a unit spacing.
+template <typename TImage>
+double
+ComputeGaussianReference(const TImage &                                               image,
+                         const itk::ContinuousIndex<double, TImage::ImageDimension> & x,
+                         const double                                                 sigma,
+                         const double                                                 alpha)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  double sumOfWeightedPixels = 0.0;
+  double sumOfWeights = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(&image, image.GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    double weight = 1.0;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double pixelStart = static_cast<double>(it.GetIndex()[d]) - 0.5;
+      if (pixelStart + 1.0 <= std::floor(x[d] + 0.5 - sigma * alpha) ||
+          pixelStart >= std::ceil(x[d] + 0.5 + sigma * alpha) - 1.0)
+      {
+        weight = 0.0;
+        break;
+      }
+      weight *= vnl_erf((pixelStart + 1.0 - x[d]) / (itk::Math::sqrt2 * sigma)) -
+                vnl_erf((pixelStart - x[d]) / (itk::Math::sqrt2 * sigma));
+    }
+    sumOfWeightedPixels += weight * it.Get();
+    sumOfWeights += weight;
+  }
+  return sumOfWeightedPixels / sumOfWeights;
+}
+
+
+template <typename TImage>
+void
+Expect_separable_kernels_match_their_reference(const typename TImage::SizeType & imageSize)
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+  using HammingType = itk::Function::HammingWindowFunction<2>;
+  using LanczosType = itk::Function::LanczosWindowFunction<3>;
+  using HammingInterpolatorType = itk::WindowedSincInterpolateImageFunction<TImage, 2, HammingType>;
+  using LanczosInterpolatorType = itk::WindowedSincInterpolateImageFunction<TImage, 3, LanczosType>;
+  using ConstantInterpolatorType =
+    itk::WindowedSincInterpolateImageFunction<TImage, 2, HammingType, itk::ConstantBoundaryCondition<TImage>>;
+  using GaussianInterpolatorType = itk::GaussianInterpolateImageFunction<TImage>;
+  using LabelInterpolatorType = itk::LabelImageGaussianInterpolateImageFunction<TImage>;
+
+  std::mt19937 randomEngine;
+  const auto   image = CreateRandomImage<TImage>(imageSize, randomEngine);
+
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<HammingInterpolatorType>(
+    image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<LanczosInterpolatorType>(
+    image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<ConstantInterpolatorType>(
+    image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<GaussianInterpolatorType>(
+    image, randomEngine);
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<LabelInterpolatorType>(
+    image, randomEngine);
+
+  const auto hammingInterpolator = HammingInterpolatorType::New();
+  hammingInterpolator->SetInputImage(image);
+  const auto lanczosInterpolator = LanczosInterpolatorType::New();
+  lanczosInterpolator->SetInputImage(image);
+  const auto gaussianInterpolator = GaussianInterpolatorType::New();
+  gaussianInterpolator->SetInputImage(image);
+  constexpr double sigma = 0.8;
+  constexpr double alpha = 2.5;
+  gaussianInterpolator->SetSigma(itk::FixedArray<double, Dimension>::Filled(sigma));
+  gaussianInterpolator->SetAlpha(alpha);
+
+  for (const auto & x : CreatePositions(*hammingInterpolator, randomEngine))
+  {
+    EXPECT_NEAR(hammingInterpolator->EvaluateAtContinuousIndex(x),
+                (ComputeWindowedSincReference<TImage, 2, HammingType>(*image, x)),
+                1e-10)
+      << "at " << x;
+    EXPECT_NEAR(lanczosInterpolator->EvaluateAtContinuousIndex(x),
+                (ComputeWindowedSincReference<TImage, 3, LanczosType>(*image, x)),
+                1e-10)
+      << "at " << x;
+    EXPECT_NEAR(
+      gaussianInterpolator->EvaluateAtContinuousIndex(x), ComputeGaussianReference(*image, x, sigma, alpha), 1e-10)
+      << "at " << x;
+  }
+}
+} // namespace
+
+
+TEST(InterpolateImageFunction, EvaluateAtContinuousIndicesOfScalarImage)
+{
+  Expect_batched_interpolation_is_exact<itk::Image<short, 1>>({ { 11 } });
+  Expect_batched_interpolation_is_exact<itk::Image<unsigned char, 2>>({ { 7, 5 } });
+  Expect_batched_interpolation_is_exact<itk::Image<float, 3>>({ { 6, 5, 4 } });
+  Expect_batched_interpolation_is_exact<itk::Image<double, 4>>({ { 3, 4, 2, 3 } });
+
+  // A single pixel along one of the dimensions
+  Expect_batched_interpolation_is_exact<itk::Image<float, 3>>({ { 6, 1, 4 } });
+}
+
+
+TEST(InterpolateImageFunction, SeparableKernels)
+{
+  Expect_separable_kernels_match_their_reference<itk::Image<short, 1>>({ { 15 } });
+  Expect_separable_kernels_match_their_reference<itk::Image<float, 2>>({ { 13, 11 } });
+  Expect_separable_kernels_match_their_reference<itk::Image<double, 3>>({ { 9, 10, 8 } });
+}
+
+
+TEST(InterpolateImageFunction, LabelImageGaussianWithManyLabels)
+{
+  using ImageType = itk::Image<unsigned short, 2>;
+  using InterpolatorType = itk::LabelImageGaussianInterpolateImageFunction<ImageType>;
+
+  // Blocks of labels among hundreds, with random labels in between, so that
+  // some regions hold more labels than the interpolator keeps on the stack
+  std::mt19937 randomEngine;
+  const auto   image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 24, 20 } });
+  image->Allocate();
+  std::uniform_int_distribution<unsigned short> labelDistribution(0, 499);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(index[0] < 12 ? static_cast<unsigned short>(100 + index[0] / 3 + 8 * (index[1] / 4))
+                         : labelDistribution(randomEngine));
+  }
+
+  constexpr double sigma = 1.5;
+  constexpr double alpha = 2.0;
+  const auto       interpolator = InterpolatorType::New();
+  interpolator->SetInputImage(image);
+  interpolator->SetSigma(itk::FixedArray<double, 2>::Filled(sigma));
+  interpolator->SetAlpha(alpha);
+
+  const auto positions = CreatePositions(*interpolator, randomEngine);
+  std::vector<InterpolatorType::OutputType> values(positions.size());
+  interpolator->EvaluateAtContinuousIndices(positions.data(), values.data(), positions.size());
+
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    const auto & x = positions[i];
+
+    // The label of largest weight, accumulating the weights in a map
+    ImageType::RegionType region;
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      const auto begin =
+        std::max(itk::IndexValueType{ 0 }, static_cast<itk::IndexValueType>(std::floor(x[d] + 0.5 - sigma * alpha)));
+      const auto end = std::min(static_cast<itk::IndexValueType>(image->GetBufferedRegion().GetSize(d)),
+                                static_cast<itk::IndexValueType>(std::ceil(x[d] + 0.5 + sigma * alpha)));
+      region.SetIndex(d, begin);
+      region.SetSize(d, static_cast<itk::SizeValueType>(end - begin));
+    }
+    std::map<double, double> weights;
+    double                   maximumWeight = 0.0;
+    double                   expectedLabel = 0.0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      double weight = 1.0;
+      for (unsigned int d = 0; d < 2; ++d)
+      {
+        const double pixelStart = static_cast<double>(it.GetIndex()[d]) - 0.5;
+        weight *= vnl_erf((pixelStart + 1.0 - x[d]) / (itk::Math::sqrt2 * sigma)) -
+                  vnl_erf((pixelStart - x[d]) / (itk::Math::sqrt2 * sigma));
+      }
+      const double labelWeight = weights[it.Get()] += weight;
+      if (labelWeight > maximumWeight)
+      {
+        maximumWeight = labelWeight;
+        expectedLabel = it.Get();
+      }
+    }
+
+    EXPECT_EQ(values[i], expectedLabel) << "at " << x;
+    EXPECT_EQ(values[i], interpolator->EvaluateAtContinuousIndex(x)) << "at " << x;
+  }
+}
+
+
+TEST(InterpolateImageFunction, EvaluateAtContinuousIndicesOfVectorImage)
+{
+  using ImageType = itk::VectorImage<float, 2>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 6, 5 } });
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+
+  std::mt19937                       randomEngine;
+  std::uniform_int_distribution<int> distribution(-100, 100);
+  for (itk::SizeValueType i = 0; i < image->GetPixelContainer()->Size(); ++i)
+  {
+    image->GetBufferPointer()[i] = static_cast<float>(distribution(randomEngine));
+  }
+
+  Expect_EvaluateAtContinuousIndices_returns_same_values_as_EvaluateAtContinuousIndex<
+    itk::LinearInterpolateImageFunction<ImageType>>(image, randomEngine);
+}
+
+
+TEST(InterpolateImageFunction, EvaluateAtContinuousIndicesPreservesInfinity)
+{
+  using ImageType = itk::Image<double, 2>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 3, 3 } });
+  image->Allocate(true);
+  image->SetPixel({ { 1, 1 } }, std::numeric_limits<double>::infinity());
+
+  const auto interpolator = itk::LinearInterpolateImageFunction<ImageType>::New();
+  interpolator->SetInputImage(image);
+
+  itk::ContinuousIndex<double, 2> position;
+  position.Fill(1.0);
+  double value{};
+  interpolator->EvaluateAtContinuousIndices(&position, &value, 1);
+  EXPECT_EQ(value, std::numeric_limits<double>::infinity());
+}
@@ -295,6 +295,26 @@ public:
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override = 0;
 
+  using typename Superclass::NonZeroJacobianIndicesType;
+
+  /** Return the number of parameters that affect the transform at any point:
+   * SpaceDimension times the number of B-spline weights. */
+  NumberOfParametersType
+  GetNumberOfNonZeroJacobianIndices() const override
+  {
+    return NumberOfWeights * SpaceDimension;
+  }
+
+  /** Compute the jacobian with respect to the parameters of the support
+   * region of the point only. Column (d * NumberOfWeights + k) holds the
+   * k-th B-spline weight, for the parameter of dimension d of the k-th
+   * coefficient of the support region. Outside the valid region, all the
+   * weights are zero. */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       point,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
   void
   ComputeJacobianWithRespectToPosition(const InputPointType &, JacobianPositionType &) const override
   {
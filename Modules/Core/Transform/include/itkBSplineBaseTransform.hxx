@@ -268,6 +268,30 @@ BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       point,
+  JacobianType &               jacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  WeightsType             weights;
+  ParameterIndexArrayType indexes;
+  this->ComputeJacobianFromBSplineWeightsWithRespectToPosition(point, weights, indexes);
+
+  jacobian.Fill(0.0);
+  const NumberOfParametersType numberOfParametersPerDimension = this->GetNumberOfParametersPerDimension();
+  for (unsigned int d = 0; d < SpaceDimension; ++d)
+  {
+    for (unsigned int k = 0; k < NumberOfWeights; ++k)
+    {
+      const unsigned int column = d * NumberOfWeights + k;
+      jacobian(d, column) = weights[k];
+      nonZeroJacobianIndices[column] = indexes[k] + d * numberOfParametersPerDimension;
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 unsigned int
 BSplineBaseTransform<TParametersValueType, VDimension, VSplineOrder>::GetNumberOfAffectedWeights() const
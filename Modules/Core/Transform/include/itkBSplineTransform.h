@@ -238,6 +238,16 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
 
+  /** Transform a batch of points. The interpolation weights along a
+   * dimension are only computed again when the continuous index of the
+   * point along that dimension differs from the one of the previous point,
+   * which saves most of the computation along the scan lines of an image
+   * aligned with the grid of control points. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
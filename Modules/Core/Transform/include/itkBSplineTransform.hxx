@@ -22,6 +22,8 @@
 #include "itkContinuousIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkBSplineKernelFunction.h"
+#include <limits>
 
 namespace itk
 {
@@ -597,6 +599,117 @@ BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoint
   }
 }
 
+template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  constexpr unsigned int SupportSize = SplineOrder + 1;
+
+  // Buffer offsets of the coefficients of the support region, relative to
+  // its first coefficient, in the order of the weights
+  const OffsetValueType *                            offsetTable = coefficientImage->GetOffsetTable();
+  FixedArray<OffsetValueType, Self::NumberOfWeights> supportOffsets;
+  for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+  {
+    supportOffsets[k] = 0;
+    unsigned int remainder = k;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      supportOffsets[k] += static_cast<OffsetValueType>(remainder % SupportSize) * offsetTable[j];
+      remainder /= SupportSize;
+    }
+  }
+
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  ContinuousIndexType previousIndex;
+  previousIndex.Fill(std::numeric_limits<typename ContinuousIndexType::ValueType>::quiet_NaN());
+  IndexType                                   supportIndex{};
+  Matrix<double, SpaceDimension, SupportSize> weights1D;
+  WeightsType                                 weights{};
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    // Copied, as the input and output arrays may be the same
+    const InputPointType point = inputPoints[i];
+
+    ContinuousIndexType index =
+      coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+        point);
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[i] = point;
+      continue;
+    }
+
+    // Compute the weights as BSplineInterpolationWeightFunction does, only
+    // along the dimensions along which the index has changed
+    bool weightsChanged = false;
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      if (Math::NotExactlyEquals(index[j], previousIndex[j]))
+      {
+        previousIndex[j] = index[j];
+        supportIndex[j] = Math::Floor<IndexValueType>(index[j] + 0.5 - SplineOrder / 2.0);
+
+        double x = index[j] - static_cast<double>(supportIndex[j]);
+        for (unsigned int k = 0; k < SupportSize; ++k)
+        {
+          weights1D[j][k] = BSplineKernelFunction<SplineOrder>::FastEvaluate(x);
+          x -= 1.0;
+        }
+        weightsChanged = true;
+      }
+    }
+    if (weightsChanged)
+    {
+      for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+      {
+        weights[k] = 1.0;
+        unsigned int remainder = k;
+        for (unsigned int j = 0; j < SpaceDimension; ++j)
+        {
+          weights[k] *= weights1D[j][remainder % SupportSize];
+          remainder /= SupportSize;
+        }
+      }
+    }
+
+    // For each dimension, correlate coefficient with weights
+    const OffsetValueType supportStartOffset = coefficientImage->ComputeOffset(supportIndex);
+    OutputPointType       outputPoint;
+    outputPoint.Fill(NumericTraits<ScalarType>::ZeroValue());
+    for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+    {
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        outputPoint[j] += static_cast<ScalarType>(weights[k] * coefficients[j][supportStartOffset + supportOffsets[k]]);
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoint[j] += point[j];
+    }
+    outputPoints[i] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, VDimension, VSplineOrder>::ComputeJacobianWithRespectToParameters(
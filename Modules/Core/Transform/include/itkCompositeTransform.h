@@ -19,8 +19,10 @@
 #define itkCompositeTransform_h
 
 #include "itkMultiTransform.h"
+#include "itkAffineTransform.h"
 
 #include <deque>
+#include <vector>
 
 namespace itk
 {
@@ -81,6 +83,15 @@ namespace itk
  * sub transform and adding them to a composite transform in reverse order.
  * The m_TransformsToOptimizeFlags is copied in reverse for the inverse.
  *
+ * Precomposition:
+ * GetPrecomposedTransform() returns a transform which maps points as this
+ * composite transform does, in which each run of consecutive linear
+ * transforms of the queue is multiplied into a single AffineTransform. It
+ * is cached, and computed again only when this transform or one of its
+ * sub-transforms has been modified. ResampleImageFilter and
+ * ImageToImageMetricv4 use it to map points, so that the cost of long
+ * stacks of linear transforms does not grow with their length.
+ *
  * \ingroup ITKTransform
  */
 template <typename TParametersValueType = double, unsigned int VDimension = 3>
@@ -258,6 +269,30 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform a batch of points, applying each sub-transform to the whole
+   * batch in turn, so that the sub-transforms may share their intermediate
+   * results between the points. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
+  /** Return a transform which maps the points as this transform does, in
+   * which each run of consecutive linear sub-transforms is replaced by a
+   * single AffineTransform. It is this transform's only remaining
+   * sub-transform when there is one left, and a new CompositeTransform
+   * otherwise; the sub-transforms which are not linear are shared.
+   *
+   * The result is cached until this transform, or one of its
+   * sub-transforms, is modified. The matrices of its affine transforms are
+   * updated on each call, as some transforms change their mapping without
+   * being modified. This method is not thread safe: call it
+   * before using the result from several threads. Only the mapping of
+   * points is meant to be done with the result, since its parameters differ
+   * from those of this transform. */
+  const TransformType *
+  GetPrecomposedTransform() const;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -406,6 +441,25 @@ public:
                                                           JacobianType &         outJacobian,
                                                           JacobianType &         cacheJacobian) const override;
 
+  using typename Superclass::NonZeroJacobianIndicesType;
+
+  /** Return the sum of the numbers of non-zero jacobian indices of the
+   * transforms that are set to be optimized. */
+  NumberOfParametersType
+  GetNumberOfNonZeroJacobianIndices() const override;
+
+  /**
+   * Compute the sparse Jacobian with respect to the parameters of the
+   * transforms that are set to be optimized, using the same chain rule as
+   * ComputeJacobianWithRespectToParametersCachedTemporaries(). The columns
+   * of each sub-transform are mapped to the local parameters of the
+   * composite transform.
+   */
+  void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               outJacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const override;
+
 protected:
   CompositeTransform() = default;
   ~CompositeTransform() override = default;
@@ -454,7 +508,19 @@ protected:
   TransformsToOptimizeFlagsType m_TransformsToOptimizeFlags{};
 
 private:
+  /** Latest modification time of this transform and of its sub-transforms,
+   * including those of nested composite transforms. */
+  ModifiedTimeType
+  GetTransformQueueMTime() const;
+
   mutable ModifiedTimeType m_PreviousTransformsToOptimizeUpdateTime{};
+
+  using PrecomposedAffineTransformType = AffineTransform<TParametersValueType, VDimension>;
+
+  mutable TransformTypePointer m_PrecomposedTransform{};
+  mutable ModifiedTimeType     m_PrecomposedTransformUpdateTime{};
+  /** The affine transforms of m_PrecomposedTransform, in queue order. */
+  mutable std::vector<typename PrecomposedAffineTransformType::Pointer> m_PrecomposedAffineTransforms{};
 };
 
 } // end namespace itk
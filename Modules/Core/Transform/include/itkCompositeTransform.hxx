@@ -18,6 +18,8 @@
 #ifndef itkCompositeTransform_hxx
 #define itkCompositeTransform_hxx
 
+#include <algorithm>
+#include <iterator>
 
 namespace itk
 {
@@ -72,6 +74,153 @@ CompositeTransform<TParametersValueType, VDimension>::TransformPoint(const Input
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                      OutputPointType *      outputPoints,
+                                                                      SizeValueType          numberOfPoints) const
+{
+  if (outputPoints != inputPoints)
+  {
+    std::copy_n(inputPoints, numberOfPoints, outputPoints);
+  }
+
+  /* Apply in reverse queue order.  */
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::GetPrecomposedTransform() const -> const TransformType *
+{
+  const ModifiedTimeType transformQueueMTime = this->GetTransformQueueMTime();
+  const bool             isQueueUnchanged =
+    m_PrecomposedTransform.IsNotNull() && transformQueueMTime <= m_PrecomposedTransformUpdateTime;
+
+  using MatrixOffsetTransformType = MatrixOffsetTransformBase<TParametersValueType, VDimension, VDimension>;
+  using LinearMatrixType = typename PrecomposedAffineTransformType::MatrixType;
+
+  TransformQueueType                                            precomposedQueue;
+  std::vector<typename PrecomposedAffineTransformType::Pointer> affineTransforms;
+  size_t                                                        numberOfAffineTransforms = 0;
+  for (auto it = this->m_TransformQueue.begin(); it != this->m_TransformQueue.end();)
+  {
+    auto runEnd = it;
+    while (runEnd != this->m_TransformQueue.end() && (*runEnd)->IsLinear())
+    {
+      ++runEnd;
+    }
+    if (std::distance(it, runEnd) < 2)
+    {
+      precomposedQueue.push_back(*it);
+      ++it;
+      continue;
+    }
+
+    // Compose the run of linear transforms, starting from the back, which
+    // is applied first. This is redone even when the queue is unchanged,
+    // since some transforms (e.g. Euler3DTransform::SetRotation()) change
+    // their mapping without being modified.
+    LinearMatrixType matrix;
+    OutputVectorType offset{};
+    matrix.SetIdentity();
+    for (auto rit = runEnd; rit != it;)
+    {
+      --rit;
+      LinearMatrixType transformMatrix;
+      OutputVectorType transformOffset;
+      if (const auto * matrixOffsetTransform = dynamic_cast<const MatrixOffsetTransformType *>(rit->GetPointer()))
+      {
+        transformMatrix = matrixOffsetTransform->GetMatrix();
+        transformOffset = matrixOffsetTransform->GetOffset();
+      }
+      else
+      {
+        // Other linear transforms are probed at the origin and along the axes
+        InputPointType  point{};
+        OutputPointType origin = (*rit)->TransformPoint(point);
+        transformOffset = origin.GetVectorFromOrigin();
+        for (unsigned int j = 0; j < VDimension; ++j)
+        {
+          point.Fill(0.0);
+          point[j] = 1.0;
+          const OutputVectorType column = (*rit)->TransformPoint(point) - origin;
+          for (unsigned int i = 0; i < VDimension; ++i)
+          {
+            transformMatrix[i][j] = column[i];
+          }
+        }
+      }
+      matrix = transformMatrix * matrix;
+      offset = transformMatrix * offset + transformOffset;
+    }
+
+    if (isQueueUnchanged)
+    {
+      // Only update the cached affine transform when its mapping changed
+      PrecomposedAffineTransformType * affineTransform = m_PrecomposedAffineTransforms[numberOfAffineTransforms];
+      if (affineTransform->GetMatrix() != matrix || affineTransform->GetOffset() != offset)
+      {
+        affineTransform->SetMatrix(matrix);
+        affineTransform->SetOffset(offset);
+      }
+    }
+    else
+    {
+      auto affineTransform = PrecomposedAffineTransformType::New();
+      affineTransform->SetMatrix(matrix);
+      affineTransform->SetOffset(offset);
+      precomposedQueue.push_back(affineTransform.GetPointer());
+      affineTransforms.push_back(affineTransform);
+    }
+    ++numberOfAffineTransforms;
+    it = runEnd;
+  }
+
+  if (isQueueUnchanged)
+  {
+    return m_PrecomposedTransform;
+  }
+
+  m_PrecomposedAffineTransforms = std::move(affineTransforms);
+
+  if (precomposedQueue.size() == 1)
+  {
+    m_PrecomposedTransform = precomposedQueue.front();
+  }
+  else
+  {
+    auto precomposedTransform = Self::New();
+    for (const auto & transform : precomposedQueue)
+    {
+      precomposedTransform->AddTransform(transform);
+    }
+    m_PrecomposedTransform = precomposedTransform.GetPointer();
+  }
+  m_PrecomposedTransformUpdateTime = transformQueueMTime;
+  return m_PrecomposedTransform;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+ModifiedTimeType
+CompositeTransform<TParametersValueType, VDimension>::GetTransformQueueMTime() const
+{
+  ModifiedTimeType mtime = this->GetMTime();
+  for (const auto & transform : this->m_TransformQueue)
+  {
+    const auto *           nestedCompositeTransform = dynamic_cast<const Self *>(transform.GetPointer());
+    const ModifiedTimeType transformMTime =
+      nestedCompositeTransform ? nestedCompositeTransform->GetTransformQueueMTime() : transform->GetMTime();
+    mtime = std::max(mtime, transformMTime);
+  }
+  return mtime;
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::TransformVector(const InputVectorType & inputVector) const
@@ -606,6 +755,122 @@ CompositeTransform<TParametersValueType, VDimension>::ComputeJacobianWithRespect
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+auto
+CompositeTransform<TParametersValueType, VDimension>::GetNumberOfNonZeroJacobianIndices() const
+  -> NumberOfParametersType
+{
+  if (this->GetNumberOfTransforms() == 1)
+  {
+    return this->GetNthTransformConstPointer(0)->GetNumberOfNonZeroJacobianIndices();
+  }
+
+  NumberOfParametersType result{};
+  for (long tind = (long)this->GetNumberOfTransforms() - 1; tind >= 0; tind--)
+  {
+    if (this->GetNthTransformToOptimize(tind))
+    {
+      result += this->GetNthTransformConstPointer(tind)->GetNumberOfNonZeroJacobianIndices();
+    }
+  }
+  return result;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+CompositeTransform<TParametersValueType, VDimension>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &       p,
+  JacobianType &               outJacobian,
+  NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+{
+  const NumberOfParametersType numberOfNonZeroJacobianIndices = this->GetNumberOfNonZeroJacobianIndices();
+  assert(outJacobian.rows() == VDimension && outJacobian.cols() == numberOfNonZeroJacobianIndices);
+  assert(nonZeroJacobianIndices.size() == numberOfNonZeroJacobianIndices);
+
+  if (this->GetNumberOfTransforms() == 1)
+  {
+    this->GetNthTransformConstPointer(0)->ComputeSparseJacobianWithRespectToParameters(
+      p, outJacobian, nonZeroJacobianIndices);
+    return;
+  }
+
+  // Column offset into outJacobian, and offset of the local parameters of
+  // the current transform, following the order of
+  // ComputeJacobianWithRespectToParametersCachedTemporaries().
+  NumberOfParametersType offset{};
+  NumberOfParametersType parameterOffset{};
+
+  JacobianType               subJacobian;
+  NonZeroJacobianIndicesType subNonZeroJacobianIndices;
+
+  OutputPointType transformedPoint(p);
+
+  for (long tind = (long)this->GetNumberOfTransforms() - 1; tind >= 0; --tind)
+  {
+    const TransformType * const transform = this->GetNthTransformConstPointer(tind);
+
+    const NumberOfParametersType offsetLast = offset;
+
+    if (this->GetNthTransformToOptimize(tind))
+    {
+      const NumberOfParametersType numberOfSubIndices = transform->GetNumberOfNonZeroJacobianIndices();
+
+      if (numberOfSubIndices == numberOfNonZeroJacobianIndices)
+      {
+        // The only transform to optimize: its sparse jacobian is the one of
+        // the composite transform, up to the position jacobians applied below.
+        transform->ComputeSparseJacobianWithRespectToParameters(transformedPoint, outJacobian, nonZeroJacobianIndices);
+        for (auto & index : nonZeroJacobianIndices)
+        {
+          index += parameterOffset;
+        }
+      }
+      else
+      {
+        subJacobian.SetSize(VDimension, numberOfSubIndices);
+        subNonZeroJacobianIndices.resize(numberOfSubIndices);
+        transform->ComputeSparseJacobianWithRespectToParameters(
+          transformedPoint, subJacobian, subNonZeroJacobianIndices);
+        outJacobian.update(subJacobian, 0, offset);
+        for (NumberOfParametersType j = 0; j < numberOfSubIndices; ++j)
+        {
+          nonZeroJacobianIndices[offset + j] = parameterOffset + subNonZeroJacobianIndices[j];
+        }
+      }
+      offset += numberOfSubIndices;
+      parameterOffset += transform->GetNumberOfLocalParameters();
+    }
+
+    // Left multiply the columns of the previous transforms by dTk / dT{k-1}
+    if (offsetLast > 0)
+    {
+      JacobianPositionType jacobianWithRespectToPosition;
+      transform->ComputeJacobianWithRespectToPosition(transformedPoint, jacobianWithRespectToPosition);
+
+      double temp[VDimension];
+      for (unsigned int c = 0; c < offsetLast; ++c)
+      {
+        for (unsigned int r = 0; r < VDimension; ++r)
+        {
+          temp[r] = 0.0;
+          for (unsigned int k = 0; k < VDimension; ++k)
+          {
+            temp[r] += jacobianWithRespectToPosition[r][k] * outJacobian[k][c];
+          }
+        }
+        for (unsigned int r = 0; r < VDimension; ++r)
+        {
+          outJacobian[r][c] = temp[r];
+        }
+      }
+    }
+
+    transformedPoint = transform->TransformPoint(transformedPoint);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 CompositeTransform<TParametersValueType, VDimension>::GetParameters() const -> const ParametersType &
@@ -978,6 +1243,11 @@ CompositeTransform<TParametersValueType, VDimension>::PrintSelf(std::ostream & o
   os << indent << "PreviousTransformsToOptimizeUpdateTime: "
      << static_cast<typename NumericTraits<ModifiedTimeType>::PrintType>(m_PreviousTransformsToOptimizeUpdateTime)
      << std::endl;
+
+  itkPrintSelfObjectMacro(PrecomposedTransform);
+  os << indent << "PrecomposedTransformUpdateTime: "
+     << static_cast<typename NumericTraits<ModifiedTimeType>::PrintType>(m_PrecomposedTransformUpdateTime)
+     << std::endl;
 }
 
 
@@ -150,6 +150,12 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & thisPoint) const override;
 
+  /** Compute the positions of a batch of points in the new space. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** These vector transforms are not implemented for this transform */
   using Superclass::TransformVector;
   OutputVectorType
@@ -304,6 +310,27 @@ protected:
   virtual void
   ComputeDeformationContribution(const InputPointType & thisPoint, OutputPointType & result) const;
 
+  /** Add the deformation contributions at each of the numberOfPoints points
+   * to the corresponding results, which must not overlap the points. The
+   * default implementation calls ComputeDeformationContribution() for each
+   * point. */
+  virtual void
+  ComputeDeformationContributions(const InputPointType * points,
+                                  OutputPointType *      results,
+                                  SizeValueType          numberOfPoints) const;
+
+  /** Add the deformation contributions at the points of a kernel
+   * \f$ G(x) = k(r(x)) I \f$, k being given by kernelFunction, a callable
+   * taking the Euclidean norm r. Used by the subclasses whose kernel is a
+   * scalar multiple of the identity to implement
+   * ComputeDeformationContributions(). */
+  template <typename TKernelFunction>
+  void
+  AccumulateScalarKernelContributions(const InputPointType * points,
+                                      OutputPointType *      results,
+                                      SizeValueType          numberOfPoints,
+                                      TKernelFunction        kernelFunction) const;
+
   /** Compute K matrix. */
   void
   ComputeK();
@@ -331,6 +358,17 @@ protected:
   void
   ReorganizeW();
 
+  /** Compute the D, A and B components from the scalar system, when the
+   * kernel G is a scalar multiple of the identity for all the pairs of
+   * landmarks. Returns false, without computing them, otherwise. */
+  bool
+  ComputeWMatrixOfScalarKernel();
+
+  /** Add the affine component of the transformation at thisPoint, and the
+   * point itself, to result. */
+  void
+  AddAffineContribution(const InputPointType & thisPoint, OutputPointType & result) const;
+
   /** Stiffness parameter */
   double m_Stiffness{};
 
@@ -18,6 +18,13 @@
 #ifndef itkKernelTransform_hxx
 #define itkKernelTransform_hxx
 
+#include "itkMath.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm> // For min.
+#include <array>
+#include <atomic>
+
 namespace itk
 {
 
@@ -118,6 +125,58 @@ KernelTransform<TParametersValueType, VDimension>::ComputeDeformationContributio
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+KernelTransform<TParametersValueType, VDimension>::ComputeDeformationContributions(
+  const InputPointType * points,
+  OutputPointType *      results,
+  SizeValueType          numberOfPoints) const
+{
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    this->ComputeDeformationContribution(points[i], results[i]);
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+template <typename TKernelFunction>
+void
+KernelTransform<TParametersValueType, VDimension>::AccumulateScalarKernelContributions(
+  const InputPointType * points,
+  OutputPointType *      results,
+  SizeValueType          numberOfPoints,
+  TKernelFunction        kernelFunction) const
+{
+  const PointIdentifier numberOfLandmarks = this->m_SourceLandmarks->GetNumberOfPoints();
+  const auto &          landmarks = this->m_SourceLandmarks->GetPoints()->CastToSTLConstContainer();
+
+  // The landmarks are in the outer loop, so that each of them and its
+  // coefficients are loaded once for all the points, whose contributions
+  // are accumulated independently.
+  for (PointIdentifier lnd = 0; lnd < numberOfLandmarks; ++lnd)
+  {
+    const InputPointType & landmark = landmarks[lnd];
+
+    std::array<TParametersValueType, VDimension> coefficients;
+    for (unsigned int odim = 0; odim < VDimension; ++odim)
+    {
+      coefficients[odim] = this->m_DMatrix(odim, lnd);
+    }
+
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      const InputVectorType      position = points[i] - landmark;
+      const TParametersValueType kernelValue = kernelFunction(position.GetNorm());
+      for (unsigned int odim = 0; odim < VDimension; ++odim)
+      {
+        results[i][odim] += kernelValue * coefficients[odim];
+      }
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 void
 KernelTransform<TParametersValueType, VDimension>::ComputeD()
@@ -147,6 +206,11 @@ KernelTransform<TParametersValueType, VDimension>::ComputeWMatrix()
 {
   using SVDSolverType = vnl_svd<TParametersValueType>;
 
+  if (this->ComputeWMatrixOfScalarKernel())
+  {
+    return;
+  }
+
   this->ComputeL();
   this->ComputeY();
   SVDSolverType svd(this->m_LMatrix, 1e-8);
@@ -317,6 +381,130 @@ KernelTransform<TParametersValueType, VDimension>::ReorganizeW()
 }
 
 
+template <typename TParametersValueType, unsigned int VDimension>
+bool
+KernelTransform<TParametersValueType, VDimension>::ComputeWMatrixOfScalarKernel()
+{
+  using SVDSolverType = vnl_svd<TParametersValueType>;
+  using ScalarMatrixType = vnl_matrix<TParametersValueType>;
+
+  const auto isScalar = [](const GMatrixType & G) {
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      for (unsigned int j = 0; j < VDimension; ++j)
+      {
+        if (Math::NotExactlyEquals(G(i, j), (i == j) ? G(0, 0) : TParametersValueType{}))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  const PointIdentifier numberOfLandmarks = this->m_SourceLandmarks->GetNumberOfPoints();
+  const auto &          landmarks = this->m_SourceLandmarks->GetPoints()->CastToSTLConstContainer();
+
+  // Block diagonal of K, computed sequentially as ComputeReflexiveG() is not
+  // thread-safe.
+  vnl_vector<TParametersValueType> reflexiveValues(numberOfLandmarks);
+  PointsIterator                   p = this->m_SourceLandmarks->GetPoints()->Begin();
+  for (PointIdentifier i = 0; i < numberOfLandmarks; ++i, ++p)
+  {
+    const GMatrixType & G = this->ComputeReflexiveG(p);
+    if (!isScalar(G))
+    {
+      return false;
+    }
+    reflexiveValues[i] = G(0, 0);
+  }
+
+  // Scalar L matrix, [ K P ; P^T 0 ], with rows of P made of the landmark
+  // coordinates and 1.
+  const unsigned int size = numberOfLandmarks + VDimension + 1;
+  ScalarMatrixType   scalarLMatrix(size, size, 0.0);
+
+  std::atomic<bool> isScalarKernel{ true };
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfLandmarks,
+    [&](SizeValueType i) {
+      GMatrixType G;
+      for (PointIdentifier j = 0; j < numberOfLandmarks && isScalarKernel; ++j)
+      {
+        if (j == i)
+        {
+          scalarLMatrix(i, i) = reflexiveValues[i];
+          continue;
+        }
+        this->ComputeG(landmarks[i] - landmarks[j], G);
+        if (!isScalar(G))
+        {
+          isScalarKernel = false;
+          return;
+        }
+        scalarLMatrix(i, j) = G(0, 0);
+      }
+    },
+    nullptr);
+  if (!isScalarKernel)
+  {
+    return false;
+  }
+
+  for (PointIdentifier i = 0; i < numberOfLandmarks; ++i)
+  {
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      scalarLMatrix(i, numberOfLandmarks + j) = landmarks[i][j];
+      scalarLMatrix(numberOfLandmarks + j, i) = landmarks[i][j];
+    }
+    scalarLMatrix(i, numberOfLandmarks + VDimension) = 1.0;
+    scalarLMatrix(numberOfLandmarks + VDimension, i) = 1.0;
+  }
+
+  // Scalar Y matrix, with one column per component of the displacements
+  this->ComputeD();
+  ScalarMatrixType                      scalarYMatrix(size, VDimension, 0.0);
+  typename VectorSetType::ConstIterator displacement = this->m_Displacements->Begin();
+  for (PointIdentifier i = 0; i < numberOfLandmarks; ++i, ++displacement)
+  {
+    for (unsigned int j = 0; j < VDimension; ++j)
+    {
+      scalarYMatrix(i, j) = displacement.Value()[j];
+    }
+  }
+
+  // The singular values of L are those of the scalar L, each repeated
+  // VDimension times, so the same tolerance gives the same solution.
+  const SVDSolverType    svd(scalarLMatrix, 1e-8);
+  const ScalarMatrixType scalarWMatrix = svd.solve(scalarYMatrix);
+
+  this->m_DMatrix.set_size(VDimension, numberOfLandmarks);
+  for (PointIdentifier lnd = 0; lnd < numberOfLandmarks; ++lnd)
+  {
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      this->m_DMatrix(dim, lnd) = scalarWMatrix(lnd, dim);
+    }
+  }
+  for (unsigned int j = 0; j < VDimension; ++j)
+  {
+    for (unsigned int i = 0; i < VDimension; ++i)
+    {
+      this->m_AMatrix(i, j) = scalarWMatrix(numberOfLandmarks + j, i);
+    }
+  }
+  for (unsigned int k = 0; k < VDimension; ++k)
+  {
+    this->m_BVector(k) = scalarWMatrix(numberOfLandmarks + VDimension, k);
+  }
+
+  this->m_WMatrix = WMatrixType(1, 1);
+  return true;
+}
+
+
 template <typename TParametersValueType, unsigned int VDimension>
 auto
 KernelTransform<TParametersValueType, VDimension>::TransformPoint(const InputPointType & thisPoint) const
@@ -331,6 +519,47 @@ KernelTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoi
   // TODO:  It is unclear if the following line is needed.
   this->ComputeDeformationContribution(thisPoint, result);
 
+  this->AddAffineContribution(thisPoint, result);
+
+  return result;
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+KernelTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                   OutputPointType *      outputPoints,
+                                                                   SizeValueType          numberOfPoints) const
+{
+  // The contributions of a block are kept apart from the output points,
+  // which may be the input points.
+  constexpr SizeValueType                blockSize = 64;
+  std::array<OutputPointType, blockSize> results;
+
+  for (SizeValueType first = 0; first < numberOfPoints; first += blockSize)
+  {
+    const SizeValueType count = std::min(blockSize, numberOfPoints - first);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      results[i].Fill(typename OutputPointType::ValueType{});
+    }
+
+    this->ComputeDeformationContributions(inputPoints + first, results.data(), count);
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      this->AddAffineContribution(inputPoints[first + i], results[i]);
+      outputPoints[first + i] = results[i];
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int VDimension>
+void
+KernelTransform<TParametersValueType, VDimension>::AddAffineContribution(const InputPointType & thisPoint,
+                                                                         OutputPointType &      result) const
+{
   // Add the rotational part of the Affine component
   for (unsigned int j = 0; j < VDimension; ++j)
   {
@@ -344,8 +573,6 @@ KernelTransform<TParametersValueType, VDimension>::TransformPoint(const InputPoi
   {
     result[k] += this->m_BVector(k) + thisPoint[k];
   }
-
-  return result;
 }
 
 
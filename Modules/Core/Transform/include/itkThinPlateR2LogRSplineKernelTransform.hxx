@@ -40,22 +40,19 @@ ThinPlateR2LogRSplineKernelTransform<TParametersValueType, VDimension>::ComputeD
   const InputPointType & thisPoint,
   OutputPointType &      result) const
 {
-  unsigned long numberOfLandmarks = this->m_SourceLandmarks->GetNumberOfPoints();
-
-  PointsIterator sp = this->m_SourceLandmarks->GetPoints()->Begin();
+  this->ComputeDeformationContributions(&thisPoint, &result, 1);
+}
 
-  for (unsigned int lnd = 0; lnd < numberOfLandmarks; ++lnd)
-  {
-    InputVectorType            position = thisPoint - sp->Value();
-    const TParametersValueType r = position.GetNorm();
-    const TParametersValueType R2logR =
-      (r > 1e-8) ? r * r * std::log(r) : NumericTraits<TParametersValueType>::ZeroValue();
-    for (unsigned int odim = 0; odim < VDimension; ++odim)
-    {
-      result[odim] += R2logR * this->m_DMatrix(odim, lnd);
-    }
-    ++sp;
-  }
+template <typename TParametersValueType, unsigned int VDimension>
+void
+ThinPlateR2LogRSplineKernelTransform<TParametersValueType, VDimension>::ComputeDeformationContributions(
+  const InputPointType * points,
+  OutputPointType *      results,
+  SizeValueType          numberOfPoints) const
+{
+  this->AccumulateScalarKernelContributions(points, results, numberOfPoints, [](const TParametersValueType r) {
+    return (r > 1e-8) ? r * r * std::log(r) : NumericTraits<TParametersValueType>::ZeroValue();
+  });
 }
 } // namespace itk
 #endif
@@ -18,7 +18,9 @@
 #ifndef itkTransform_h
 #define itkTransform_h
 
+#include <numeric>     // For std::iota
 #include <type_traits> // For std::enable_if
+#include <vector>
 #include "itkTransformBase.h"
 #include "itkVector.h"
 #include "itkSymmetricSecondRankTensor.h"
@@ -194,6 +196,27 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /**  Method to transform a batch of points.
+   * Sets outputPoints[i] to the transform of inputPoints[i], for each of the
+   * numberOfPoints points. The input and output arrays may be the same array.
+   *
+   * The default implementation calls TransformPoint() for each point.
+   * Transforms whose evaluation at neighboring points shares intermediate
+   * results (e.g. the interpolation weights of a B-spline transform along a
+   * scan line) may override it.
+   * \warning This method must be thread-safe, like TransformPoint().
+   */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+    }
+  }
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -529,6 +552,41 @@ public:
     this->ComputeJacobianWithRespectToParameters(p, jacobian);
   }
 
+  /** Type of the parameter indices of the columns of a sparse jacobian. */
+  using NonZeroJacobianIndicesType = std::vector<NumberOfParametersType>;
+
+  /** Return the number of columns of the jacobian computed by
+   * ComputeSparseJacobianWithRespectToParameters(). This is an upper bound
+   * of the number of parameters that affect the transform at any point.
+   * The default returns GetNumberOfLocalParameters(). */
+  virtual NumberOfParametersType
+  GetNumberOfNonZeroJacobianIndices() const
+  {
+    return this->GetNumberOfLocalParameters();
+  }
+
+  /** Compute the jacobian with respect to the parameters, restricted to the
+   * parameters that may affect the transform at point \c p.
+   *
+   * On return, column \c j of \c jacobian is the derivative of the transformed
+   * point with respect to parameter \c nonZeroJacobianIndices[j]. Both
+   * \c jacobian and \c nonZeroJacobianIndices must already be sized to
+   * GetNumberOfNonZeroJacobianIndices() columns. For transforms with a small
+   * local support, such as BSplineTransform, this avoids computing and
+   * traversing a jacobian that has one column per parameter of the transform.
+   *
+   * The default implementation computes the full jacobian with
+   * ComputeJacobianWithRespectToParameters(), with the identity mapping of
+   * the columns to the parameters. */
+  virtual void
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &       p,
+                                               JacobianType &               jacobian,
+                                               NonZeroJacobianIndicesType & nonZeroJacobianIndices) const
+  {
+    this->ComputeJacobianWithRespectToParameters(p, jacobian);
+    std::iota(nonZeroJacobianIndices.begin(), nonZeroJacobianIndices.end(), NumberOfParametersType{ 0 });
+  }
+
 
   /** This provides the ability to get a local jacobian value
    *  in a dense/local transform, e.g. DisplacementFieldTransform. For such
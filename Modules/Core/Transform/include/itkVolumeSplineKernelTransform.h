@@ -95,6 +95,12 @@ protected:
    *  function to the global deformation of the space  */
   void
   ComputeDeformationContribution(const InputPointType & thisPoint, OutputPointType & result) const override;
+
+  /** Compute the contributions of the landmarks at a batch of points. */
+  void
+  ComputeDeformationContributions(const InputPointType * points,
+                                  OutputPointType *      results,
+                                  SizeValueType          numberOfPoints) const override;
 };
 } // namespace itk
 
@@ -41,22 +41,19 @@ VolumeSplineKernelTransform<TParametersValueType, VDimension>::ComputeDeformatio
   const InputPointType & thisPoint,
   OutputPointType &      result) const
 {
-  unsigned long numberOfLandmarks = this->m_SourceLandmarks->GetNumberOfPoints();
-
-  PointsIterator sp = this->m_SourceLandmarks->GetPoints()->Begin();
-
-  for (unsigned int lnd = 0; lnd < numberOfLandmarks; ++lnd)
-  {
-    InputVectorType            position = thisPoint - sp->Value();
-    const TParametersValueType r = position.GetNorm();
-    const TParametersValueType r3 = r * r * r;
+  this->ComputeDeformationContributions(&thisPoint, &result, 1);
+}
 
-    for (unsigned int odim = 0; odim < VDimension; ++odim)
-    {
-      result[odim] += r3 * this->m_DMatrix(odim, lnd);
-    }
-    ++sp;
-  }
+template <typename TParametersValueType, unsigned int VDimension>
+void
+VolumeSplineKernelTransform<TParametersValueType, VDimension>::ComputeDeformationContributions(
+  const InputPointType * points,
+  OutputPointType *      results,
+  SizeValueType          numberOfPoints) const
+{
+  this->AccumulateScalarKernelContributions(points, results, numberOfPoints, [](const TParametersValueType r) {
+    return r * r * r;
+  });
 }
 } // namespace itk
 #endif
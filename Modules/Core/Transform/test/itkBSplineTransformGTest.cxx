@@ -22,6 +22,9 @@
 
 #include "itkImageRegionConstIterator.h"
 
+#include <random>
+#include <vector>
+
 namespace
 {
 
@@ -80,8 +83,74 @@ bspline_eq(const itk::BSplineTransform<TParametersValueType, VDimension, VSpline
   }
 }
 
+
+// Checks that TransformPoints gives exactly the points given by TransformPoint,
+// along scan lines parallel to the grid and along oblique lines, which run
+// partly outside of the valid region of the grid.
+template <typename TBSplineTransform>
+void
+Expect_TransformPoints_equals_TransformPoint()
+{
+  constexpr unsigned int Dimension = TBSplineTransform::SpaceDimension;
+  using PointType = typename TBSplineTransform::InputPointType;
+
+  auto bspline = TBSplineTransform::New();
+  bspline->SetTransformDomainOrigin(typename TBSplineTransform::OriginType(-10.0));
+  bspline->SetTransformDomainPhysicalDimensions(typename TBSplineTransform::PhysicalDimensionsType(20.0));
+  bspline->SetTransformDomainMeshSize(TBSplineTransform::MeshSizeType::Filled(5));
+
+  std::mt19937                           randomEngine;
+  std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+  typename TBSplineTransform::ParametersType parameters(bspline->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+  {
+    parameters[i] = distribution(randomEngine);
+  }
+  bspline->SetParametersByValue(parameters);
+
+  for (unsigned int line = 0; line < 2 * Dimension; ++line)
+  {
+    PointType start;
+    PointType step;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      start[d] = -12.0 + 2.0 * distribution(randomEngine);
+      step[d] = line < Dimension ? (d == line ? 0.7 : 0.0) : 0.3 * distribution(randomEngine);
+    }
+    start[line % Dimension] = -12.0;
+
+    std::vector<PointType> points(40);
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        points[i][d] = start[d] + i * step[d];
+      }
+    }
+
+    std::vector<PointType> transformedPoints(points.size());
+    bspline->TransformPoints(points.data(), transformedPoints.data(), points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      EXPECT_EQ(transformedPoints[i], bspline->TransformPoint(points[i])) << "at " << points[i];
+    }
+
+    // The input and output arrays may be the same
+    bspline->TransformPoints(points.data(), points.data(), points.size());
+    EXPECT_EQ(points, transformedPoints);
+  }
+}
+
 } // namespace
 
+TEST(ITKBSplineTransform, TransformPoints)
+{
+  Expect_TransformPoints_equals_TransformPoint<itk::BSplineTransform<double, 2, 3>>();
+  Expect_TransformPoints_equals_TransformPoint<itk::BSplineTransform<double, 3, 3>>();
+  Expect_TransformPoints_equals_TransformPoint<itk::BSplineTransform<float, 3, 2>>();
+  Expect_TransformPoints_equals_TransformPoint<itk::BSplineTransform<double, 2, 1>>();
+}
+
 TEST(ITKBSplineTransform, Construction)
 {
 
@@ -0,0 +1,279 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkCompositeTransform.h"
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkEuler3DTransform.h"
+#include "itkTranslationTransform.h"
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using CompositeTransformType = itk::CompositeTransform<double, Dimension>;
+using TransformType = CompositeTransformType::TransformType;
+using PointType = CompositeTransformType::InputPointType;
+
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+
+AffineTransformType::Pointer
+CreateAffineTransform(std::mt19937 & randomEngine)
+{
+  std::uniform_real_distribution<double> distribution(-0.2, 0.2);
+
+  auto                                  transform = AffineTransformType::New();
+  AffineTransformType::MatrixType       matrix;
+  AffineTransformType::OutputVectorType offset;
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      matrix[i][j] = (i == j ? 1.0 : 0.0) + distribution(randomEngine);
+    }
+    offset[i] = 10.0 * distribution(randomEngine);
+  }
+  transform->SetMatrix(matrix);
+  transform->SetOffset(offset);
+  return transform;
+}
+
+itk::BSplineTransform<double, Dimension, 3>::Pointer
+CreateBSplineTransform(std::mt19937 & randomEngine)
+{
+  using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+  auto transform = BSplineTransformType::New();
+  transform->SetTransformDomainOrigin(BSplineTransformType::OriginType(-20.0));
+  transform->SetTransformDomainPhysicalDimensions(BSplineTransformType::PhysicalDimensionsType(40.0));
+  transform->SetTransformDomainMeshSize(BSplineTransformType::MeshSizeType::Filled(4));
+
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+  BSplineTransformType::ParametersType   parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+  {
+    parameters[i] = distribution(randomEngine);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+void
+Expect_same_mapping(const TransformType & transform, const TransformType & expectedTransform)
+{
+  std::mt19937                           randomEngine;
+  std::uniform_real_distribution<double> distribution(-15.0, 15.0);
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = distribution(randomEngine);
+    }
+    const PointType mappedPoint = transform.TransformPoint(point);
+    const PointType expectedPoint = expectedTransform.TransformPoint(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      EXPECT_NEAR(mappedPoint[d], expectedPoint[d], 1e-9) << "at " << point;
+    }
+  }
+}
+
+
+// Checks that the sparse jacobian, scattered to the parameters given by its
+// non-zero indices, equals the dense jacobian, including for points outside
+// the domain of the B-spline transforms.
+void
+Expect_sparse_jacobian_equals_dense_jacobian(const TransformType & transform)
+{
+  const itk::SizeValueType numberOfLocalParameters = transform.GetNumberOfLocalParameters();
+  const itk::SizeValueType numberOfNonZeroJacobianIndices = transform.GetNumberOfNonZeroJacobianIndices();
+
+  TransformType::JacobianType               denseJacobian(Dimension, numberOfLocalParameters);
+  TransformType::JacobianType               sparseJacobian(Dimension, numberOfNonZeroJacobianIndices);
+  TransformType::NonZeroJacobianIndicesType nonZeroJacobianIndices(numberOfNonZeroJacobianIndices);
+
+  std::mt19937                           randomEngine;
+  std::uniform_real_distribution<double> distribution(-25.0, 25.0);
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    PointType point;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      point[d] = distribution(randomEngine);
+    }
+    transform.ComputeJacobianWithRespectToParameters(point, denseJacobian);
+    transform.ComputeSparseJacobianWithRespectToParameters(point, sparseJacobian, nonZeroJacobianIndices);
+
+    TransformType::JacobianType scatteredJacobian(Dimension, numberOfLocalParameters);
+    scatteredJacobian.Fill(0.0);
+    for (unsigned int j = 0; j < numberOfNonZeroJacobianIndices; ++j)
+    {
+      ASSERT_LT(nonZeroJacobianIndices[j], numberOfLocalParameters);
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        scatteredJacobian(d, nonZeroJacobianIndices[j]) += sparseJacobian(d, j);
+      }
+    }
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      for (unsigned int p = 0; p < numberOfLocalParameters; ++p)
+      {
+        EXPECT_NEAR(scatteredJacobian(d, p), denseJacobian(d, p), 1e-12) << "at " << point << ", parameter " << p;
+      }
+    }
+  }
+}
+} // namespace
+
+
+TEST(CompositeTransform, PrecomposedTransformFoldsRunsOfLinearTransforms)
+{
+  std::mt19937 randomEngine;
+
+  auto eulerTransform = itk::Euler3DTransform<double>::New();
+  eulerTransform->SetRotation(0.1, -0.2, 0.3);
+
+  auto translationTransform = itk::TranslationTransform<double, Dimension>::New();
+  translationTransform->Translate(itk::MakeVector(1.0, -2.0, 3.0));
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(eulerTransform);
+  composite->AddTransform(translationTransform);
+  composite->AddTransform(CreateBSplineTransform(randomEngine));
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+
+  const TransformType * precomposed = composite->GetPrecomposedTransform();
+  const auto *          precomposedComposite = dynamic_cast<const CompositeTransformType *>(precomposed);
+  ASSERT_NE(precomposedComposite, nullptr);
+  EXPECT_EQ(precomposedComposite->GetNumberOfTransforms(), 3u);
+  EXPECT_EQ(precomposedComposite->GetNthTransformConstPointer(1), composite->GetNthTransformConstPointer(3));
+  Expect_same_mapping(*precomposed, *composite);
+
+  // The precomposed transform is cached until a sub-transform is modified
+  EXPECT_EQ(composite->GetPrecomposedTransform(), precomposed);
+  translationTransform->Translate(itk::MakeVector(-1.0, 2.0, 0.5));
+  const TransformType * updatedPrecomposed = composite->GetPrecomposedTransform();
+  EXPECT_NE(updatedPrecomposed, precomposed);
+  Expect_same_mapping(*updatedPrecomposed, *composite);
+
+  // Euler3DTransform::SetRotation() does not modify the transform, but the
+  // precomposed transform follows its mapping
+  eulerTransform->SetRotation(-0.3, 0.2, 0.1);
+  EXPECT_EQ(composite->GetPrecomposedTransform(), updatedPrecomposed);
+  Expect_same_mapping(*composite->GetPrecomposedTransform(), *composite);
+}
+
+
+TEST(CompositeTransform, PrecomposedTransformOfLinearTransformsIsAffine)
+{
+  std::mt19937 randomEngine;
+
+  auto nestedComposite = CompositeTransformType::New();
+  nestedComposite->AddTransform(CreateAffineTransform(randomEngine));
+  nestedComposite->AddTransform(CreateAffineTransform(randomEngine));
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(nestedComposite);
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+
+  const TransformType * precomposed = composite->GetPrecomposedTransform();
+  EXPECT_NE(dynamic_cast<const AffineTransformType *>(precomposed), nullptr);
+  Expect_same_mapping(*precomposed, *composite);
+
+  // Modifying a transform of the nested composite transform updates the result
+  nestedComposite->GetNthTransform(0)->SetParameters(CreateAffineTransform(randomEngine)->GetParameters());
+  EXPECT_NE(composite->GetPrecomposedTransform(), precomposed);
+  Expect_same_mapping(*composite->GetPrecomposedTransform(), *composite);
+}
+
+
+TEST(CompositeTransform, PrecomposedTransformOfSingleTransformIsTheTransform)
+{
+  std::mt19937 randomEngine;
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(CreateBSplineTransform(randomEngine));
+  EXPECT_EQ(composite->GetPrecomposedTransform(), composite->GetNthTransformConstPointer(0));
+}
+
+
+TEST(CompositeTransform, TransformPointsEqualsTransformPoint)
+{
+  std::mt19937 randomEngine;
+
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(CreateBSplineTransform(randomEngine));
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+
+  std::vector<PointType> points(30);
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    points[i] = itk::MakePoint(-20.0 + 1.5 * i, 2.0 - 0.1 * i, 3.0);
+  }
+  std::vector<PointType> transformedPoints(points.size());
+  composite->TransformPoints(points.data(), transformedPoints.data(), points.size());
+  for (unsigned int i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(transformedPoints[i], composite->TransformPoint(points[i])) << "at " << points[i];
+  }
+}
+
+
+TEST(CompositeTransform, SparseJacobianEqualsDenseJacobian)
+{
+  std::mt19937 randomEngine;
+
+  const auto bsplineTransform = CreateBSplineTransform(randomEngine);
+  EXPECT_EQ(bsplineTransform->GetNumberOfNonZeroJacobianIndices(), 64u * Dimension);
+  Expect_sparse_jacobian_equals_dense_jacobian(*bsplineTransform);
+
+  // An affine transform has a dense jacobian
+  const auto affineTransform = CreateAffineTransform(randomEngine);
+  EXPECT_EQ(affineTransform->GetNumberOfNonZeroJacobianIndices(), affineTransform->GetNumberOfParameters());
+  Expect_sparse_jacobian_equals_dense_jacobian(*affineTransform);
+
+  // All the transforms are optimized. The B-spline transform is applied
+  // first, as its jacobian with respect to the position is not implemented.
+  auto composite = CompositeTransformType::New();
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(CreateAffineTransform(randomEngine));
+  composite->AddTransform(bsplineTransform);
+  EXPECT_EQ(composite->GetNumberOfNonZeroJacobianIndices(), 64u * Dimension + 24u);
+  Expect_sparse_jacobian_equals_dense_jacobian(*composite);
+
+  // Only the B-spline transform is optimized, between fixed affine transforms
+  auto bsplineOnlyComposite = CompositeTransformType::New();
+  bsplineOnlyComposite->AddTransform(CreateAffineTransform(randomEngine));
+  bsplineOnlyComposite->AddTransform(bsplineTransform);
+  bsplineOnlyComposite->AddTransform(CreateAffineTransform(randomEngine));
+  bsplineOnlyComposite->SetAllTransformsToOptimizeOff();
+  bsplineOnlyComposite->SetNthTransformToOptimizeOn(1);
+  EXPECT_EQ(bsplineOnlyComposite->GetNumberOfNonZeroJacobianIndices(), 64u * Dimension);
+  Expect_sparse_jacobian_equals_dense_jacobian(*bsplineOnlyComposite);
+}
@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkElasticBodySplineKernelTransform.h"
+#include "itkThinPlateR2LogRSplineKernelTransform.h"
+#include "itkThinPlateSplineKernelTransform.h"
+#include "itkVolumeSplineKernelTransform.h"
+
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+// Kernel transform which also solves the full linear system, of size
+// VDimension * (N + VDimension + 1), as a reference for the scalar one.
+template <typename TKernelTransform>
+class FullSystemKernelTransform : public TKernelTransform
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FullSystemKernelTransform);
+
+  using Self = FullSystemKernelTransform;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+
+  void
+  ComputeWMatrixOfFullSystem()
+  {
+    this->ComputeL();
+    this->ComputeY();
+    const vnl_svd<double> svd(this->m_LMatrix, 1e-8);
+    this->m_WMatrix = svd.solve(this->m_YMatrix);
+    this->ReorganizeW();
+  }
+
+protected:
+  FullSystemKernelTransform() = default;
+  ~FullSystemKernelTransform() override = default;
+};
+
+
+template <typename TKernelTransform>
+void
+SetRandomLandmarks(TKernelTransform * transform, const unsigned int numberOfLandmarks, const bool affineTarget)
+{
+  using PointType = typename TKernelTransform::InputPointType;
+  constexpr unsigned int Dimension = TKernelTransform::SpaceDimension;
+
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(1234);
+
+  auto source = TKernelTransform::PointSetType::New();
+  auto target = TKernelTransform::PointSetType::New();
+  for (unsigned int i = 0; i < numberOfLandmarks; ++i)
+  {
+    PointType sourcePoint;
+    PointType targetPoint;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      sourcePoint[d] = randomGenerator->GetUniformVariate(-10.0, 10.0);
+    }
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      targetPoint[d] = affineTarget ? 1.1 * sourcePoint[d] + 0.2 * sourcePoint[(d + 1) % Dimension] + d
+                                    : sourcePoint[d] + randomGenerator->GetUniformVariate(-1.0, 1.0);
+    }
+    source->SetPoint(i, sourcePoint);
+    target->SetPoint(i, targetPoint);
+  }
+  transform->SetSourceLandmarks(source);
+  transform->SetTargetLandmarks(target);
+}
+
+
+template <typename TKernelTransform>
+std::vector<typename TKernelTransform::InputPointType>
+CreateRandomPoints(const unsigned int numberOfPoints)
+{
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(5678);
+
+  std::vector<typename TKernelTransform::InputPointType> points(numberOfPoints);
+  for (auto & point : points)
+  {
+    for (unsigned int d = 0; d < TKernelTransform::SpaceDimension; ++d)
+    {
+      point[d] = randomGenerator->GetUniformVariate(-12.0, 12.0);
+    }
+  }
+  return points;
+}
+
+
+// Checks that the W matrix solved from the scalar system gives the same
+// transform as the one solved from the full system, that the landmarks are
+// interpolated, and that TransformPoints() gives the results of
+// TransformPoint(), including in place.
+template <typename TKernelTransform>
+void
+CheckKernelTransform(const double stiffness)
+{
+  using TransformType = FullSystemKernelTransform<TKernelTransform>;
+
+  const auto transform = TransformType::New();
+  const auto reference = TransformType::New();
+  for (const auto & t : { transform, reference })
+  {
+    SetRandomLandmarks(t.GetPointer(), 150, false);
+    t->SetStiffness(stiffness);
+  }
+  transform->ComputeWMatrix();
+  reference->ComputeWMatrixOfFullSystem();
+
+  constexpr unsigned int numberOfPoints = 150;
+  const auto             points = CreateRandomPoints<TKernelTransform>(numberOfPoints);
+  for (const auto & point : points)
+  {
+    const auto expected = reference->TransformPoint(point);
+    const auto actual = transform->TransformPoint(point);
+    for (unsigned int d = 0; d < TKernelTransform::SpaceDimension; ++d)
+    {
+      EXPECT_NEAR(actual[d], expected[d], 1e-8 * (1.0 + std::abs(expected[d])));
+    }
+  }
+
+  if (stiffness == 0.0)
+  {
+    const auto & sourcePoints = transform->GetSourceLandmarks()->GetPoints()->CastToSTLConstContainer();
+    const auto & targetPoints = transform->GetTargetLandmarks()->GetPoints()->CastToSTLConstContainer();
+    for (size_t i = 0; i < sourcePoints.size(); ++i)
+    {
+      const auto transformedPoint = transform->TransformPoint(sourcePoints[i]);
+      for (unsigned int d = 0; d < TKernelTransform::SpaceDimension; ++d)
+      {
+        EXPECT_NEAR(transformedPoint[d], targetPoints[i][d], 1e-6);
+      }
+    }
+  }
+
+  std::vector<typename TKernelTransform::OutputPointType> transformedPoints(numberOfPoints);
+  transform->TransformPoints(points.data(), transformedPoints.data(), numberOfPoints);
+  auto inPlacePoints = points;
+  transform->TransformPoints(inPlacePoints.data(), inPlacePoints.data(), numberOfPoints);
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    const auto expected = transform->TransformPoint(points[i]);
+    EXPECT_EQ(transformedPoints[i], expected);
+    EXPECT_EQ(inPlacePoints[i], expected);
+  }
+}
+} // namespace
+
+
+TEST(KernelTransform, ScalarSystemMatchesFullSystem)
+{
+  CheckKernelTransform<itk::ThinPlateSplineKernelTransform<double, 2>>(0.0);
+  CheckKernelTransform<itk::ThinPlateSplineKernelTransform<double, 3>>(0.0);
+  CheckKernelTransform<itk::ThinPlateSplineKernelTransform<double, 3>>(0.05);
+  CheckKernelTransform<itk::ThinPlateR2LogRSplineKernelTransform<double, 2>>(0.0);
+  CheckKernelTransform<itk::VolumeSplineKernelTransform<double, 3>>(0.0);
+  CheckKernelTransform<itk::ElasticBodySplineKernelTransform<double, 3>>(0.0);
+}
+
+
+// Tests that target landmarks which are an affine map of the source ones
+// give that affine map everywhere.
+TEST(KernelTransform, ReproducesAffineMap)
+{
+  using TransformType = itk::ThinPlateSplineKernelTransform<double, 3>;
+  const auto transform = TransformType::New();
+  SetRandomLandmarks(transform.GetPointer(), 60, true);
+  transform->ComputeWMatrix();
+
+  for (const auto & point : CreateRandomPoints<TransformType>(50))
+  {
+    const auto transformedPoint = transform->TransformPoint(point);
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+      EXPECT_NEAR(transformedPoint[d], 1.1 * point[d] + 0.2 * point[(d + 1) % 3] + d, 1e-8);
+    }
+  }
+}
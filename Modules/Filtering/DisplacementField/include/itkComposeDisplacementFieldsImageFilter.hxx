@@ -19,7 +19,7 @@
 #define itkComposeDisplacementFieldsImageFilter_hxx
 
 
-#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkDisplacementFieldCompositionUtilities.h"
 #include "itkImageRegionIterator.h"
 #include "itkVectorLinearInterpolateImageFunction.h"
 
@@ -74,44 +74,22 @@ template <typename InputImage, typename TOutputImage>
 void
 ComposeDisplacementFieldsImageFilter<InputImage, TOutputImage>::DynamicThreadedGenerateData(const RegionType & region)
 {
-  typename OutputFieldType::Pointer     output = this->GetOutput();
-  typename InputFieldType::ConstPointer warpingField = this->GetWarpingField();
-
-  ImageRegionConstIteratorWithIndex<InputFieldType> ItW(warpingField, region);
-  ImageRegionIterator<OutputFieldType>              ItF(output, region);
-
-  PointType pointIn1;
-  PointType pointIn2;
-  PointType pointIn3;
-
-  typename OutputFieldType::PixelType outDisplacement;
-
-  for (ItW.GoToBegin(), ItF.GoToBegin(); !ItW.IsAtEnd(); ++ItW, ++ItF)
-  {
-    warpingField->TransformIndexToPhysicalPoint(ItW.GetIndex(), pointIn1);
-
-    VectorType warpVector = ItW.Get();
-
-    for (unsigned int d = 0; d < ImageDimension; ++d)
-    {
-      pointIn2[d] = pointIn1[d] + warpVector[d];
-    }
-
-    typename InterpolatorType::OutputType displacement{};
-    if (this->m_Interpolator->IsInsideBuffer(pointIn2))
-    {
-      displacement = this->m_Interpolator->Evaluate(pointIn2);
-    }
-
-    for (unsigned int d = 0; d < ImageDimension; ++d)
-    {
-      pointIn3[d] = pointIn2[d] + displacement[d];
-    }
-
-    outDisplacement = pointIn3 - pointIn1;
-
-    ItF.Set(outDisplacement);
-  }
+  ImageRegionIterator<OutputFieldType> ItF(this->GetOutput(), region);
+
+  ComposeDisplacementFieldsOverRegion(
+    this->GetWarpingField(),
+    this->m_Interpolator.GetPointer(),
+    region,
+    [&ItF](const typename InputFieldType::PixelType &    warpVector,
+           const typename InterpolatorType::OutputType & displacement) {
+      VectorType outDisplacement;
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        outDisplacement[d] = static_cast<RealType>(warpVector[d] + displacement[d]);
+      }
+      ItF.Set(outDisplacement);
+      ++ItF;
+    });
 }
 
 template <typename InputImage, typename TOutputImage>
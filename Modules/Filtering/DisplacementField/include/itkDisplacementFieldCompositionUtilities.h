@@ -0,0 +1,81 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkDisplacementFieldCompositionUtilities_h
+#define itkDisplacementFieldCompositionUtilities_h
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace itk
+{
+/** \brief Compose a displacement field with a warping field over a region.
+ *
+ * For each pixel x of region, in the order of an
+ * ImageRegionConstIteratorWithIndex, function is called with the warping
+ * displacement w(x) and the displacement d(x + w(x)) of the field set as
+ * the input of interpolator, or a zero displacement when x + w(x) is
+ * outside of its buffer. w(x) + d(x + w(x)) is the displacement of the
+ * composed field.
+ *
+ * This is the loop shared by ComposeDisplacementFieldsImageFilter,
+ * InvertDisplacementFieldImageFilter and
+ * ExponentialDisplacementFieldImageFilter. It is safe to call from several
+ * threads over disjoint regions.
+ *
+ * \ingroup ITKDisplacementField
+ */
+template <typename TWarpingField, typename TInterpolator, typename TFunction>
+void
+ComposeDisplacementFieldsOverRegion(const TWarpingField *                     warpingField,
+                                    const TInterpolator *                     interpolator,
+                                    const typename TWarpingField::RegionType & region,
+                                    TFunction &&                              function)
+{
+  using ContinuousIndexType = typename TInterpolator::ContinuousIndexType;
+  using DisplacementType = typename TInterpolator::OutputType;
+
+  const auto * const displacementField = interpolator->GetInputImage();
+
+  typename TWarpingField::PointType point;
+  for (ImageRegionConstIteratorWithIndex<TWarpingField> it(warpingField, region); !it.IsAtEnd(); ++it)
+  {
+    const typename TWarpingField::PixelType warpVector = it.Get();
+
+    warpingField->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    for (unsigned int d = 0; d < TWarpingField::ImageDimension; ++d)
+    {
+      point[d] += warpVector[d];
+    }
+
+    // Map the point to the displacement field once, for both the bounds
+    // check and the interpolation
+    const ContinuousIndexType cidx =
+      displacementField->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(
+        point);
+
+    DisplacementType displacement{};
+    if (interpolator->IsInsideBuffer(cidx))
+    {
+      displacement = interpolator->EvaluateAtContinuousIndex(cidx);
+    }
+
+    function(warpVector, displacement);
+  }
+}
+} // end namespace itk
+
+#endif
@@ -214,6 +214,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /**  Method to transform a batch of points. Each point is mapped to the
+   * continuous index of the displacement field only once, which is used
+   * both to check the bounds and to interpolate the displacement. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
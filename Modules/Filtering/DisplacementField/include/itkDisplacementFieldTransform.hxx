@@ -100,6 +100,45 @@ DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoint(con
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int VDimension>
+void
+DisplacementFieldTransform<TParametersValueType, VDimension>::TransformPoints(const InputPointType * inputPoints,
+                                                                              OutputPointType *      outputPoints,
+                                                                              SizeValueType numberOfPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionMacro("No interpolator is specified.");
+  }
+
+  using ContinuousIndexValueType = typename InterpolatorType::ContinuousIndexType::ValueType;
+
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    typename InterpolatorType::PointType point;
+    point.CastFrom(inputPoints[i]);
+
+    OutputPointType outputPoint;
+    outputPoint.CastFrom(inputPoints[i]);
+
+    const typename InterpolatorType::ContinuousIndexType cidx =
+      this->m_DisplacementField->template TransformPhysicalPointToContinuousIndex<ContinuousIndexValueType>(point);
+    if (this->m_Interpolator->IsInsideBuffer(cidx))
+    {
+      typename InterpolatorType::OutputType displacement = this->m_Interpolator->EvaluateAtContinuousIndex(cidx);
+      for (unsigned int ii = 0; ii < VDimension; ++ii)
+      {
+        outputPoint[ii] += displacement[ii];
+      }
+    }
+    outputPoints[i] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int VDimension>
 bool
 DisplacementFieldTransform<TParametersValueType, VDimension>::GetInverse(Self * inverse) const
@@ -47,6 +47,10 @@ namespace itk
  *      exp(\Phi) = exp( \frac{\Phi}{2^N} )^{2^N}
  *    \f]
  *
+ * Each squaring warps the field by itself and adds the result to it in a
+ * single multithreaded pass, alternating between the output and one
+ * intermediate field, so that no field is allocated per iteration.
+ *
  *
  * This filter expects both the input and output images to be of pixel type
  * Vector.
@@ -164,8 +168,6 @@ private:
 
   DivideByConstantPointer m_Divider{};
   CasterPointer           m_Caster{};
-  VectorWarperPointer     m_Warper{};
-  AdderPointer            m_Adder{};
 };
 } // end namespace itk
 
@@ -19,7 +19,11 @@
 #define itkExponentialDisplacementFieldImageFilter_hxx
 
 #include "itkProgressReporter.h"
+#include "itkDisplacementFieldCompositionUtilities.h"
+#include "itkImageAlgorithm.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include <utility> // For swap.
 
 namespace itk
 {
@@ -34,13 +38,6 @@ ExponentialDisplacementFieldImageFilter<TInputImage, TOutputImage>::ExponentialD
   m_ComputeInverse = false;
   m_Divider = DivideByConstantType::New();
   m_Caster = CasterType::New();
-  m_Warper = VectorWarperType::New();
-
-  FieldInterpolatorPointer VectorInterpolator = FieldInterpolatorType::New();
-  m_Warper->SetInterpolator(VectorInterpolator);
-
-  m_Adder = AdderType::New();
-  m_Adder->InPlaceOn();
 }
 
 /**
@@ -176,41 +173,65 @@ ExponentialDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData
 
   progress.CompletedPixel();
 
-  // Do the iterative composition of the vector field
-  m_Warper->SetOutputOrigin(inputPtr->GetOrigin());
-  m_Warper->SetOutputSpacing(inputPtr->GetSpacing());
-  m_Warper->SetOutputDirection(inputPtr->GetDirection());
+  // Do the iterative composition of the vector field, each composition
+  // reading one of the fields and writing the other one
+  OutputImagePointer field = this->GetOutput();
+  auto               composedField = OutputImageType::New();
+  composedField->CopyInformation(field);
+  composedField->SetBufferedRegion(field->GetBufferedRegion());
+  composedField->SetRequestedRegion(field->GetBufferedRegion());
+  composedField->Allocate();
+
+  auto fieldInterpolator = FieldInterpolatorType::New();
 
   for (unsigned int i = 0; i < numiter; ++i)
   {
-    m_Warper->SetInput(this->GetOutput());
-    m_Warper->SetDisplacementField(this->GetOutput());
-
-    m_Warper->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
-
-    m_Warper->Update();
-
-    OutputImagePointer warpedIm = m_Warper->GetOutput();
-    warpedIm->DisconnectPipeline();
-
-    // Remember we chose to use an inplace adder
-    m_Adder->SetInput1(this->GetOutput());
-
-    m_Adder->SetInput2(warpedIm);
-    m_Adder->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
-
-    m_Adder->Update();
-
-    // Region passing stuff
-    this->GraftOutput(m_Adder->GetOutput());
-
-    // Make a call to modified. This seems only necessary for
-    // a non-inplace adder but it doesn't hurt anyhow.
-    this->GetOutput()->Modified();
+    fieldInterpolator->SetInputImage(field);
+
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      field->GetBufferedRegion(),
+      [&field, &fieldInterpolator, &composedField](const typename OutputImageType::RegionType & region) {
+        // Warp the field by itself, as WarpVectorImageFilter does with a
+        // zero edge padding value, and add the warped field to it
+        ImageRegionIterator<OutputImageType> composedIt(composedField, region);
+        ComposeDisplacementFieldsOverRegion(
+          field.GetPointer(),
+          fieldInterpolator.GetPointer(),
+          region,
+          [&composedIt](const OutputPixelType &             displacement,
+                        const FieldInterpolatorOutputType & interpolatedValue) {
+            OutputPixelType warpedDisplacement;
+            for (unsigned int k = 0; k < OutputPixelDimension; ++k)
+            {
+              warpedDisplacement[k] = static_cast<typename OutputPixelType::ValueType>(interpolatedValue[k]);
+            }
+            composedIt.Set(displacement + warpedDisplacement);
+            ++composedIt;
+          });
+      },
+      nullptr);
+
+    std::swap(field, composedField);
 
     progress.CompletedPixel();
   }
+
+  // The last composition was written to the intermediate field when the
+  // number of iterations is odd
+  if (field != this->GetOutput())
+  {
+    ImageAlgorithm::Copy(field.GetPointer(),
+                         this->GetOutput(),
+                         this->GetOutput()->GetBufferedRegion(),
+                         this->GetOutput()->GetBufferedRegion());
+  }
+
+  // Make a call to modified, as the output buffer has been written to
+  // directly.
+  this->GetOutput()->Modified();
 }
+
 } // end namespace itk
 
 #endif
@@ -59,6 +59,7 @@ namespace itk
  * Vector.
  *
  * \ingroup ImageToImageFilter
+ * \ingroup MultiThreaded
  * \ingroup ITKDisplacementField
  */
 template <typename TInputImage, typename TOutputImage>
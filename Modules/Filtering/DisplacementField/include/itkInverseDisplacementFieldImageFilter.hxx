@@ -19,11 +19,13 @@
 #define itkInverseDisplacementFieldImageFilter_hxx
 
 #include "itkObjectFactory.h"
-#include "itkProgressReporter.h"
+#include "itkImageScanlineIterator.h"
 #include "itkThinPlateSplineKernelTransform.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkResampleImageFilter.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -213,43 +215,42 @@ InverseDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
-  // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
-
-  OutputImageRegionType region = outputPtr->GetRequestedRegion();
-
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  IndexType outputIndex; // Index to current output pixel
-
   using InputPointType = typename KernelTransformType::InputPointType;
   using OutputPointType = typename KernelTransformType::OutputPointType;
 
-  InputPointType outputPoint; // Coordinates of current output pixel
-
-  // Support for progress methods/callbacks
-  ProgressReporter progress(this, 0, region.GetNumberOfPixels(), 10);
-
-  // Walk the output region
-  for (OutputIterator outIt(outputPtr, region); !outIt.IsAtEnd(); ++outIt)
-  {
-    // Determine the index of the current output pixel
-    outputIndex = outIt.GetIndex();
-    outputPtr->TransformIndexToPhysicalPoint(outputIndex, outputPoint);
-
-    // Compute corresponding inverse displacement vector
-    OutputPointType interpolation = m_KernelTransform->TransformPoint(outputPoint);
-
-    OutputPixelType inverseDisplacement;
-
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      inverseDisplacement[i] = interpolation[i] - outputPoint[i];
-    }
-
-    outIt.Set(inverseDisplacement); // set inverse displacement.
-    progress.CompletedPixel();
-  }
+  // The scan lines are split between the work units, and the points of each
+  // of them are mapped by a single call to the kernel transform.
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    outputPtr->GetRequestedRegion(),
+    [this, outputPtr](const OutputImageRegionType & outputRegionForThread) {
+      const SizeValueType          lineLength = outputRegionForThread.GetSize(0);
+      std::vector<InputPointType>  outputPoints(lineLength);
+      std::vector<OutputPointType> transformedPoints(lineLength);
+
+      for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
+      {
+        // Determine the coordinates of the output pixels of the scan line
+        IndexType index = outIt.GetIndex();
+        for (SizeValueType x = 0; x < lineLength; ++x, ++index[0])
+        {
+          outputPtr->TransformIndexToPhysicalPoint(index, outputPoints[x]);
+        }
+
+        // Compute corresponding inverse displacement vectors
+        m_KernelTransform->TransformPoints(outputPoints.data(), transformedPoints.data(), lineLength);
+
+        for (SizeValueType x = 0; x < lineLength; ++x, ++outIt)
+        {
+          OutputPixelType inverseDisplacement;
+          for (unsigned int i = 0; i < ImageDimension; ++i)
+          {
+            inverseDisplacement[i] = transformedPoints[x][i] - outputPoints[x][i];
+          }
+          outIt.Set(inverseDisplacement);
+        }
+      }
+    },
+    this);
 }
 
 /**
@@ -19,7 +19,7 @@
 #define itkInvertDisplacementFieldImageFilter_hxx
 
 
-#include "itkComposeDisplacementFieldsImageFilter.h"
+#include "itkDisplacementFieldCompositionUtilities.h"
 #include "itkImageDuplicator.h"
 #include "itkImageRegionIterator.h"
 #include <mutex>
@@ -98,6 +98,12 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     this->m_DisplacementFieldSpacing[d] = displacementField->GetSpacing()[d];
   }
 
+  // The composed field is written in place at each iteration
+  this->m_Interpolator->SetInputImage(displacementField);
+  this->m_ComposedField->CopyInformation(displacementField);
+  this->m_ComposedField->SetRegions(displacementField->GetLargestPossibleRegion());
+  this->m_ComposedField->Allocate();
+
   this->m_ScaledNormImage->CopyInformation(displacementField);
   this->m_ScaledNormImage->SetRegions(displacementField->GetRequestedRegion());
   this->m_ScaledNormImage->Allocate(true); // initialize buffer to zero
@@ -115,16 +121,9 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::GenerateData()
     itkDebugMacro("Iteration " << iteration << ": mean error norm = " << this->m_MeanErrorNorm
                                << ", max error norm = " << this->m_MaxErrorNorm);
 
-    using ComposerType = ComposeDisplacementFieldsImageFilter<DisplacementFieldType>;
-    auto composer = ComposerType::New();
-    composer->SetDisplacementField(displacementField);
-    composer->SetWarpingField(inverseDisplacementField);
-
-    this->m_ComposedField = composer->GetOutput();
-    this->m_ComposedField->Update();
-    this->m_ComposedField->DisconnectPipeline();
-
-    // Multithread processing to multiply each element of the composed field by 1 / spacing
+    // Multithread processing to compose the displacement field with the
+    // inverse field estimate, and multiply each element of the composed
+    // field by 1 / spacing
     this->m_MeanErrorNorm = NumericTraits<RealType>::ZeroValue();
     this->m_MaxErrorNorm = NumericTraits<RealType>::ZeroValue();
 
@@ -214,25 +213,33 @@ InvertDisplacementFieldImageFilter<TInputImage, TOutputImage>::DynamicThreadedGe
     {
       inverseSpacing[d] = 1.0 / this->m_DisplacementFieldSpacing[d];
     }
-    for (ItE.GoToBegin(), ItS.GoToBegin(); !ItE.IsAtEnd(); ++ItE, ++ItS)
-    {
-      const VectorType & displacement = ItE.Get();
-      RealType           scaledNorm = 0.0;
-      for (unsigned int d = 0; d < ImageDimension; ++d)
-      {
-        scaledNorm += itk::Math::sqr(displacement[d] * inverseSpacing[d]);
-      }
-      scaledNorm = std::sqrt(scaledNorm);
+    // Compose the displacement field with the inverse field estimate, as
+    // ComposeDisplacementFieldsImageFilter does
+    ComposeDisplacementFieldsOverRegion(
+      this->GetOutput(),
+      this->m_Interpolator.GetPointer(),
+      region,
+      [&](const VectorType & warpVector, const typename InterpolatorType::OutputType & warpedDisplacement) {
+        VectorType displacement;
+        RealType   scaledNorm = 0.0;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          displacement[d] = static_cast<RealType>(warpVector[d] + warpedDisplacement[d]);
+          scaledNorm += itk::Math::sqr(displacement[d] * inverseSpacing[d]);
+        }
+        scaledNorm = std::sqrt(scaledNorm);
 
-      localMean += scaledNorm;
-      if (localMax < scaledNorm)
-      {
-        localMax = scaledNorm;
-      }
+        localMean += scaledNorm;
+        if (localMax < scaledNorm)
+        {
+          localMax = scaledNorm;
+        }
 
-      ItS.Set(scaledNorm);
-      ItE.Set(-displacement);
-    }
+        ItS.Set(scaledNorm);
+        ItE.Set(-displacement);
+        ++ItS;
+        ++ItE;
+      });
     {
       const std::lock_guard<std::mutex> lockGuard(m_Mutex);
       this->m_MeanErrorNorm += localMean;
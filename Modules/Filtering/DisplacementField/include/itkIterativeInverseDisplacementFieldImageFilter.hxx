@@ -18,7 +18,6 @@
 #ifndef itkIterativeInverseDisplacementFieldImageFilter_hxx
 #define itkIterativeInverseDisplacementFieldImageFilter_hxx
 
-#include "itkProgressReporter.h"
 #include "itkMath.h"
 
 namespace itk
@@ -94,144 +93,119 @@ IterativeInverseDisplacementFieldImageFilter<TInputImage, TOutputImage>::Generat
   }
   else
   {
-    // calculate the inverted field
-    InputImagePointType         mappedPoint, newPoint;
-    OutputImagePointType        originalPoint;
-    OutputImageIndexType        index;
-    OutputImagePixelType        displacement, outputValue;
-    FieldInterpolatorOutputType forwardVector;
-    double                      spacing = inputPtr->GetSpacing()[0];
-    double                      smallestError = 0;
-    int                         stillSamePoint;
-    InputImageRegionType        region = inputPtr->GetLargestPossibleRegion();
-    unsigned int                numberOfPoints = 1;
-    for (unsigned int i = 0; i < ImageDimension; ++i)
-    {
-      numberOfPoints *= region.GetSize()[i];
-    }
-
-    ProgressReporter         progress(this, 0, inputPtr->GetLargestPossibleRegion().GetNumberOfPixels());
-    OutputIterator           OutputIt(outputPtr, outputPtr->GetRequestedRegion());
+    // calculate the inverted field, each pixel being searched for
+    // independently of the others
+    const double             spacing = inputPtr->GetSpacing()[0];
     FieldInterpolatorPointer inputFieldInterpolator = FieldInterpolatorType::New();
     inputFieldInterpolator->SetInputImage(inputPtr);
 
-    InputIt.GoToBegin();
-    OutputIt.GoToBegin();
-    while (!OutputIt.IsAtEnd())
-    {
-      // get the output image index
-      index = OutputIt.GetIndex();
-      outputPtr->TransformIndexToPhysicalPoint(index, originalPoint);
-
-      stillSamePoint = 0;
-      double step = spacing;
-
-      // get the required displacement
-      displacement = OutputIt.Get();
-
-      // compute the required input image point
-      for (unsigned int j = 0; j < ImageDimension; ++j)
+    // Distance between the original point and the point mapped back by the
+    // input field, or false when the mapped point is outside of the field
+    const auto computeError = [&inputFieldInterpolator, &inputPtr](const InputImagePointType &  mappedPoint,
+                                                                   const OutputImagePointType & originalPoint,
+                                                                   double &                     error) -> bool {
+      const auto cindex = inputPtr->template TransformPhysicalPointToContinuousIndex<double>(mappedPoint);
+      if (!inputFieldInterpolator->IsInsideBuffer(cindex))
       {
-        mappedPoint[j] = originalPoint[j] + displacement[j];
-        newPoint[j] = mappedPoint[j];
+        return false;
       }
+      const FieldInterpolatorOutputType forwardVector = inputFieldInterpolator->EvaluateAtContinuousIndex(cindex);
 
-      // calculate the error of the last iteration
-      if (inputFieldInterpolator->IsInsideBuffer(mappedPoint))
+      error = 0;
+      for (unsigned int l = 0; l < ImageDimension; ++l)
       {
-        forwardVector = inputFieldInterpolator->Evaluate(mappedPoint);
-
-        smallestError = 0;
-        for (unsigned int j = 0; j < ImageDimension; ++j)
-        {
-          smallestError += std::pow(mappedPoint[j] + forwardVector[j] - originalPoint[j], 2);
-        }
-        smallestError = std::sqrt(smallestError);
+        error += itk::Math::sqr(mappedPoint[l] + forwardVector[l] - originalPoint[l]);
       }
+      error = std::sqrt(error);
+      return true;
+    };
+
+    this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    this->GetMultiThreader()->template ParallelizeImageRegion<InputImageType::ImageDimension>(
+      outputPtr->GetRequestedRegion(),
+      [this, &outputPtr, &computeError, spacing](const InputImageRegionType & region) {
+        InputImagePointType  mappedPoint;
+        InputImagePointType  newPoint;
+        OutputImagePointType originalPoint;
+        OutputImagePixelType outputValue;
+
+        for (OutputIterator OutputIt(outputPtr, region); !OutputIt.IsAtEnd(); ++OutputIt)
+        {
+          // get the output image index
+          outputPtr->TransformIndexToPhysicalPoint(OutputIt.GetIndex(), originalPoint);
 
-      // iteration loop
-      for (unsigned int i = 0; i < m_NumberOfIterations; ++i)
-      {
-        double tmp;
+          bool   stillSamePoint = false;
+          double step = spacing;
 
-        if (stillSamePoint)
-        {
-          step = step / 2;
-        }
+          // get the required displacement
+          const OutputImagePixelType displacement = OutputIt.Get();
 
-        for (unsigned int k = 0; k < ImageDimension; ++k)
-        {
-          mappedPoint[k] += step;
-          if (inputFieldInterpolator->IsInsideBuffer(mappedPoint))
+          // compute the required input image point
+          for (unsigned int j = 0; j < ImageDimension; ++j)
+          {
+            mappedPoint[j] = originalPoint[j] + displacement[j];
+            newPoint[j] = mappedPoint[j];
+          }
+
+          // calculate the error of the last iteration, any point inside of
+          // the field improving on a first guess outside of it
+          double smallestError = NumericTraits<double>::max();
+          computeError(mappedPoint, originalPoint, smallestError);
+
+          // iteration loop
+          for (unsigned int i = 0; i < m_NumberOfIterations; ++i)
           {
-            forwardVector = inputFieldInterpolator->Evaluate(mappedPoint);
-            tmp = 0;
-            for (unsigned int l = 0; l < ImageDimension; ++l)
+            double tmp;
+
+            if (stillSamePoint)
             {
-              tmp += std::pow(mappedPoint[l] + forwardVector[l] - originalPoint[l], 2);
+              step = step / 2;
             }
-            tmp = std::sqrt(tmp);
-            if (tmp < smallestError)
+
+            for (unsigned int k = 0; k < ImageDimension; ++k)
             {
-              smallestError = tmp;
-              for (unsigned int l = 0; l < ImageDimension; ++l)
+              mappedPoint[k] += step;
+              if (computeError(mappedPoint, originalPoint, tmp) && tmp < smallestError)
               {
-                newPoint[l] = mappedPoint[l];
+                smallestError = tmp;
+                newPoint = mappedPoint;
               }
-            }
-          }
 
-          mappedPoint[k] -= 2 * step;
-          if (inputFieldInterpolator->IsInsideBuffer(mappedPoint))
-          {
-            forwardVector = inputFieldInterpolator->Evaluate(mappedPoint);
-            tmp = 0;
-            for (unsigned int l = 0; l < ImageDimension; ++l)
-            {
-              tmp += std::pow(mappedPoint[l] + forwardVector[l] - originalPoint[l], 2);
-            }
-            tmp = std::sqrt(tmp);
-            if (tmp < smallestError)
+              mappedPoint[k] -= 2 * step;
+              if (computeError(mappedPoint, originalPoint, tmp) && tmp < smallestError)
+              {
+                smallestError = tmp;
+                newPoint = mappedPoint;
+              }
+
+              mappedPoint[k] += step;
+            } // end for loop over image dimension
+
+            stillSamePoint = true;
+            for (unsigned int j = 0; j < ImageDimension; ++j)
             {
-              smallestError = tmp;
-              for (unsigned int l = 0; l < ImageDimension; ++l)
+              if (Math::NotExactlyEquals(newPoint[j], mappedPoint[j]))
               {
-                newPoint[l] = mappedPoint[l];
+                stillSamePoint = false;
               }
+              mappedPoint[j] = newPoint[j];
             }
-          }
 
-          mappedPoint[k] += step;
-        } // end for loop over image dimension
+            if (smallestError < m_StopValue)
+            {
+              break;
+            }
+          } // end iteration loop
 
-        stillSamePoint = 1;
-        for (unsigned int j = 0; j < ImageDimension; ++j)
-        {
-          if (Math::NotExactlyEquals(newPoint[j], mappedPoint[j]))
+          for (unsigned int k = 0; k < ImageDimension; ++k)
           {
-            stillSamePoint = 0;
+            outputValue[k] = static_cast<OutputImageValueType>(mappedPoint[k] - originalPoint[k]);
           }
-          mappedPoint[j] = newPoint[j];
-        }
 
-        if (smallestError < m_StopValue)
-        {
-          break;
+          OutputIt.Set(outputValue);
         }
-      } // end iteration loop
-
-      for (unsigned int k = 0; k < ImageDimension; ++k)
-      {
-        outputValue[k] = static_cast<OutputImageValueType>(mappedPoint[k] - originalPoint[k]);
-      }
-
-      OutputIt.Set(outputValue);
-
-      ++InputIt;
-      ++OutputIt;
-
-      progress.CompletedPixel();
-    } // end while loop
+      },
+      this);
   }   // end else
 
   time.Stop();
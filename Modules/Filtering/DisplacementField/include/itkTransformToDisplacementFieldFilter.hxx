@@ -24,6 +24,8 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -177,28 +179,36 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   OutputImageType *     output = this->GetOutput();
   const TransformType * transform = this->GetInput()->Get();
 
-  // Define a few variables that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;       // Coordinates of output pixel
-  PointType transformedPoint;  // Coordinates of transformed pixel
-  PixelType displacementPixel; // the difference, cast to pixel type
-
-
   TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
 
+  // The points of a scan line are mapped by a single call to the transform,
+  // which may share its intermediate results between the points.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+
   // Walk the output region for this thread.
   for (ImageScanlineIterator outIt(output, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    while (!outIt.IsAtEndOfLine())
+    // Determine the coordinates of the output pixels of the scan line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType x = 0; x < lineLength; ++x, ++index[0])
     {
-      // Determine the index of the current output pixel
-      output->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+      PointType outputPoint; // Coordinates of output pixel
+      output->TransformIndexToPhysicalPoint(index, outputPoint);
+      outputPoints[x] = outputPoint;
+    }
 
-      // Compute corresponding input pixel position
-      transformedPoint = transform->TransformPoint(outputPoint);
+    // Compute corresponding input pixel positions
+    transform->TransformPoints(outputPoints.data(), transformedPoints.data(), lineLength);
 
+    for (SizeValueType x = 0; x < lineLength; ++x)
+    {
+      const PointType                      outputPoint = outputPoints[x];
+      const PointType                      transformedPoint = transformedPoints[x];
       const typename PointType::VectorType displacementVector = transformedPoint - outputPoint;
       // Cast PointType -> PixelType
+      PixelType displacementPixel;
       for (IndexValueType idx = 0; idx < ImageDimension; ++idx)
       {
         displacementPixel[idx] = static_cast<typename PixelType::ValueType>(displacementVector[idx]);
@@ -206,7 +216,7 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
       outIt.Set(displacementPixel);
       ++outIt;
     }
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(lineLength);
   }
 }
 
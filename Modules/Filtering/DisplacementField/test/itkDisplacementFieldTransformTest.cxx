@@ -431,6 +431,25 @@ itkDisplacementFieldTransformTest(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
+  // Test transforming a batch of points, along a line which leaves the field
+  DisplacementTransformType::InputPointType  batchInputPoints[8];
+  DisplacementTransformType::OutputPointType batchOutputPoints[8];
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    batchInputPoints[i][0] = testPoint[0] + 1.7 * i;
+    batchInputPoints[i][1] = testPoint[1] - 0.6 * i;
+  }
+  displacementTransform->TransformPoints(batchInputPoints, batchOutputPoints, 8);
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    if (batchOutputPoints[i] != displacementTransform->TransformPoint(batchInputPoints[i]))
+    {
+      std::cout << "Error transforming points: TransformPoints(...)" << std::endl;
+      std::cout << "Test failed!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   DisplacementTransformType::InputVectorType  testVector;
   DisplacementTransformType::OutputVectorType deformVector, deformVectorTruth;
   testVector[0] = 0.5;
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAddImageFilter.h"
+#include "itkDivideImageFilter.h"
+#include "itkExponentialDisplacementFieldImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVectorLinearInterpolateNearestNeighborExtrapolateImageFunction.h"
+#include "itkWarpVectorImageFilter.h"
+
+#include <cmath>
+
+/*
+ * Compare the exponential of a smooth displacement field, and of its
+ * opposite, with the one computed by the pipeline the filter used to run:
+ * a division by 2^N followed by N compositions of the field with itself,
+ * each warping it with WarpVectorImageFilter and adding the warped field to
+ * it. Both an odd and an even number of iterations are used, as the filter
+ * alternates between two buffers, with different numbers of work units.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using VectorType = itk::Vector<double, Dimension>;
+using FieldType = itk::Image<VectorType, Dimension>;
+
+FieldType::Pointer
+ComputeReferenceExponential(const FieldType * field, const unsigned int numberOfIterations, const bool computeInverse)
+{
+  using DividerType = itk::DivideImageFilter<FieldType, itk::Image<double, Dimension>, FieldType>;
+  auto divider = DividerType::New();
+  divider->SetInput(field);
+  const double divisor = static_cast<double>(1 << numberOfIterations);
+  divider->SetConstant2(computeInverse ? -divisor : divisor);
+  divider->Update();
+
+  FieldType::Pointer exponential = divider->GetOutput();
+  for (unsigned int i = 0; i < numberOfIterations; ++i)
+  {
+    using WarperType = itk::WarpVectorImageFilter<FieldType, FieldType, FieldType>;
+    auto warper = WarperType::New();
+    warper->SetInterpolator(
+      itk::VectorLinearInterpolateNearestNeighborExtrapolateImageFunction<FieldType, double>::New());
+    warper->SetOutputOrigin(exponential->GetOrigin());
+    warper->SetOutputSpacing(exponential->GetSpacing());
+    warper->SetOutputDirection(exponential->GetDirection());
+    warper->SetInput(exponential);
+    warper->SetDisplacementField(exponential);
+
+    using AdderType = itk::AddImageFilter<FieldType, FieldType, FieldType>;
+    auto adder = AdderType::New();
+    adder->SetInput1(exponential);
+    adder->SetInput2(warper->GetOutput());
+    adder->Update();
+
+    exponential = adder->GetOutput();
+    exponential->DisconnectPipeline();
+  }
+  return exponential;
+}
+} // namespace
+
+int
+itkExponentialDisplacementFieldImageFilterTest2(int, char *[])
+{
+  // A smooth field, large enough for the composition to move the points
+  // by several pixels, and out of the field near the border
+  auto                         field = FieldType::New();
+  const FieldType::RegionType  region({ { 3, -2 } }, { { 31, 27 } });
+  const FieldType::SpacingType spacing(itk::MakeVector(1.0, 0.8));
+  const FieldType::PointType   origin = itk::MakePoint(-4.0, 2.5);
+  field->SetRegions(region);
+  field->SetSpacing(spacing);
+  field->SetOrigin(origin);
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, region); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0];
+    const double y = it.GetIndex()[1];
+    it.Set(itk::MakeVector(3.0 * std::sin(0.2 * y) + 1.5, 2.5 * std::cos(0.15 * x) - 0.5 * std::sin(0.3 * y)));
+  }
+
+  using FilterType = itk::ExponentialDisplacementFieldImageFilter<FieldType, FieldType>;
+  auto filter = FilterType::New();
+  filter->SetInput(field);
+  filter->AutomaticNumberOfIterationsOff();
+
+  for (const unsigned int numberOfIterations : { 3, 4 })
+  {
+    filter->SetMaximumNumberOfIterations(numberOfIterations);
+    for (const bool computeInverse : { false, true })
+    {
+      filter->SetComputeInverse(computeInverse);
+      const auto expected = ComputeReferenceExponential(field, numberOfIterations, computeInverse);
+
+      for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+      {
+        filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+        ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+        for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(filter->GetOutput(), region); !it.IsAtEnd(); ++it)
+        {
+          const VectorType expectedValue = expected->GetPixel(it.GetIndex());
+          if ((it.Get() - expectedValue).GetNorm() > 1e-12 * (1.0 + expectedValue.GetNorm()))
+          {
+            std::cerr << "Test failed!" << std::endl;
+            std::cerr << "Error with " << numberOfIterations << " iterations, ComputeInverse " << computeInverse
+                      << " and " << numberOfWorkUnits << " work units at index " << it.GetIndex() << ": expected "
+                      << expectedValue << ", but got " << it.Get() << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkComposeDisplacementFieldsImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkInvertDisplacementFieldImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVectorNearestNeighborInterpolateImageFunction.h"
+
+#include <cmath>
+
+/*
+ * Verify that the interpolator set with SetInterpolator is the one used to
+ * compose the field with the inverse estimate: a nearest neighbor
+ * interpolator gives a different inverse than the default linear one, which
+ * composes with the field to the identity when the composition interpolates
+ * with nearest neighbors too, whatever the number of work units.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using VectorType = itk::Vector<double, Dimension>;
+using FieldType = itk::Image<VectorType, Dimension>;
+using InverterType = itk::InvertDisplacementFieldImageFilter<FieldType>;
+using NearestNeighborInterpolatorType = itk::VectorNearestNeighborInterpolateImageFunction<FieldType, double>;
+
+// Mean norm of a field over its interior, away from the boundary where the
+// inverse is forced to zero
+double
+ComputeMeanInteriorNorm(const FieldType * field)
+{
+  FieldType::RegionType interior = field->GetLargestPossibleRegion();
+  interior.ShrinkByRadius(8);
+
+  double norm = 0.0;
+  for (itk::ImageRegionConstIterator<FieldType> it(field, interior); !it.IsAtEnd(); ++it)
+  {
+    norm += it.Get().GetNorm();
+  }
+  return norm / interior.GetNumberOfPixels();
+}
+
+// Mean norm, over the interior of the field, of the composition of the
+// field with its inverse
+double
+ComputeMeanCompositionError(const FieldType *                field,
+                            const FieldType *                inverseField,
+                            InverterType::InterpolatorType * interpolator)
+{
+  using ComposerType = itk::ComposeDisplacementFieldsImageFilter<FieldType>;
+  auto composer = ComposerType::New();
+  composer->SetInterpolator(interpolator);
+  composer->SetDisplacementField(field);
+  composer->SetWarpingField(inverseField);
+  composer->Update();
+
+  return ComputeMeanInteriorNorm(composer->GetOutput());
+}
+} // namespace
+
+int
+itkInvertDisplacementFieldImageFilterTest2(int, char *[])
+{
+  // A smooth field, zero on the boundary
+  auto                       field = FieldType::New();
+  const FieldType::SizeType  size = { { 48, 40 } };
+  const FieldType::IndexType start = { { -5, 7 } };
+  field->SetRegions(FieldType::RegionType(start, size));
+  field->SetSpacing(itk::MakeVector(0.5, 0.7));
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, field->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double u = itk::Math::pi * (it.GetIndex()[0] - start[0]) / (size[0] - 1.0);
+    const double v = itk::Math::pi * (it.GetIndex()[1] - start[1]) / (size[1] - 1.0);
+    it.Set(itk::MakeVector(1.6 * std::sin(u) * std::sin(v), -1.2 * std::sin(2.0 * u) * std::sin(v)));
+  }
+
+  // The composition errors are compared with the displacements themselves
+  const double fieldNorm = ComputeMeanInteriorNorm(field);
+  std::cout << "Mean norm of the field: " << fieldNorm << std::endl;
+
+  auto inverter = InverterType::New();
+  inverter->SetInput(field);
+  inverter->SetMaximumNumberOfIterations(50);
+  inverter->SetMeanErrorToleranceThreshold(1e-4);
+  inverter->SetMaxErrorToleranceThreshold(1e-3);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(inverter->Update());
+  FieldType::Pointer linearInverse = inverter->GetOutput();
+  linearInverse->DisconnectPipeline();
+
+  const double linearError =
+    ComputeMeanCompositionError(field, linearInverse, InverterType::DefaultInterpolatorType::New());
+  std::cout << "Mean composition error with the linear interpolator: " << linearError << std::endl;
+  ITK_TEST_EXPECT_TRUE(linearError < 0.1 * fieldNorm);
+
+  auto interpolator = NearestNeighborInterpolatorType::New();
+  inverter->SetInterpolator(interpolator);
+  ITK_TEST_SET_GET_VALUE(interpolator, inverter->GetInterpolator());
+
+  FieldType::Pointer nearestNeighborInverse;
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+  {
+    inverter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(inverter->Update());
+
+    if (nearestNeighborInverse)
+    {
+      for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(inverter->GetOutput(),
+                                                                 field->GetLargestPossibleRegion());
+           !it.IsAtEnd();
+           ++it)
+      {
+        if (it.Get() != nearestNeighborInverse->GetPixel(it.GetIndex()))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Error in the inverse with " << numberOfWorkUnits << " work units at index " << it.GetIndex()
+                    << ": expected " << nearestNeighborInverse->GetPixel(it.GetIndex()) << ", but got " << it.Get()
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    else
+    {
+      nearestNeighborInverse = inverter->GetOutput();
+      nearestNeighborInverse->DisconnectPipeline();
+    }
+  }
+
+  // The nearest neighbor inverse differs from the linear one, and is an
+  // inverse for the nearest neighbor composition
+  double difference = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(linearInverse, field->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    difference = std::max(difference, (it.Get() - nearestNeighborInverse->GetPixel(it.GetIndex())).GetNorm());
+  }
+  std::cout << "Maximum difference between the linear and nearest neighbor inverses: " << difference << std::endl;
+  ITK_TEST_EXPECT_TRUE(difference > 0.01);
+
+  const double nearestNeighborError =
+    ComputeMeanCompositionError(field, nearestNeighborInverse, NearestNeighborInterpolatorType::New());
+  std::cout << "Mean composition error with the nearest neighbor interpolator: " << nearestNeighborError << std::endl;
+  ITK_TEST_EXPECT_TRUE(nearestNeighborError < 0.1 * fieldNorm);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
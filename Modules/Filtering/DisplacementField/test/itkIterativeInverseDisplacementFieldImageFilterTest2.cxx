@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkIterativeInverseDisplacementFieldImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkVectorLinearInterpolateImageFunction.h"
+
+#include <cmath>
+
+/*
+ * Invert a smooth displacement field with different numbers of work units,
+ * and verify that the results are identical, each pixel being inverted
+ * independently of the others, and that the field maps the points displaced
+ * by the inverse back to where they started, away from the boundary.
+ */
+
+int
+itkIterativeInverseDisplacementFieldImageFilterTest2(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+
+  using VectorType = itk::Vector<double, Dimension>;
+  using FieldType = itk::Image<VectorType, Dimension>;
+  using FilterType = itk::IterativeInverseDisplacementFieldImageFilter<FieldType, FieldType>;
+
+  auto                        field = FieldType::New();
+  const FieldType::SizeType   size = { { 40, 36 } };
+  const FieldType::IndexType  start = { { 4, -3 } };
+  const FieldType::RegionType region(start, size);
+  field->SetRegions(region);
+  field->SetSpacing(itk::MakeVector(1.0, 1.25));
+  field->SetOrigin(itk::MakePoint(2.0, -1.5));
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, region); !it.IsAtEnd(); ++it)
+  {
+    const double u = itk::Math::pi * (it.GetIndex()[0] - start[0]) / (size[0] - 1.0);
+    const double v = itk::Math::pi * (it.GetIndex()[1] - start[1]) / (size[1] - 1.0);
+    it.Set(itk::MakeVector(2.0 * std::sin(u) * std::sin(v), -1.5 * std::sin(u) * std::sin(2.0 * v)));
+  }
+
+  auto filter = FilterType::New();
+  filter->SetInput(field);
+  filter->SetNumberOfIterations(20);
+  filter->SetStopValue(0.0);
+
+  FieldType::Pointer serialInverse;
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 7 })
+  {
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->Modified();
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    if (!serialInverse)
+    {
+      serialInverse = filter->GetOutput();
+      serialInverse->DisconnectPipeline();
+      continue;
+    }
+
+    for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(filter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != serialInverse->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in the inverse with " << numberOfWorkUnits << " work units at index " << it.GetIndex()
+                  << ": expected " << serialInverse->GetPixel(it.GetIndex()) << ", but got " << it.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // x + inverse(x) is mapped back to x by the field
+  auto interpolator = itk::VectorLinearInterpolateImageFunction<FieldType, double>::New();
+  interpolator->SetInputImage(field);
+
+  FieldType::RegionType interior = region;
+  interior.ShrinkByRadius(6);
+
+  double maximumError = 0.0;
+  for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(serialInverse, interior); !it.IsAtEnd(); ++it)
+  {
+    FieldType::PointType point;
+    field->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const FieldType::PointType mappedPoint = point + it.Get();
+    ITK_TEST_EXPECT_TRUE(interpolator->IsInsideBuffer(mappedPoint));
+
+    const VectorType error = mappedPoint + interpolator->Evaluate(mappedPoint) - point;
+    maximumError = std::max(maximumError, error.GetNorm());
+  }
+  std::cout << "Maximum error of the inverse in the interior: " << maximumError << std::endl;
+  ITK_TEST_EXPECT_TRUE(maximumError < 0.05);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,226 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSeparableDistanceMapImageFilter_h
+#define itkSeparableDistanceMapImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/**
+ * \class SeparableDistanceMapImageFilter
+ *
+ *  \brief Computes the exact Euclidean distance transform of an image
+ *  with one parallel pass per dimension.
+ *
+ *  The squared distance to the nearest feature pixel is computed by
+ *  taking, dimension after dimension, the lower envelope of the parabolas
+ *  rooted at the samples of each image line. All the lines of a
+ *  dimension are independent, so every pass is split between the work
+ *  units, and the line buffers of a work unit are reused for all its
+ *  lines. The image spacing is taken into account directly in the
+ *  envelope computation.
+ *
+ *  \par Inputs and Outputs
+ *  The input pixels which are not equal to the background value are the
+ *  feature pixels. The first output is the distance of each pixel to the
+ *  nearest feature pixel, which is zero on the feature pixels. The
+ *  output pixel type must be a floating point type. Pixels from which no
+ *  feature pixel can be reached are set to the maximum value of the
+ *  output pixel type.
+ *
+ *  The second output is the nearest feature index map: the index of the
+ *  feature pixel found to be the nearest to each pixel. It is only
+ *  computed when ComputeNearestFeatureIndexMap is on, otherwise its
+ *  buffer is left empty.
+ *
+ *  \par Label images
+ *  When PerLabel is on, each distinct input value, including the
+ *  background value, is a label, and each pixel is given the distance to
+ *  the nearest pixel of a different label. This is the interior distance
+ *  map of all the labels, computed at once. The transform of each label
+ *  is restricted to its bounding box enlarged by one pixel, which
+ *  always contains the nearest pixel of another label, so the total cost
+ *  is the sum of the bounding box sizes instead of the number of labels
+ *  times the image size.
+ *
+ *  This mode only produces the unsigned interior distance of each label:
+ *  a pixel outside a label is not given its distance to that label, since
+ *  it would need one map per label. For the signed or exterior distance
+ *  map of a label, extract the label as a binary image and use
+ *  SignedMaurerDistanceMapImageFilter, or this filter with PerLabel off.
+ *
+ *  References:
+ *  P. F. Felzenszwalb and D. P. Huttenlocher, "Distance Transforms of
+ *  Sampled Functions", Theory of Computing, 8(19): 415-428, 2012.
+ *
+ *  A. Meijster, J. B. T. M. Roerdink and W. H. Hesselink, "A General
+ *  Algorithm for Computing Distance Transforms in Linear Time",
+ *  Mathematical Morphology and its Applications to Image and Signal
+ *  Processing, pp. 331-340, 2000.
+ *
+ * \sa SignedMaurerDistanceMapImageFilter
+ * \sa DanielssonDistanceMapImageFilter
+ *
+ * \ingroup ImageFeatureExtraction
+ * \ingroup ITKDistanceMap
+ */
+template <typename TInputImage, typename TOutputImage>
+class ITK_TEMPLATE_EXPORT SeparableDistanceMapImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SeparableDistanceMapImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = SeparableDistanceMapImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+  using DataObjectPointer = DataObject::Pointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkOverrideGetNameOfClassMacro(SeparableDistanceMapImageFilter);
+
+  /** Extract dimension from input and output image. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  /** Convenient type alias for simplifying declarations. */
+  using InputImageType = TInputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using RegionType = typename InputImageType::RegionType;
+  using IndexType = typename InputImageType::IndexType;
+  using SizeType = typename InputImageType::SizeType;
+
+  using OutputImageType = TOutputImage;
+  using OutputPixelType = typename OutputImageType::PixelType;
+
+  /** Type of the nearest feature index map. */
+  using IndexImageType = Image<IndexType, ImageDimension>;
+
+  /** Set/Get the background value which defines the feature pixels.
+   * Usually this value is = 0. */
+  itkSetMacro(BackgroundValue, InputPixelType);
+  itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
+
+  /** Set/Get if the distance should be squared. */
+  itkSetMacro(SquaredDistance, bool);
+  itkGetConstReferenceMacro(SquaredDistance, bool);
+  itkBooleanMacro(SquaredDistance);
+
+  /** Set/Get if image spacing should be used in computing distances. */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetConstReferenceMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Set/Get if the index of the nearest feature pixel is stored in the
+   * second output. Off by default. */
+  itkSetMacro(ComputeNearestFeatureIndexMap, bool);
+  itkGetConstReferenceMacro(ComputeNearestFeatureIndexMap, bool);
+  itkBooleanMacro(ComputeNearestFeatureIndexMap);
+
+  /** Set/Get if each distinct input value is a separate label, each
+   * pixel then being given the distance to the nearest pixel of another
+   * label. The result is unsigned, there is no exterior distance per
+   * label. Off by default. */
+  itkSetMacro(PerLabel, bool);
+  itkGetConstReferenceMacro(PerLabel, bool);
+  itkBooleanMacro(PerLabel);
+
+  /** Get the distance map. */
+  OutputImageType *
+  GetDistanceMap()
+  {
+    return this->GetOutput();
+  }
+
+  /** Get the nearest feature index map. */
+  IndexImageType *
+  GetNearestFeatureIndexMap();
+
+  using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
+  using Superclass::MakeOutput;
+  DataObjectPointer
+  MakeOutput(DataObjectPointerArraySizeType idx) override;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro(SameDimensionCheck,
+                  (Concept::SameDimension<TInputImage::ImageDimension, TOutputImage::ImageDimension>));
+  itkConceptMacro(InputHasNumericTraitsCheck, (Concept::HasNumericTraits<InputPixelType>));
+  itkConceptMacro(OutputImagePixelTypeIsFloatingPointCheck, (Concept::IsFloatingPoint<OutputPixelType>));
+  // End concept checking
+#endif
+
+protected:
+  SeparableDistanceMapImageFilter();
+  ~SeparableDistanceMapImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The whole input is needed to compute the distances. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** The whole output is produced. */
+  void
+  EnlargeOutputRequestedRegion(DataObject * output) override;
+
+  void
+  GenerateData() override;
+
+private:
+  /** Set the squared distance over region to zero on the feature pixels,
+   * those for which isFeature returns true, and to the maximum value
+   * elsewhere. distance and nearest (which may be null) must be buffered
+   * over region. */
+  template <typename TFeaturePredicate>
+  void
+  InitializeSquaredDistance(const RegionType & region,
+                            TFeaturePredicate  isFeature,
+                            OutputImageType *  distance,
+                            IndexImageType *   nearest);
+
+  /** Lower envelope pass along one dimension over region. */
+  void
+  ComputeSquaredDistanceAlongDimension(unsigned int       dimension,
+                                       const RegionType & region,
+                                       OutputImageType *  distance,
+                                       IndexImageType *   nearest,
+                                       ProcessObject *    progress);
+
+  void
+  GenerateDataForLabels();
+
+  InputPixelType m_BackgroundValue{};
+
+  bool m_SquaredDistance{ false };
+  bool m_UseImageSpacing{ true };
+  bool m_ComputeNearestFeatureIndexMap{ false };
+  bool m_PerLabel{ false };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSeparableDistanceMapImageFilter.hxx"
+#endif
+
+#endif
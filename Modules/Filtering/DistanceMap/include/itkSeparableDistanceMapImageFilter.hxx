@@ -0,0 +1,435 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSeparableDistanceMapImageFilter_hxx
+#define itkSeparableDistanceMapImageFilter_hxx
+
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkProgressTransformer.h"
+#include "itkMath.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::SeparableDistanceMapImageFilter()
+  : m_BackgroundValue(NumericTraits<InputPixelType>::ZeroValue())
+{
+  this->SetNumberOfRequiredOutputs(2);
+  this->SetNthOutput(1, this->MakeOutput(1));
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::MakeOutput(DataObjectPointerArraySizeType idx)
+  -> DataObjectPointer
+{
+  if (idx == 1)
+  {
+    return IndexImageType::New().GetPointer();
+  }
+  return Superclass::MakeOutput(idx);
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::GetNearestFeatureIndexMap() -> IndexImageType *
+{
+  return dynamic_cast<IndexImageType *>(this->ProcessObject::GetOutput(1));
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (this->GetInput())
+  {
+    auto * input = const_cast<InputImageType *>(this->GetInput());
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::EnlargeOutputRequestedRegion(DataObject * output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  OutputImageType * output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  IndexImageType * nearest = nullptr;
+  if (m_ComputeNearestFeatureIndexMap)
+  {
+    nearest = this->GetNearestFeatureIndexMap();
+    nearest->SetBufferedRegion(output->GetRequestedRegion());
+    nearest->Allocate();
+  }
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  const RegionType region = output->GetRequestedRegion();
+
+  if (m_PerLabel)
+  {
+    this->GenerateDataForLabels();
+  }
+  else
+  {
+    const InputPixelType background = m_BackgroundValue;
+    this->InitializeSquaredDistance(
+      region,
+      [background](const InputPixelType & value) { return Math::NotExactlyEquals(value, background); },
+      output,
+      nearest);
+
+    const auto numberOfPasses = static_cast<float>(ImageDimension + 1);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      ProgressTransformer progress(d / numberOfPasses, (d + 1) / numberOfPasses, this);
+      this->ComputeSquaredDistanceAlongDimension(d, region, output, nearest, progress.GetProcessObject());
+    }
+  }
+
+  if (!m_SquaredDistance)
+  {
+    // the unreachable pixels keep the maximum value
+    ProgressTransformer progress(ImageDimension / static_cast<float>(ImageDimension + 1), 1.0f, this);
+    multiThreader->template ParallelizeImageRegion<ImageDimension>(
+      region,
+      [output](const RegionType & subRegion) {
+        for (ImageRegionIterator<OutputImageType> it(output, subRegion); !it.IsAtEnd(); ++it)
+        {
+          const OutputPixelType value = it.Get();
+          if (Math::NotExactlyEquals(value, NumericTraits<OutputPixelType>::max()))
+          {
+            it.Set(static_cast<OutputPixelType>(std::sqrt(value)));
+          }
+        }
+      },
+      progress.GetProcessObject());
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateDataForLabels()
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+  IndexImageType *       nearest = m_ComputeNearestFeatureIndexMap ? this->GetNearestFeatureIndexMap() : nullptr;
+
+  const RegionType region = output->GetRequestedRegion();
+
+  // find the bounding box of each label, as its first and last index
+  using BoundingBoxType = std::pair<IndexType, IndexType>;
+  using BoundingBoxMapType = std::map<InputPixelType, BoundingBoxType>;
+
+  BoundingBoxMapType boundingBoxes;
+  std::mutex         boundingBoxesMutex;
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [input, &boundingBoxes, &boundingBoxesMutex](const RegionType & subRegion) {
+      BoundingBoxMapType localBoundingBoxes;
+
+      // labels usually come in runs, so the last one found is checked first
+      auto current = localBoundingBoxes.end();
+      for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, subRegion); !it.IsAtEnd(); ++it)
+      {
+        const InputPixelType value = it.Get();
+        const IndexType &    index = it.GetIndex();
+        if (current == localBoundingBoxes.end() || Math::NotExactlyEquals(current->first, value))
+        {
+          current = localBoundingBoxes.find(value);
+          if (current == localBoundingBoxes.end())
+          {
+            current = localBoundingBoxes.emplace(value, BoundingBoxType(index, index)).first;
+            continue;
+          }
+        }
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          current->second.first[d] = std::min(current->second.first[d], index[d]);
+          current->second.second[d] = std::max(current->second.second[d], index[d]);
+        }
+      }
+
+      const std::lock_guard<std::mutex> lockGuard(boundingBoxesMutex);
+      for (const auto & localBoundingBox : localBoundingBoxes)
+      {
+        const auto inserted = boundingBoxes.insert(localBoundingBox);
+        if (!inserted.second)
+        {
+          BoundingBoxType & boundingBox = inserted.first->second;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            boundingBox.first[d] = std::min(boundingBox.first[d], localBoundingBox.second.first[d]);
+            boundingBox.second[d] = std::max(boundingBox.second[d], localBoundingBox.second.second[d]);
+          }
+        }
+      }
+    },
+    nullptr);
+
+  const auto   numberOfLabels = static_cast<float>(boundingBoxes.size());
+  unsigned int labelCount = 0;
+  for (const auto & boundingBox : boundingBoxes)
+  {
+    const InputPixelType label = boundingBox.first;
+
+    // the nearest pixel of another label is either in the bounding box,
+    // or on the one pixel wide layer around it
+    RegionType labelRegion;
+    labelRegion.SetIndex(boundingBox.second.first);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      labelRegion.SetSize(d, boundingBox.second.second[d] - boundingBox.second.first[d] + 1);
+    }
+    labelRegion.PadByRadius(1);
+    labelRegion.Crop(region);
+
+    auto labelDistance = OutputImageType::New();
+    labelDistance->CopyInformation(output);
+    labelDistance->SetRegions(labelRegion);
+    labelDistance->Allocate();
+
+    typename IndexImageType::Pointer labelNearest;
+    if (nearest)
+    {
+      labelNearest = IndexImageType::New();
+      labelNearest->CopyInformation(nearest);
+      labelNearest->SetRegions(labelRegion);
+      labelNearest->Allocate();
+    }
+
+    this->InitializeSquaredDistance(
+      labelRegion,
+      [label](const InputPixelType & value) { return Math::NotExactlyEquals(value, label); },
+      labelDistance,
+      labelNearest);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      this->ComputeSquaredDistanceAlongDimension(d, labelRegion, labelDistance, labelNearest, nullptr);
+    }
+
+    // only the pixels of the label take their distance from this transform
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      labelRegion,
+      [&](const RegionType & subRegion) {
+        ImageRegionConstIterator<InputImageType>  inputIt(input, subRegion);
+        ImageRegionConstIterator<OutputImageType> labelIt(labelDistance, subRegion);
+        ImageRegionIterator<OutputImageType>      outputIt(output, subRegion);
+        for (; !inputIt.IsAtEnd(); ++inputIt, ++labelIt, ++outputIt)
+        {
+          if (Math::ExactlyEquals(inputIt.Get(), label))
+          {
+            outputIt.Set(labelIt.Get());
+          }
+        }
+        if (nearest)
+        {
+          ImageRegionConstIterator<IndexImageType> labelNearestIt(labelNearest, subRegion);
+          ImageRegionIterator<IndexImageType>      nearestIt(nearest, subRegion);
+          for (inputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt, ++labelNearestIt, ++nearestIt)
+          {
+            if (Math::ExactlyEquals(inputIt.Get(), label))
+            {
+              nearestIt.Set(labelNearestIt.Get());
+            }
+          }
+        }
+      },
+      nullptr);
+
+    this->UpdateProgress(++labelCount / numberOfLabels * ImageDimension / static_cast<float>(ImageDimension + 1));
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFeaturePredicate>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::InitializeSquaredDistance(const RegionType & region,
+                                                                                      TFeaturePredicate  isFeature,
+                                                                                      OutputImageType *  distance,
+                                                                                      IndexImageType *   nearest)
+{
+  const InputImageType * input = this->GetInput();
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [input, &isFeature, distance, nearest](const RegionType & subRegion) {
+      ImageRegionConstIterator<InputImageType> inputIt(input, subRegion);
+      ImageRegionIterator<OutputImageType>     distanceIt(distance, subRegion);
+      for (; !inputIt.IsAtEnd(); ++inputIt, ++distanceIt)
+      {
+        distanceIt.Set(isFeature(inputIt.Get()) ? NumericTraits<OutputPixelType>::ZeroValue()
+                                                : NumericTraits<OutputPixelType>::max());
+      }
+      if (nearest)
+      {
+        for (ImageRegionIteratorWithIndex<IndexImageType> nearestIt(nearest, subRegion); !nearestIt.IsAtEnd();
+             ++nearestIt)
+        {
+          nearestIt.Set(nearestIt.GetIndex());
+        }
+      }
+    },
+    nullptr);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::ComputeSquaredDistanceAlongDimension(
+  unsigned int       dimension,
+  const RegionType & region,
+  OutputImageType *  distance,
+  IndexImageType *   nearest,
+  ProcessObject *    progress)
+{
+  const SizeValueType length = region.GetSize(dimension);
+  const double        spacing = m_UseImageSpacing ? distance->GetSpacing()[dimension] : 1.0;
+  const auto          infinity = static_cast<double>(NumericTraits<OutputPixelType>::max());
+
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    dimension,
+    region,
+    [=](const RegionType & linesRegion) {
+      // line buffers, shared by all the lines of the work unit
+      std::vector<double>        values(length);
+      std::vector<IndexType>     indexes(nearest ? length : 0);
+      std::vector<SizeValueType> vertices(length);
+      std::vector<double>        boundaries(length);
+
+      ImageLinearIteratorWithIndex<OutputImageType> it(distance, linesRegion);
+      it.SetDirection(dimension);
+      ImageLinearIteratorWithIndex<IndexImageType> nearestIt;
+      if (nearest)
+      {
+        nearestIt = ImageLinearIteratorWithIndex<IndexImageType>(nearest, linesRegion);
+        nearestIt.SetDirection(dimension);
+      }
+
+      for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+      {
+        for (SizeValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+        {
+          values[i] = static_cast<double>(it.Get());
+        }
+        if (nearest)
+        {
+          for (SizeValueType i = 0; !nearestIt.IsAtEndOfLine(); ++nearestIt, ++i)
+          {
+            indexes[i] = nearestIt.Get();
+          }
+        }
+
+        // lower envelope of the parabolas rooted at the finite samples.
+        // boundaries[k] is where the parabola k starts to be the lowest.
+        SizeValueType numberOfParabolas = 0;
+        for (SizeValueType q = 0; q < length; ++q)
+        {
+          if (Math::ExactlyEquals(values[q], infinity))
+          {
+            continue;
+          }
+          const double xq = q * spacing;
+          const double fq = values[q] + xq * xq;
+          double       intersection = NumericTraits<double>::NonpositiveMin();
+          while (numberOfParabolas > 0)
+          {
+            const SizeValueType p = vertices[numberOfParabolas - 1];
+            const double        xp = p * spacing;
+            intersection = (fq - (values[p] + xp * xp)) / (2.0 * (xq - xp));
+            if (intersection > boundaries[numberOfParabolas - 1])
+            {
+              break;
+            }
+            --numberOfParabolas;
+            intersection = NumericTraits<double>::NonpositiveMin();
+          }
+          vertices[numberOfParabolas] = q;
+          boundaries[numberOfParabolas] = intersection;
+          ++numberOfParabolas;
+        }
+
+        if (numberOfParabolas > 0)
+        {
+          it.GoToBeginOfLine();
+          if (nearest)
+          {
+            nearestIt.GoToBeginOfLine();
+          }
+          SizeValueType k = 0;
+          for (SizeValueType q = 0; q < length; ++q, ++it)
+          {
+            const double x = q * spacing;
+            while (k + 1 < numberOfParabolas && boundaries[k + 1] < x)
+            {
+              ++k;
+            }
+            const SizeValueType p = vertices[k];
+            const double        dx = x - p * spacing;
+            it.Set(static_cast<OutputPixelType>(values[p] + dx * dx));
+            if (nearest)
+            {
+              nearestIt.Set(indexes[p]);
+              ++nearestIt;
+            }
+          }
+        }
+
+        if (nearest)
+        {
+          nearestIt.NextLine();
+        }
+      }
+    },
+    progress);
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+SeparableDistanceMapImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<InputPixelType>::PrintType>(m_BackgroundValue)
+     << std::endl;
+  os << indent << "SquaredDistance: " << (m_SquaredDistance ? "On" : "Off") << std::endl;
+  os << indent << "UseImageSpacing: " << (m_UseImageSpacing ? "On" : "Off") << std::endl;
+  os << indent << "ComputeNearestFeatureIndexMap: " << (m_ComputeNearestFeatureIndexMap ? "On" : "Off") << std::endl;
+  os << indent << "PerLabel: " << (m_PerLabel ? "On" : "Off") << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,266 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSurfaceDistanceImageFilter_h
+#define itkSurfaceDistanceImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkNumericTraits.h"
+
+#include <map>
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class SurfaceDistanceImageFilter
+ * \brief Computes the Hausdorff distance, a percentile of the Hausdorff
+ * distance and the mean surface distance between the boundaries of the
+ * objects of two images.
+ *
+ * The boundary of an object is the set of its pixels which have a face
+ * neighbor outside of the object, or which are on the edge of the image.
+ * The boundaries of both inputs are extracted once, in parallel, and the
+ * distance from every boundary pixel to the nearest boundary pixel of the
+ * other input is found with a k-d tree built over the other boundary,
+ * the queries being split between the work units. The cost depends on
+ * the number of boundary pixels rather than on the number of pixels of
+ * the images, and no distance map is computed.
+ *
+ * With \f$d(a,B) = \min_{b \in B} \| a - b\|\f$, for the boundaries
+ * \f$A\f$ and \f$B\f$ of the first and second inputs, the filter computes:
+ * - the Hausdorff distance \f$\max(\max_{a \in A} d(a,B), \max_{b \in B} d(b,A))\f$,
+ * - the percentile Hausdorff distance, the largest of the two directed
+ *   percentiles of the distances, the percentile being 0.95 by default,
+ * - the mean surface distance, the average of \f$d(a,B)\f$ and
+ *   \f$d(b,A)\f$ over all the pixels of both boundaries.
+ *
+ * The pixels which are not equal to the background value form the
+ * foreground of each image, and the distances between the boundaries of
+ * the foregrounds are always computed. When ComputeLabelDistances is on,
+ * each distinct non-background value is also taken as a label, and the
+ * distances are computed for each label present in either image. If the
+ * boundary is empty in only one of the images, all the distances are set
+ * to the maximum value of RealType; if it is empty in both, they are set
+ * to zero.
+ *
+ * When UseImageSpacing is on, the distances are measured between the
+ * physical points of the pixels, so the two images need not share the
+ * same grid. Otherwise they are measured between the pixel indices.
+ *
+ * The filter passes the first input through unmodified.
+ *
+ * \sa HausdorffDistanceImageFilter
+ * \sa ContourMeanDistanceImageFilter
+ * \sa Statistics::KdTree
+ *
+ * \ingroup MultiThreaded
+ * \ingroup ITKDistanceMap
+ */
+template <typename TInputImage1, typename TInputImage2>
+class ITK_TEMPLATE_EXPORT SurfaceDistanceImageFilter : public ImageToImageFilter<TInputImage1, TInputImage1>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SurfaceDistanceImageFilter);
+
+  /** Standard Self type alias */
+  using Self = SurfaceDistanceImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage1, TInputImage1>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkOverrideGetNameOfClassMacro(SurfaceDistanceImageFilter);
+
+  /** Image related type alias. */
+  using InputImage1Type = TInputImage1;
+  using InputImage2Type = TInputImage2;
+  using InputImage1Pointer = typename TInputImage1::Pointer;
+  using InputImage2Pointer = typename TInputImage2::Pointer;
+
+  using InputImage1PixelType = typename TInputImage1::PixelType;
+  using InputImage2PixelType = typename TInputImage2::PixelType;
+
+  /** Image related type alias. */
+  static constexpr unsigned int ImageDimension = TInputImage1::ImageDimension;
+
+  /** Type of the labels. The pixels of the second input are cast to it. */
+  using LabelType = InputImage1PixelType;
+
+  /** Type to use for computations. */
+  using RealType = double;
+
+  using PointType = Point<RealType, ImageDimension>;
+
+  /** Distances between two boundaries. */
+  struct SurfaceDistances
+  {
+    RealType      HausdorffDistance{};
+    RealType      PercentileHausdorffDistance{};
+    RealType      MeanSurfaceDistance{};
+    SizeValueType NumberOfBoundaryPixels1{};
+    SizeValueType NumberOfBoundaryPixels2{};
+  };
+
+  using LabelDistancesMapType = std::map<LabelType, SurfaceDistances>;
+
+  /** Set the first input. */
+  void
+  SetInput1(const InputImage1Type * image);
+
+  /** Set the second input. */
+  void
+  SetInput2(const InputImage2Type * image);
+
+  /** Get the first input. */
+  const InputImage1Type *
+  GetInput1();
+
+  /** Get the second input. */
+  const InputImage2Type *
+  GetInput2();
+
+  /** Set/Get the value of the pixels outside of the objects. Defaults to
+   * zero. */
+  itkSetMacro(BackgroundValue, LabelType);
+  itkGetConstMacro(BackgroundValue, LabelType);
+
+  /** Set/Get if image spacing should be used in computing distances. */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetConstMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Set/Get the percentile, between 0 and 1, of the percentile Hausdorff
+   * distance. Defaults to 0.95. */
+  itkSetClampMacro(Percentile, double, 0.0, 1.0);
+  itkGetConstMacro(Percentile, double);
+
+  /** Set/Get if the distances are also computed for each label. Off by
+   * default. */
+  itkSetMacro(ComputeLabelDistances, bool);
+  itkGetConstMacro(ComputeLabelDistances, bool);
+  itkBooleanMacro(ComputeLabelDistances);
+
+  /** Return the distances between the boundaries of the foregrounds. */
+  RealType
+  GetHausdorffDistance() const
+  {
+    return m_Distances.HausdorffDistance;
+  }
+  RealType
+  GetPercentileHausdorffDistance() const
+  {
+    return m_Distances.PercentileHausdorffDistance;
+  }
+  RealType
+  GetMeanSurfaceDistance() const
+  {
+    return m_Distances.MeanSurfaceDistance;
+  }
+  const SurfaceDistances &
+  GetDistances() const
+  {
+    return m_Distances;
+  }
+
+  /** Return the distances of each label, when ComputeLabelDistances is on. */
+  const LabelDistancesMapType &
+  GetLabelDistances() const
+  {
+    return m_LabelDistances;
+  }
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro(SameDimensionCheck,
+                  (Concept::SameDimension<TInputImage1::ImageDimension, TInputImage2::ImageDimension>));
+  itkConceptMacro(Input1HasNumericTraitsCheck, (Concept::HasNumericTraits<InputImage1PixelType>));
+  // End concept checking
+#endif
+
+protected:
+  SurfaceDistanceImageFilter();
+  ~SurfaceDistanceImageFilter() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** GenerateData. */
+  void
+  GenerateData() override;
+
+  // Override since the filter needs all the data for the algorithm
+  void
+  GenerateInputRequestedRegion() override;
+
+  // Override since the filter produces all of its output
+  void
+  EnlargeOutputRequestedRegion(DataObject * data) override;
+
+  /** Override VerifyInputInformation() since this filter's inputs do
+   * not need to occupy the same physical space.
+   *
+   * \sa ProcessObject::VerifyInputInformation
+   */
+  void
+  VerifyInputInformation() ITKv5_CONST override
+  {}
+
+private:
+  using PointsVectorType = std::vector<PointType>;
+
+  /** Boundary pixels of the foreground and of each label of an image. */
+  struct BoundaryPoints
+  {
+    PointsVectorType                      Foreground;
+    std::map<LabelType, PointsVectorType> Labels;
+  };
+
+  /** Extract the boundary points of image, one slice of the last
+   * dimension at a time. */
+  template <typename TImage>
+  void
+  ExtractBoundaryPoints(const TImage * image, BoundaryPoints & boundary, ProcessObject * progress) const;
+
+  /** Distance from each of points to the nearest of the target points. */
+  std::vector<RealType>
+  ComputeDirectedDistances(const PointsVectorType & points,
+                           const PointsVectorType & targetPoints,
+                           ProcessObject *          progress) const;
+
+  SurfaceDistances
+  ComputeSurfaceDistances(const PointsVectorType & points1,
+                          const PointsVectorType & points2,
+                          ProcessObject *          progress) const;
+
+  LabelType m_BackgroundValue{};
+  bool      m_UseImageSpacing{ true };
+  double    m_Percentile{ 0.95 };
+  bool      m_ComputeLabelDistances{ false };
+
+  SurfaceDistances      m_Distances{};
+  LabelDistancesMapType m_LabelDistances{};
+}; // end of class
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkSurfaceDistanceImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,380 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSurfaceDistanceImageFilter_hxx
+#define itkSurfaceDistanceImageFilter_hxx
+
+#include "itkIndexRange.h"
+#include "itkKdTreeGenerator.h"
+#include "itkMath.h"
+#include "itkProgressTransformer.h"
+#include "itkVectorContainer.h"
+#include "itkVectorContainerToListSampleAdaptor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+template <typename TInputImage1, typename TInputImage2>
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::SurfaceDistanceImageFilter()
+{
+  // this filter requires two input images
+  this->SetNumberOfRequiredInputs(2);
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::SetInput1(const InputImage1Type * image)
+{
+  this->SetInput(image);
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::SetInput2(const TInputImage2 * image)
+{
+  this->SetNthInput(1, const_cast<TInputImage2 *>(image));
+}
+
+template <typename TInputImage1, typename TInputImage2>
+auto
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::GetInput1() -> const InputImage1Type *
+{
+  return this->GetInput();
+}
+
+template <typename TInputImage1, typename TInputImage2>
+auto
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::GetInput2() -> const InputImage2Type *
+{
+  return itkDynamicCastInDebugMode<const TInputImage2 *>(this->ProcessObject::GetInput(1));
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // this filter requires the largest possible region of both images,
+  // which need not share the same grid
+  if (this->GetInput1())
+  {
+    InputImage1Pointer image1 = const_cast<InputImage1Type *>(this->GetInput1());
+    image1->SetRequestedRegionToLargestPossibleRegion();
+  }
+  if (this->GetInput2())
+  {
+    InputImage2Pointer image2 = const_cast<InputImage2Type *>(this->GetInput2());
+    image2->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::EnlargeOutputRequestedRegion(DataObject * data)
+{
+  Superclass::EnlargeOutputRequestedRegion(data);
+  data->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::GenerateData()
+{
+  // Pass the first input through as the output
+  InputImage1Pointer image = const_cast<TInputImage1 *>(this->GetInput1());
+  this->GraftOutput(image);
+
+  this->GetMultiThreader()->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  m_LabelDistances.clear();
+
+  BoundaryPoints boundary1;
+  BoundaryPoints boundary2;
+  {
+    ProgressTransformer progress(0.0f, 0.2f, this);
+    this->ExtractBoundaryPoints(this->GetInput1(), boundary1, progress.GetProcessObject());
+  }
+  {
+    ProgressTransformer progress(0.2f, 0.4f, this);
+    this->ExtractBoundaryPoints(this->GetInput2(), boundary2, progress.GetProcessObject());
+  }
+
+  const float foregroundEnd = m_ComputeLabelDistances ? 0.7f : 1.0f;
+  {
+    ProgressTransformer progress(0.4f, foregroundEnd, this);
+    m_Distances = this->ComputeSurfaceDistances(boundary1.Foreground, boundary2.Foreground, progress.GetProcessObject());
+  }
+  boundary1.Foreground.clear();
+  boundary2.Foreground.clear();
+
+  if (m_ComputeLabelDistances)
+  {
+    // the labels present in either image, each one with an empty boundary
+    // in the image where it is missing
+    for (const auto & label : boundary1.Labels)
+    {
+      boundary2.Labels[label.first];
+    }
+    for (const auto & label : boundary2.Labels)
+    {
+      boundary1.Labels[label.first];
+    }
+
+    const auto numberOfLabels = static_cast<float>(boundary1.Labels.size());
+    float      labelCount = 0.0f;
+    for (auto & label : boundary1.Labels)
+    {
+      PointsVectorType & points2 = boundary2.Labels[label.first];
+
+      ProgressTransformer progress(foregroundEnd + (1.0f - foregroundEnd) * labelCount / numberOfLabels,
+                                   foregroundEnd + (1.0f - foregroundEnd) * (labelCount + 1.0f) / numberOfLabels,
+                                   this);
+      m_LabelDistances[label.first] =
+        this->ComputeSurfaceDistances(label.second, points2, progress.GetProcessObject());
+      ++labelCount;
+
+      // release the points of the label once its distances are known
+      PointsVectorType().swap(label.second);
+      PointsVectorType().swap(points2);
+    }
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2>
+template <typename TImage>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::ExtractBoundaryPoints(const TImage *   image,
+                                                                              BoundaryPoints & boundary,
+                                                                              ProcessObject *  progress) const
+{
+  using ImageRegionType = typename TImage::RegionType;
+  using ImageIndexType = typename TImage::IndexType;
+
+  const ImageRegionType  region = image->GetBufferedRegion();
+  const ImageIndexType   lowerIndex = region.GetIndex();
+  const ImageIndexType   upperIndex = region.GetUpperIndex();
+  const OffsetValueType * offsetTable = image->GetOffsetTable();
+  const auto *           buffer = image->GetBufferPointer();
+
+  const LabelType background = m_BackgroundValue;
+  const bool      computeLabelBoundaries = m_ComputeLabelDistances;
+  const bool      useImageSpacing = m_UseImageSpacing;
+
+  // The slices along the last dimension are processed independently, and
+  // their points are then concatenated in order, so that the boundaries do
+  // not depend on the number of work units.
+  constexpr unsigned int      sliceDimension = ImageDimension - 1;
+  const SizeValueType         numberOfSlices = region.GetSize(sliceDimension);
+  std::vector<BoundaryPoints> sliceBoundaries(numberOfSlices);
+
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSlices,
+    [&](SizeValueType slice) {
+      ImageRegionType sliceRegion = region;
+      sliceRegion.SetIndex(sliceDimension, lowerIndex[sliceDimension] + static_cast<IndexValueType>(slice));
+      sliceRegion.SetSize(sliceDimension, 1);
+
+      BoundaryPoints & sliceBoundary = sliceBoundaries[slice];
+      for (const ImageIndexType & index : ImageRegionIndexRange<ImageDimension>(sliceRegion))
+      {
+        const OffsetValueType offset = image->ComputeOffset(index);
+        const auto            label = static_cast<LabelType>(buffer[offset]);
+        if (Math::ExactlyEquals(label, background))
+        {
+          continue;
+        }
+
+        // a pixel on the edge of the image, or next to the background, is
+        // on the boundary of the foreground, and next to another label, on
+        // the boundary of its label
+        bool isForegroundBoundary = false;
+        bool isLabelBoundary = false;
+        for (unsigned int d = 0; d < ImageDimension && !isForegroundBoundary; ++d)
+        {
+          if (index[d] == lowerIndex[d] || index[d] == upperIndex[d])
+          {
+            isForegroundBoundary = true;
+            break;
+          }
+          for (const OffsetValueType neighborOffset : { offset - offsetTable[d], offset + offsetTable[d] })
+          {
+            const auto neighborLabel = static_cast<LabelType>(buffer[neighborOffset]);
+            if (Math::ExactlyEquals(neighborLabel, background))
+            {
+              isForegroundBoundary = true;
+            }
+            else if (Math::NotExactlyEquals(neighborLabel, label))
+            {
+              isLabelBoundary = true;
+            }
+          }
+        }
+        if (!isForegroundBoundary && !(isLabelBoundary && computeLabelBoundaries))
+        {
+          continue;
+        }
+
+        PointType point;
+        if (useImageSpacing)
+        {
+          image->TransformIndexToPhysicalPoint(index, point);
+        }
+        else
+        {
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            point[d] = static_cast<RealType>(index[d]);
+          }
+        }
+
+        if (isForegroundBoundary)
+        {
+          sliceBoundary.Foreground.push_back(point);
+        }
+        if (computeLabelBoundaries)
+        {
+          sliceBoundary.Labels[label].push_back(point);
+        }
+      }
+    },
+    progress);
+
+  boundary = BoundaryPoints();
+  for (BoundaryPoints & sliceBoundary : sliceBoundaries)
+  {
+    boundary.Foreground.insert(
+      boundary.Foreground.end(), sliceBoundary.Foreground.cbegin(), sliceBoundary.Foreground.cend());
+    for (const auto & label : sliceBoundary.Labels)
+    {
+      PointsVectorType & points = boundary.Labels[label.first];
+      points.insert(points.end(), label.second.cbegin(), label.second.cend());
+    }
+    sliceBoundary = BoundaryPoints();
+  }
+}
+
+template <typename TInputImage1, typename TInputImage2>
+auto
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::ComputeDirectedDistances(const PointsVectorType & points,
+                                                                                 const PointsVectorType & targetPoints,
+                                                                                 ProcessObject * progress) const
+  -> std::vector<RealType>
+{
+  using PointsContainerType = VectorContainer<IdentifierType, PointType>;
+  using SampleAdaptorType = Statistics::VectorContainerToListSampleAdaptor<PointsContainerType>;
+  using TreeGeneratorType = Statistics::KdTreeGenerator<SampleAdaptorType>;
+  using TreeType = typename TreeGeneratorType::KdTreeType;
+
+  auto targetContainer = PointsContainerType::New();
+  targetContainer->CastToSTLContainer() = targetPoints;
+
+  auto sampleAdaptor = SampleAdaptorType::New();
+  sampleAdaptor->SetVectorContainer(targetContainer);
+  sampleAdaptor->SetMeasurementVectorSize(ImageDimension);
+
+  auto treeGenerator = TreeGeneratorType::New();
+  treeGenerator->SetSample(sampleAdaptor);
+  treeGenerator->SetBucketSize(16);
+  treeGenerator->Update();
+  const TreeType * tree = treeGenerator->GetOutput();
+
+  // KdTree::Search only reads the tree, so the queries are independent
+  std::vector<RealType> distances(points.size());
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    points.size(),
+    [&points, &distances, tree](SizeValueType i) {
+      typename TreeType::InstanceIdentifierVectorType identifiers;
+      std::vector<double>                             neighborDistances;
+      tree->Search(points[i], 1u, identifiers, neighborDistances);
+      distances[i] = neighborDistances[0];
+    },
+    progress);
+
+  return distances;
+}
+
+template <typename TInputImage1, typename TInputImage2>
+auto
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::ComputeSurfaceDistances(const PointsVectorType & points1,
+                                                                                const PointsVectorType & points2,
+                                                                                ProcessObject * progress) const
+  -> SurfaceDistances
+{
+  SurfaceDistances distances;
+  distances.NumberOfBoundaryPixels1 = points1.size();
+  distances.NumberOfBoundaryPixels2 = points2.size();
+
+  if (points1.empty() || points2.empty())
+  {
+    const RealType value = (points1.empty() && points2.empty()) ? 0.0 : NumericTraits<RealType>::max();
+    distances.HausdorffDistance = value;
+    distances.PercentileHausdorffDistance = value;
+    distances.MeanSurfaceDistance = value;
+    return distances;
+  }
+
+  RealType sum = 0.0;
+  for (unsigned int direction = 0; direction < 2; ++direction)
+  {
+    const PointsVectorType & points = direction == 0 ? points1 : points2;
+    const PointsVectorType & targetPoints = direction == 0 ? points2 : points1;
+
+    ProgressTransformer   directionProgress(0.5f * direction, 0.5f * (direction + 1), progress);
+    std::vector<RealType> directed =
+      this->ComputeDirectedDistances(points, targetPoints, directionProgress.GetProcessObject());
+
+    for (const RealType distance : directed)
+    {
+      sum += distance;
+      distances.HausdorffDistance = std::max(distances.HausdorffDistance, distance);
+    }
+
+    // the smallest distance which is not exceeded by the given fraction of
+    // the points
+    const auto rank = static_cast<SizeValueType>(std::ceil(m_Percentile * directed.size()));
+    const auto nth = directed.begin() + (rank > 0 ? rank - 1 : 0);
+    std::nth_element(directed.begin(), nth, directed.end());
+    distances.PercentileHausdorffDistance = std::max(distances.PercentileHausdorffDistance, *nth);
+  }
+  distances.MeanSurfaceDistance = sum / static_cast<RealType>(points1.size() + points2.size());
+
+  return distances;
+}
+
+template <typename TInputImage1, typename TInputImage2>
+void
+SurfaceDistanceImageFilter<TInputImage1, TInputImage2>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BackgroundValue: " << static_cast<typename NumericTraits<LabelType>::PrintType>(m_BackgroundValue)
+     << std::endl;
+  os << indent << "UseImageSpacing: " << m_UseImageSpacing << std::endl;
+  os << indent << "Percentile: " << m_Percentile << std::endl;
+  os << indent << "ComputeLabelDistances: " << m_ComputeLabelDistances << std::endl;
+  os << indent << "HausdorffDistance: " << m_Distances.HausdorffDistance << std::endl;
+  os << indent << "PercentileHausdorffDistance: " << m_Distances.PercentileHausdorffDistance << std::endl;
+  os << indent << "MeanSurfaceDistance: " << m_Distances.MeanSurfaceDistance << std::endl;
+  os << indent << "Number of labels: " << m_LabelDistances.size() << std::endl;
+}
+} // end namespace itk
+#endif
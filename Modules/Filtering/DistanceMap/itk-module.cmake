@@ -9,6 +9,7 @@ itk_module(
   ITKBinaryMathematicalMorphology
   ITKImageLabel
   ITKNarrowBand
+  ITKStatistics
   TEST_DEPENDS
   ITKTestKernel
   DESCRIPTION
@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSeparableDistanceMapImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using InputImageType = itk::Image<unsigned char, Dimension>;
+using OutputImageType = itk::Image<double, Dimension>;
+using IndexType = InputImageType::IndexType;
+
+double
+SquaredPhysicalDistance(const IndexType & a, const IndexType & b, const InputImageType::SpacingType & spacing)
+{
+  double distance = 0.0;
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    const double difference = (a[d] - b[d]) * spacing[d];
+    distance += difference * difference;
+  }
+  return distance;
+}
+
+// Compare the outputs with the brute force distance to the nearest pixel
+// with a value other than the value of the pixel (PerLabel on), or other
+// than the background (PerLabel off).
+template <typename TFilter>
+int
+CheckAgainstBruteForce(const InputImageType * input, TFilter * filter)
+{
+  const InputImageType::SpacingType spacing = input->GetSpacing();
+
+  std::vector<std::pair<IndexType, unsigned char>> pixels;
+  for (itk::ImageRegionConstIteratorWithIndex<InputImageType> it(input, input->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    pixels.emplace_back(it.GetIndex(), it.Get());
+  }
+
+  for (const auto & pixel : pixels)
+  {
+    double expected = itk::NumericTraits<double>::max();
+    for (const auto & feature : pixels)
+    {
+      const bool isFeature = filter->GetPerLabel() ? feature.second != pixel.second : feature.second != 0;
+      if (isFeature)
+      {
+        expected = std::min(expected, SquaredPhysicalDistance(pixel.first, feature.first, spacing));
+      }
+    }
+    expected = std::sqrt(expected);
+
+    const double distance = filter->GetOutput()->GetPixel(pixel.first);
+    if (itk::Math::abs(distance - expected) > 1e-9)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in distance at " << pixel.first << ": expected " << expected << ", but got " << distance
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const IndexType nearest = filter->GetNearestFeatureIndexMap()->GetPixel(pixel.first);
+    const double    nearestDistance = std::sqrt(SquaredPhysicalDistance(pixel.first, nearest, spacing));
+    const bool      nearestIsFeature = filter->GetPerLabel() ? input->GetPixel(nearest) != pixel.second
+                                                             : input->GetPixel(nearest) != 0;
+    if (!nearestIsFeature || itk::Math::abs(nearestDistance - expected) > 1e-9)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in nearest feature index at " << pixel.first << ": " << nearest << " is at "
+                << nearestDistance << ", but the nearest feature is at " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkSeparableDistanceMapImageFilterTest(int, char *[])
+{
+  using FilterType = itk::SeparableDistanceMapImageFilter<InputImageType, OutputImageType>;
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, SeparableDistanceMapImageFilter, ImageToImageFilter);
+
+  ITK_TEST_SET_GET_BOOLEAN(filter, SquaredDistance, false);
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseImageSpacing, true);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputeNearestFeatureIndexMap, true);
+  ITK_TEST_SET_GET_BOOLEAN(filter, PerLabel, false);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetBackgroundValue());
+
+  // An anisotropic image with a few labeled blocks and isolated points
+  auto                           input = InputImageType::New();
+  const InputImageType::SizeType size = { { 17, 13, 11 } };
+  input->SetRegions(size);
+  input->Allocate(true);
+  const InputImageType::SpacingType::ValueType spacingValues[] = { 0.7, 1.3, 2.1 };
+  input->SetSpacing(InputImageType::SpacingType(spacingValues));
+
+  unsigned int seed = 7;
+  for (itk::ImageRegionIterator<InputImageType> it(input, input->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    seed = (seed * 1103515245 + 12345) % 2147483648u;
+    if (seed % 61 == 0)
+    {
+      it.Set(static_cast<unsigned char>(1 + seed % 3));
+    }
+  }
+  InputImageType::RegionType block({ { 2, 3, 1 } }, { { 6, 4, 5 } });
+  for (itk::ImageRegionIterator<InputImageType> it(input, block); !it.IsAtEnd(); ++it)
+  {
+    it.Set(4);
+  }
+  block.SetIndex({ { 7, 5, 3 } });
+  for (itk::ImageRegionIterator<InputImageType> it(input, block); !it.IsAtEnd(); ++it)
+  {
+    it.Set(5);
+  }
+
+  filter->SetInput(input);
+  filter->ComputeNearestFeatureIndexMapOn();
+  for (const bool perLabel : { false, true })
+  {
+    filter->SetPerLabel(perLabel);
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 5 })
+    {
+      std::cout << "PerLabel: " << perLabel << ", work units: " << numberOfWorkUnits << std::endl;
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      if (CheckAgainstBruteForce(input.GetPointer(), filter.GetPointer()) == EXIT_FAILURE)
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Without any feature pixel, all the pixels are unreachable
+  input->FillBuffer(0);
+  input->Modified();
+  filter->PerLabelOff();
+  filter->SquaredDistanceOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  for (itk::ImageRegionConstIterator<OutputImageType> it(filter->GetOutput(), input->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    ITK_TEST_EXPECT_EQUAL(it.Get(), itk::NumericTraits<double>::max());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
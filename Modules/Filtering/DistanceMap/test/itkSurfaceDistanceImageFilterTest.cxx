@@ -0,0 +1,256 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSurfaceDistanceImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using Image1Type = itk::Image<unsigned char, Dimension>;
+using Image2Type = itk::Image<short, Dimension>;
+using FilterType = itk::SurfaceDistanceImageFilter<Image1Type, Image2Type>;
+using PointType = FilterType::PointType;
+using DistancesType = FilterType::SurfaceDistances;
+
+// Boundary points of the pixels for which isInside is true: those on the
+// edge of the image, or with a face neighbor for which isInside is false.
+template <typename TImage, typename TPredicate>
+std::vector<PointType>
+BruteForceBoundary(const TImage * image, TPredicate isInside)
+{
+  const typename TImage::RegionType region = image->GetLargestPossibleRegion();
+
+  std::vector<PointType> points;
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (!isInside(it.Get()))
+    {
+      continue;
+    }
+    bool onBoundary = false;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      for (const int step : { -1, 1 })
+      {
+        typename TImage::IndexType neighbor = it.GetIndex();
+        neighbor[d] += step;
+        if (!region.IsInside(neighbor) || !isInside(image->GetPixel(neighbor)))
+        {
+          onBoundary = true;
+        }
+      }
+    }
+    if (onBoundary)
+    {
+      PointType point;
+      image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+      points.push_back(point);
+    }
+  }
+  return points;
+}
+
+std::vector<double>
+BruteForceDirectedDistances(const std::vector<PointType> & points, const std::vector<PointType> & targetPoints)
+{
+  std::vector<double> distances;
+  for (const auto & point : points)
+  {
+    double distance = itk::NumericTraits<double>::max();
+    for (const auto & targetPoint : targetPoints)
+    {
+      distance = std::min(distance, point.EuclideanDistanceTo(targetPoint));
+    }
+    distances.push_back(distance);
+  }
+  return distances;
+}
+
+DistancesType
+BruteForceDistances(const std::vector<PointType> & points1, const std::vector<PointType> & points2, double percentile)
+{
+  DistancesType distances;
+  distances.NumberOfBoundaryPixels1 = points1.size();
+  distances.NumberOfBoundaryPixels2 = points2.size();
+
+  double sum = 0.0;
+  for (unsigned int direction = 0; direction < 2; ++direction)
+  {
+    std::vector<double> directed = direction == 0 ? BruteForceDirectedDistances(points1, points2)
+                                                  : BruteForceDirectedDistances(points2, points1);
+    std::sort(directed.begin(), directed.end());
+    for (const double distance : directed)
+    {
+      sum += distance;
+    }
+    distances.HausdorffDistance = std::max(distances.HausdorffDistance, directed.back());
+
+    auto rank = static_cast<size_t>(std::ceil(percentile * directed.size()));
+    rank = std::max<size_t>(rank, 1);
+    distances.PercentileHausdorffDistance = std::max(distances.PercentileHausdorffDistance, directed[rank - 1]);
+  }
+  distances.MeanSurfaceDistance = sum / (points1.size() + points2.size());
+  return distances;
+}
+
+bool
+CheckDistances(const DistancesType & distances, const DistancesType & expected, const std::string & name)
+{
+  std::cout << name << ": Hausdorff " << distances.HausdorffDistance << ", percentile "
+            << distances.PercentileHausdorffDistance << ", mean " << distances.MeanSurfaceDistance << std::endl;
+  if (distances.NumberOfBoundaryPixels1 != expected.NumberOfBoundaryPixels1 ||
+      distances.NumberOfBoundaryPixels2 != expected.NumberOfBoundaryPixels2 ||
+      itk::Math::abs(distances.HausdorffDistance - expected.HausdorffDistance) > 1e-9 ||
+      itk::Math::abs(distances.PercentileHausdorffDistance - expected.PercentileHausdorffDistance) > 1e-9 ||
+      itk::Math::abs(distances.MeanSurfaceDistance - expected.MeanSurfaceDistance) > 1e-9)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error in the distances of " << name << ": expected " << expected.NumberOfBoundaryPixels1 << " and "
+              << expected.NumberOfBoundaryPixels2 << " boundary pixels, Hausdorff " << expected.HausdorffDistance
+              << ", percentile " << expected.PercentileHausdorffDistance << ", mean " << expected.MeanSurfaceDistance
+              << ", but got " << distances.NumberOfBoundaryPixels1 << " and " << distances.NumberOfBoundaryPixels2
+              << " boundary pixels" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename TImage>
+void
+FillBlock(TImage * image, const typename TImage::IndexType & index, const typename TImage::SizeType & size, int value)
+{
+  for (itk::ImageRegionIterator<TImage> it(image, { index, size }); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<typename TImage::PixelType>(value));
+  }
+}
+} // namespace
+
+int
+itkSurfaceDistanceImageFilterTest(int, char *[])
+{
+  auto filter = FilterType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, SurfaceDistanceImageFilter, ImageToImageFilter);
+
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseImageSpacing, true);
+  ITK_TEST_SET_GET_BOOLEAN(filter, ComputeLabelDistances, true);
+  ITK_TEST_SET_GET_VALUE(0, filter->GetBackgroundValue());
+  ITK_TEST_SET_GET_VALUE(0.95, filter->GetPercentile());
+
+  // Two label images on different anisotropic grids: the distances are
+  // measured between physical points.
+  const Image1Type::SizeType size = { { 19, 15, 11 } };
+
+  auto image1 = Image1Type::New();
+  image1->SetRegions(size);
+  image1->Allocate(true);
+  const Image1Type::SpacingType::ValueType spacingValues[] = { 0.8, 1.1, 1.5 };
+  image1->SetSpacing(Image1Type::SpacingType(spacingValues));
+  FillBlock<Image1Type>(image1, { { 2, 2, 1 } }, { { 8, 7, 6 } }, 1);
+  FillBlock<Image1Type>(image1, { { 6, 4, 3 } }, { { 7, 6, 5 } }, 2);
+  FillBlock<Image1Type>(image1, { { 14, 0, 0 } }, { { 5, 3, 4 } }, 4);
+
+  auto image2 = Image2Type::New();
+  image2->SetRegions(size);
+  image2->Allocate(true);
+  image2->SetSpacing(Image1Type::SpacingType(spacingValues));
+  const Image2Type::PointType::ValueType originValues[] = { 0.4, -0.55, 0.0 };
+  image2->SetOrigin(Image2Type::PointType(originValues));
+  FillBlock<Image2Type>(image2, { { 3, 1, 2 } }, { { 9, 8, 5 } }, 1);
+  FillBlock<Image2Type>(image2, { { 5, 5, 4 } }, { { 6, 4, 6 } }, 2);
+  FillBlock<Image2Type>(image2, { { 12, 10, 1 } }, { { 4, 4, 4 } }, 3);
+
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  filter->ComputeLabelDistancesOn();
+
+  const DistancesType expectedForeground =
+    BruteForceDistances(BruteForceBoundary(image1.GetPointer(), [](unsigned char value) { return value != 0; }),
+                        BruteForceBoundary(image2.GetPointer(), [](short value) { return value != 0; }),
+                        filter->GetPercentile());
+  std::map<unsigned char, DistancesType> expectedLabels;
+  for (const unsigned char label : { 1, 2 })
+  {
+    expectedLabels[label] =
+      BruteForceDistances(BruteForceBoundary(image1.GetPointer(), [label](unsigned char value) { return value == label; }),
+                          BruteForceBoundary(image2.GetPointer(), [label](short value) { return value == label; }),
+                          filter->GetPercentile());
+  }
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+  {
+    std::cout << "Work units: " << numberOfWorkUnits << std::endl;
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+    if (!CheckDistances(filter->GetDistances(), expectedForeground, "foreground"))
+    {
+      return EXIT_FAILURE;
+    }
+    ITK_TEST_EXPECT_EQUAL(filter->GetHausdorffDistance(), expectedForeground.HausdorffDistance);
+
+    // labels 3 and 4 are each present in only one of the images
+    const FilterType::LabelDistancesMapType & labelDistances = filter->GetLabelDistances();
+    ITK_TEST_EXPECT_EQUAL(labelDistances.size(), size_t{ 4 });
+    for (const auto & expected : expectedLabels)
+    {
+      if (!CheckDistances(labelDistances.at(expected.first), expected.second, "label " + std::to_string(expected.first)))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+    for (const unsigned char label : { 3, 4 })
+    {
+      ITK_TEST_EXPECT_EQUAL(labelDistances.at(label).HausdorffDistance, itk::NumericTraits<double>::max());
+      ITK_TEST_EXPECT_EQUAL(labelDistances.at(label).MeanSurfaceDistance, itk::NumericTraits<double>::max());
+    }
+  }
+
+  // The median instead of the 95th percentile
+  filter->SetPercentile(0.5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const DistancesType expectedMedian =
+    BruteForceDistances(BruteForceBoundary(image1.GetPointer(), [](unsigned char value) { return value != 0; }),
+                        BruteForceBoundary(image2.GetPointer(), [](short value) { return value != 0; }),
+                        0.5);
+  if (!CheckDistances(filter->GetDistances(), expectedMedian, "foreground median"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Without any object in either image, all the distances are zero
+  image1->FillBuffer(0);
+  image2->FillBuffer(0);
+  image1->Modified();
+  image2->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetHausdorffDistance(), 0.0);
+  ITK_TEST_EXPECT_EQUAL(filter->GetMeanSurfaceDistance(), 0.0);
+  ITK_TEST_EXPECT_TRUE(filter->GetLabelDistances().empty());
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
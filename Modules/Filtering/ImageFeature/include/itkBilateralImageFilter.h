@@ -22,6 +22,7 @@
 #include "itkFixedArray.h"
 #include "itkNeighborhoodIterator.h"
 #include "itkNeighborhood.h"
+#include "itkVector.h"
 
 namespace itk
 {
@@ -52,6 +53,21 @@ namespace itk
  * Manduchi (Bilateral Filtering for Gray and ColorImages. IEEE
  * ICCV. 1998.)
  *
+ * The cost of the exact filter grows with the size of the domain kernel,
+ * that is with the cube of the domain sigma in 3D. When UseBilateralGrid
+ * is on, the filter is instead approximated on a bilateral grid, which
+ * samples the space and the intensity range with cells of a fraction of
+ * the domain and range sigmas: the pixels are accumulated in their
+ * nearest cell, the grid is blurred with separable Gaussian kernels, and
+ * the output is interpolated in the grid at the position and intensity
+ * of each pixel. The cost then mostly depends on the number of pixels and
+ * of grid cells. The BilateralGridSamplingRate, the number of cells per
+ * sigma, trades speed for accuracy. The accumulation, the blurring and
+ * the interpolation are multithreaded. The Radius and
+ * NumberOfRangeGaussianSamples are not used by the approximation.
+ * See Chen, Paris and Durand (Real-time Edge-Aware Image Processing with
+ * the Bilateral Grid. ACM SIGGRAPH. 2007.)
+ *
  * \sa GaussianOperator
  * \sa RecursiveGaussianImageFilter
  * \sa DiscreteGaussianImageFilter
@@ -126,6 +142,12 @@ public:
   /** Gaussian image type */
   using GaussianImageType = Image<double, Self::ImageDimension>;
 
+  /** Bilateral grid type: the sum of the intensities and the number of the
+   * pixels accumulated in each cell of space and intensity range. */
+  static constexpr unsigned int GridDimension = ImageDimension + 1;
+  using GridPixelType = Vector<float, 2>;
+  using GridImageType = Image<GridPixelType, GridDimension>;
+
   /** Standard get/set macros for filter parameters.
    * DomainSigma is specified in the same units as the Image spacing.
    * RangeSigma is specified in the units of intensity. */
@@ -169,6 +191,18 @@ public:
   itkSetMacro(NumberOfRangeGaussianSamples, unsigned long);
   itkGetConstMacro(NumberOfRangeGaussianSamples, unsigned long);
 
+  /** Set/Get whether the filter is approximated on a bilateral grid
+   * instead of being computed exactly. Default is off. */
+  itkSetMacro(UseBilateralGrid, bool);
+  itkGetConstMacro(UseBilateralGrid, bool);
+  itkBooleanMacro(UseBilateralGrid);
+
+  /** Set/Get the number of bilateral grid cells per domain sigma and per
+   * range sigma. Higher rates are more accurate and slower. The cells are
+   * never smaller than a pixel. Default is 1. */
+  itkSetClampMacro(BilateralGridSamplingRate, double, 0.1, NumericTraits<double>::max());
+  itkGetConstMacro(BilateralGridSamplingRate, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(OutputHasNumericTraitsCheck, (Concept::HasNumericTraits<OutputPixelType>));
@@ -190,6 +224,10 @@ protected:
   void
   BeforeThreadedGenerateData() override;
 
+  /** Release the bilateral grid. */
+  void
+  AfterThreadedGenerateData() override;
+
   /** Standard pipeline method. This filter is implemented as a multi-threaded
    * filter. */
   void
@@ -205,6 +243,15 @@ protected:
   GenerateInputRequestedRegion() override;
 
 private:
+  /** Accumulate the input requested region in the bilateral grid, and
+   * blur the grid. */
+  void
+  ComputeBilateralGrid();
+
+  /** Interpolate the output in the blurred bilateral grid. */
+  void
+  InterpolateBilateralGrid(const OutputImageRegionType & outputRegionForThread);
+
   /** The standard deviation of the gaussian blurring kernel in the image
       range. Units are intensity. */
   double m_RangeSigma{};
@@ -231,6 +278,14 @@ private:
   double              m_DynamicRange{};
   double              m_DynamicRangeUsed{};
   std::vector<double> m_RangeGaussianTable{};
+
+  /** Bilateral grid approximation */
+  bool                               m_UseBilateralGrid{ false };
+  double                             m_BilateralGridSamplingRate{ 1.0 };
+  typename GridImageType::Pointer    m_BilateralGrid{};
+  FixedArray<double, GridDimension>  m_BilateralGridCellSize{};
+  typename InputImageType::IndexType m_BilateralGridStartIndex{};
+  double                             m_BilateralGridRangeMinimum{};
 };
 } // end namespace itk
 
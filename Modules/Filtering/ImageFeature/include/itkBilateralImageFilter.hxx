@@ -24,6 +24,11 @@
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkTotalProgressReporter.h"
 #include "itkStatisticsImageFilter.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <algorithm>
+#include <mutex>
 
 namespace itk
 {
@@ -123,6 +128,12 @@ template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
 {
+  if (m_UseBilateralGrid)
+  {
+    this->ComputeBilateralGrid();
+    return;
+  }
+
   // Build a small image of the n-dimensional Gaussian used for domain filter
   //
   // Gaussian image size will be (2*std::ceil(2.5*sigma)+1) x
@@ -235,6 +246,12 @@ void
 BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (m_UseBilateralGrid)
+  {
+    this->InterpolateBilateralGrid(outputRegionForThread);
+    return;
+  }
+
   typename TInputImage::ConstPointer   input = this->GetInput();
   typename TOutputImage::Pointer       output = this->GetOutput();
   typename TInputImage::IndexValueType i;
@@ -317,6 +334,247 @@ BilateralImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::AfterThreadedGenerateData()
+{
+  // the grid is only needed while the output is computed
+  m_BilateralGrid = nullptr;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::ComputeBilateralGrid()
+{
+  using InputRegionType = typename InputImageType::RegionType;
+  using GridRegionType = typename GridImageType::RegionType;
+  using GridSizeType = typename GridImageType::SizeType;
+  using GridIndexType = typename GridImageType::IndexType;
+
+  const InputImageType * input = this->GetInput();
+  const InputRegionType  region = input->GetRequestedRegion();
+
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  // Determine the intensity range covered by the grid
+  double     minimum = NumericTraits<double>::max();
+  double     maximum = NumericTraits<double>::NonpositiveMin();
+  std::mutex mutex;
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [input, &minimum, &maximum, &mutex](const InputRegionType & subRegion) {
+      double localMinimum = NumericTraits<double>::max();
+      double localMaximum = NumericTraits<double>::NonpositiveMin();
+      for (ImageRegionConstIterator<InputImageType> it(input, subRegion); !it.IsAtEnd(); ++it)
+      {
+        const auto value = static_cast<double>(it.Get());
+        localMinimum = std::min(localMinimum, value);
+        localMaximum = std::max(localMaximum, value);
+      }
+      const std::lock_guard<std::mutex> lock(mutex);
+      minimum = std::min(minimum, localMinimum);
+      maximum = std::max(maximum, localMaximum);
+    },
+    nullptr);
+  m_DynamicRange = maximum - minimum;
+  m_DynamicRangeUsed = m_RangeMu * m_RangeSigma;
+
+  // The cells are a fraction of the sigmas, and the grid covers the input
+  // requested region and the intensity range, with an extra cell for the
+  // interpolation. The sigmas of the blur are expressed in cells.
+  const typename InputImageType::SpacingType spacing = input->GetSpacing();
+  GridSizeType                               gridSize;
+  FixedArray<double, GridDimension>          gridSigma;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const double sigmaInPixels = m_DomainSigma[d] / spacing[d];
+    m_BilateralGridCellSize[d] = std::max(1.0, sigmaInPixels / m_BilateralGridSamplingRate);
+    gridSigma[d] = sigmaInPixels / m_BilateralGridCellSize[d];
+    gridSize[d] = static_cast<SizeValueType>((region.GetSize(d) - 1) / m_BilateralGridCellSize[d]) + 2;
+  }
+  m_BilateralGridCellSize[ImageDimension] = m_RangeSigma / m_BilateralGridSamplingRate;
+  gridSigma[ImageDimension] = m_BilateralGridSamplingRate;
+  gridSize[ImageDimension] = static_cast<SizeValueType>(m_DynamicRange / m_BilateralGridCellSize[ImageDimension]) + 2;
+  m_BilateralGridStartIndex = region.GetIndex();
+  m_BilateralGridRangeMinimum = minimum;
+
+  m_BilateralGrid = GridImageType::New();
+  m_BilateralGrid->SetRegions(gridSize);
+  m_BilateralGrid->Allocate(true);
+  GridImageType * grid = m_BilateralGrid;
+
+  // Nearest cell of each position along each dimension
+  std::vector<IndexValueType> nearestCell[ImageDimension];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    nearestCell[d].resize(region.GetSize(d));
+    for (SizeValueType i = 0; i < region.GetSize(d); ++i)
+    {
+      nearestCell[d][i] = Math::Floor<IndexValueType>(i / m_BilateralGridCellSize[d] + 0.5);
+    }
+  }
+
+  // Accumulate the pixels in their nearest cell. Each work item processes
+  // the pixels of one slab of cells along the last dimension, so that each
+  // cell is only written by one work unit.
+  constexpr unsigned int              lastDimension = ImageDimension - 1;
+  const std::vector<IndexValueType> & lastDimensionCells = nearestCell[lastDimension];
+  const double                        rangeCellSize = m_BilateralGridCellSize[ImageDimension];
+  multiThreader->ParallelizeArray(
+    0,
+    gridSize[lastDimension],
+    [&](SizeValueType slab) {
+      const auto first =
+        std::lower_bound(lastDimensionCells.cbegin(), lastDimensionCells.cend(), static_cast<IndexValueType>(slab));
+      const auto last = std::upper_bound(first, lastDimensionCells.cend(), static_cast<IndexValueType>(slab));
+      if (first == last)
+      {
+        return;
+      }
+      InputRegionType slabRegion = region;
+      slabRegion.SetIndex(lastDimension, region.GetIndex(lastDimension) + (first - lastDimensionCells.cbegin()));
+      slabRegion.SetSize(lastDimension, last - first);
+
+      for (ImageRegionConstIteratorWithIndex<InputImageType> it(input, slabRegion); !it.IsAtEnd(); ++it)
+      {
+        const auto    value = static_cast<double>(it.Get());
+        GridIndexType gridIndex;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          gridIndex[d] = nearestCell[d][it.GetIndex()[d] - region.GetIndex(d)];
+        }
+        gridIndex[ImageDimension] = Math::Floor<IndexValueType>((value - minimum) / rangeCellSize + 0.5);
+
+        GridPixelType & cell = grid->GetPixel(gridIndex);
+        cell[0] += static_cast<float>(value);
+        cell[1] += 1.0f;
+      }
+    },
+    nullptr);
+
+  // Blur the grid with a Gaussian kernel along each dimension. Out of the
+  // grid, the cells are empty.
+  const GridRegionType gridRegion = grid->GetBufferedRegion();
+  for (unsigned int d = 0; d < GridDimension; ++d)
+  {
+    const double        mu = d < ImageDimension ? m_DomainMu : m_RangeMu;
+    const auto          kernelRadius = static_cast<IndexValueType>(std::ceil(mu * gridSigma[d]));
+    std::vector<double> kernel(2 * kernelRadius + 1);
+    for (IndexValueType k = -kernelRadius; k <= kernelRadius; ++k)
+    {
+      kernel[k + kernelRadius] = std::exp(-0.5 * k * k / (gridSigma[d] * gridSigma[d]));
+    }
+
+    const auto lineLength = static_cast<IndexValueType>(gridSize[d]);
+    multiThreader->template ParallelizeImageRegionRestrictDirection<GridDimension>(
+      d,
+      gridRegion,
+      [grid, d, lineLength, kernelRadius, &kernel](const GridRegionType & lineRegion) {
+        std::vector<GridPixelType>                  line(lineLength);
+        ImageLinearIteratorWithIndex<GridImageType> it(grid, lineRegion);
+        it.SetDirection(d);
+        for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+        {
+          for (IndexValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+          {
+            line[i] = it.Get();
+          }
+          it.GoToBeginOfLine();
+          for (IndexValueType i = 0; !it.IsAtEndOfLine(); ++it, ++i)
+          {
+            double sum = 0.0;
+            double count = 0.0;
+            for (IndexValueType j = std::max(i - kernelRadius, IndexValueType{ 0 });
+                 j <= std::min(i + kernelRadius, lineLength - 1);
+                 ++j)
+            {
+              const double weight = kernel[j - i + kernelRadius];
+              sum += weight * line[j][0];
+              count += weight * line[j][1];
+            }
+            GridPixelType cell;
+            cell[0] = static_cast<float>(sum);
+            cell[1] = static_cast<float>(count);
+            it.Set(cell);
+          }
+        }
+      },
+      nullptr);
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+BilateralImageFilter<TInputImage, TOutputImage>::InterpolateBilateralGrid(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  using GridSizeType = typename GridImageType::SizeType;
+
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  const GridImageType *   grid = m_BilateralGrid;
+  const GridSizeType      gridSize = grid->GetBufferedRegion().GetSize();
+  const OffsetValueType * gridOffsetTable = grid->GetOffsetTable();
+  const GridPixelType *   gridBuffer = grid->GetBufferPointer();
+
+  constexpr unsigned int numberOfCorners = 1u << GridDimension;
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  ImageRegionConstIteratorWithIndex<InputImageType> inIt(input, outputRegionForThread);
+  ImageRegionIterator<OutputImageType>              outIt(output, outputRegionForThread);
+  for (; !outIt.IsAtEnd(); ++inIt, ++outIt)
+  {
+    const auto value = static_cast<double>(inIt.Get());
+
+    // Lower corner of the cell containing the pixel, in space and range,
+    // and interpolation weights of the upper corners
+    OffsetValueType lowerOffset = 0;
+    double          fraction[GridDimension];
+    OffsetValueType step[GridDimension];
+    for (unsigned int d = 0; d < GridDimension; ++d)
+    {
+      const double position =
+        d < ImageDimension
+          ? (inIt.GetIndex()[d] - m_BilateralGridStartIndex[d]) / m_BilateralGridCellSize[d]
+          : (value - m_BilateralGridRangeMinimum) / m_BilateralGridCellSize[ImageDimension];
+      const auto lower = std::clamp(
+        Math::Floor<IndexValueType>(position), IndexValueType{ 0 }, static_cast<IndexValueType>(gridSize[d]) - 1);
+      fraction[d] = std::clamp(position - lower, 0.0, 1.0);
+      step[d] = lower + 1 < static_cast<IndexValueType>(gridSize[d]) ? gridOffsetTable[d] : 0;
+      lowerOffset += lower * gridOffsetTable[d];
+    }
+
+    double sum = 0.0;
+    double count = 0.0;
+    for (unsigned int corner = 0; corner < numberOfCorners; ++corner)
+    {
+      double          weight = 1.0;
+      OffsetValueType offset = lowerOffset;
+      for (unsigned int d = 0; d < GridDimension; ++d)
+      {
+        if (corner & (1u << d))
+        {
+          weight *= fraction[d];
+          offset += step[d];
+        }
+        else
+        {
+          weight *= 1.0 - fraction[d];
+        }
+      }
+      const GridPixelType & cell = gridBuffer[offset];
+      sum += weight * cell[0];
+      count += weight * cell[1];
+    }
+
+    outIt.Set(static_cast<OutputPixelType>(count > 0.0 ? sum / count : value));
+    progress.CompletedPixel();
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
@@ -331,6 +589,8 @@ BilateralImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, In
   os << indent << "Amount of dynamic range used: " << m_DynamicRangeUsed << std::endl;
   os << indent << "AutomaticKernelSize: " << m_AutomaticKernelSize << std::endl;
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "UseBilateralGrid: " << m_UseBilateralGrid << std::endl;
+  os << indent << "BilateralGridSamplingRate: " << m_BilateralGridSamplingRate << std::endl;
 }
 } // end namespace itk
 
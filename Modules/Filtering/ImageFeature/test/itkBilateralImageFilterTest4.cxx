@@ -0,0 +1,119 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBilateralImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Compare the bilateral grid approximation with the exact bilateral filter
+// on a noisy step edge.
+int
+itkBilateralImageFilterTest4(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using ImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::BilateralImageFilter<ImageType, ImageType>;
+
+  auto                      input = ImageType::New();
+  const ImageType::SizeType size = { { 48, 32, 12 } };
+  input->SetRegions(size);
+  input->Allocate();
+
+  constexpr itk::IndexValueType edge = 24;
+  unsigned int                  seed = 3;
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(input, input->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    seed = (seed * 1103515245 + 12345) % 2147483648u;
+    const double noise = static_cast<double>((seed >> 8) % 2001) / 100.0 - 10.0;
+    it.Set(static_cast<float>((it.GetIndex()[0] < edge ? 100.0 : 180.0) + noise));
+  }
+
+  auto exactFilter = FilterType::New();
+  exactFilter->SetInput(input);
+  exactFilter->SetDomainSigma(2.0);
+  exactFilter->SetRangeSigma(20.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(exactFilter->Update());
+
+  auto gridFilter = FilterType::New();
+
+  ITK_TEST_SET_GET_BOOLEAN(gridFilter, UseBilateralGrid, true);
+  ITK_TEST_SET_GET_VALUE(1.0, gridFilter->GetBilateralGridSamplingRate());
+
+  gridFilter->SetInput(input);
+  gridFilter->SetDomainSigma(2.0);
+  gridFilter->SetRangeSigma(20.0);
+  gridFilter->UseBilateralGridOn();
+
+  int result = EXIT_SUCCESS;
+  for (const double samplingRate : { 1.0, 2.0 })
+  {
+    gridFilter->SetBilateralGridSamplingRate(samplingRate);
+    ITK_TEST_SET_GET_VALUE(samplingRate, gridFilter->GetBilateralGridSamplingRate());
+
+    ImageType::Pointer reference;
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+    {
+      gridFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(gridFilter->Update());
+      ImageType::Pointer output = gridFilter->GetOutput();
+
+      double meanError = 0.0;
+      double maximumInputNoise = 0.0;
+      double maximumOutputNoise = 0.0;
+      for (itk::ImageRegionIteratorWithIndex<ImageType> it(output, output->GetLargestPossibleRegion()); !it.IsAtEnd();
+           ++it)
+      {
+        const ImageType::IndexType index = it.GetIndex();
+        meanError += itk::Math::abs(it.Get() - exactFilter->GetOutput()->GetPixel(index));
+
+        // the noise is removed, and the edge preserved
+        const double expected = index[0] < edge ? 100.0 : 180.0;
+        maximumInputNoise = std::max(maximumInputNoise, itk::Math::abs(input->GetPixel(index) - expected));
+        maximumOutputNoise = std::max(maximumOutputNoise, itk::Math::abs(it.Get() - expected));
+
+        // the result does not depend on the number of work units
+        if (reference && itk::Math::NotExactlyEquals(it.Get(), reference->GetPixel(index)))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "The output at " << index << " differs with " << numberOfWorkUnits << " work units"
+                    << std::endl;
+          result = EXIT_FAILURE;
+          break;
+        }
+      }
+      meanError /= output->GetLargestPossibleRegion().GetNumberOfPixels();
+
+      std::cout << "Sampling rate " << samplingRate << ", " << numberOfWorkUnits
+                << " work units: mean difference with the exact filter " << meanError << ", maximum noise "
+                << maximumOutputNoise << " (input " << maximumInputNoise << ")" << std::endl;
+      if (meanError > 2.0 || maximumOutputNoise > 0.75 * maximumInputNoise)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "The bilateral grid approximation is not accurate enough" << std::endl;
+        result = EXIT_FAILURE;
+      }
+
+      reference = output;
+      reference->DisconnectPipeline();
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
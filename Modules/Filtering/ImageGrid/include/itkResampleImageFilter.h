@@ -20,6 +20,7 @@
 
 #include "itkFixedArray.h"
 #include "itkTransform.h"
+#include "itkCompositeTransform.h"
 #include "itkImageRegionIterator.h"
 #include "itkImageToImageFilter.h"
 #include "itkExtrapolateImageFunction.h"
@@ -380,6 +381,10 @@ private:
   DirectionType   m_OutputDirection{};      // output image direction cosines
   IndexType       m_OutputStartIndex{};     // output image start index
   bool            m_UseReferenceImage{ false };
+
+  // Transform mapping the output points during the threaded execution: the
+  // precomposed form of a CompositeTransform, or the transform itself
+  TransformPointerType m_PointTransform{};
 };
 } // end namespace itk
 
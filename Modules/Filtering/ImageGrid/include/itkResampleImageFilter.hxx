@@ -28,6 +28,7 @@
 #include "itkImageAlgorithm.h"
 
 #include <type_traits> // For is_same.
+#include <vector>
 
 namespace itk
 {
@@ -164,6 +165,18 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   m_Interpolator->SetInputImage(this->GetInput());
 
+  // Map the points through a single affine transform for each run of
+  // consecutive linear transforms of a CompositeTransform
+  m_PointTransform = this->GetTransform();
+  if constexpr (InputImageDimension == OutputImageDimension)
+  {
+    using CompositeTransformType = CompositeTransform<TTransformPrecisionType, InputImageDimension>;
+    if (const auto * compositeTransform = dynamic_cast<const CompositeTransformType *>(m_PointTransform.GetPointer()))
+    {
+      m_PointTransform = compositeTransform->GetPrecomposedTransform();
+    }
+  }
+
   // Connect input image to extrapolator
   if (!m_Extrapolator.IsNull())
   {
@@ -193,6 +206,8 @@ void
 ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTransformPrecisionType>::
   AfterThreadedGenerateData()
 {
+  m_PointTransform = nullptr;
+
   // Disconnect input image from the interpolator
   m_Interpolator->SetInputImage(nullptr);
   if (!m_Extrapolator.IsNull())
@@ -370,7 +385,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  const TransformType *  transformPtr = this->GetTransform();
+  const TransformType *  transformPtr = m_PointTransform;
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
@@ -380,45 +395,70 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   const bool isSpecialCoordinatesImage = (dynamic_cast<const InputSpecialCoordinatesImageType *>(inputPtr) != nullptr);
 
 
-  // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
-
-  using OutputType = typename InterpolatorType::OutputType;
+  // The points of a scan line are mapped by a single call to the transform,
+  // which may share its intermediate results between the points, and the
+  // positions which fall inside the input buffer are interpolated in runs.
+  const SizeValueType                                  lineLength = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(lineLength);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(lineLength);
+  std::vector<ContinuousInputIndexType>                inputIndices(lineLength);
+  std::vector<bool>                                    isInside(lineLength);
+  std::vector<InterpolatorOutputType>                  values(lineLength);
 
   // Walk the output region
-  for (OutputIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); ++outIt)
+  for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
-    // Determine the index of the current output pixel
-
-    OutputPointType outputPoint; // Coordinates of current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    const InputPointType inputPoint = transformPtr->TransformPoint(outputPoint);
-
-    ContinuousInputIndexType inputIndex;
-    const bool               isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+    // Determine the coordinates of the output pixels of the scan line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType x = 0; x < lineLength; ++x, ++index[0])
+    {
+      OutputPointType outputPoint; // Coordinates of current output pixel
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+      outputPoints[x] = outputPoint;
+    }
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
+    // Compute corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), transformedPoints.data(), lineLength);
+    for (SizeValueType x = 0; x < lineLength; ++x)
     {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      const InputPointType inputPoint = transformedPoints[x];
+      const bool           isInsideInput =
+        inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndices[x]);
+      isInside[x] = m_Interpolator->IsInsideBuffer(inputIndices[x]) && (!isSpecialCoordinatesImage || isInsideInput);
     }
-    else
+
+    SizeValueType x = 0;
+    while (x < lineLength)
     {
-      if (m_Extrapolator.IsNull())
+      // Evaluate input at right position and copy to the output
+      if (isInside[x])
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        SizeValueType runEnd = x + 1;
+        while (runEnd < lineLength && isInside[runEnd])
+        {
+          ++runEnd;
+        }
+        m_Interpolator->EvaluateAtContinuousIndices(&inputIndices[x], &values[x], runEnd - x);
+        for (; x < runEnd; ++x, ++outIt)
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(values[x]));
+        }
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
+        }
+        else
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[x])));
+        }
+        ++outIt;
+        ++x;
       }
     }
-    progress.CompletedPixel();
+    progress.Completed(lineLength);
   }
 }
 
@@ -432,7 +472,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 {
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  const TransformType *  transformPtr = this->GetTransform();
+  const TransformType *  transformPtr = m_PointTransform;
 
   TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
 
@@ -462,6 +502,12 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  // The positions of a scan line which fall inside the input buffer are
+  // interpolated in runs, with one call to the interpolator per run.
+  const SizeValueType                   lineLength = outputRegionForThread.GetSize(0);
+  std::vector<ContinuousInputIndexType> inputIndices(lineLength);
+  std::vector<InterpolatorOutputType>   values(lineLength);
+
   // Create an iterator that will walk the output region for this thread.
   for (ImageScanlineIterator outIt(outputPtr, outputRegionForThread); !outIt.IsAtEnd(); outIt.NextLine())
   {
@@ -475,26 +521,38 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
     index[0] += firstSizeValueOfLargestPossibleRegion;
     const auto vectorFromStartIndex = transformIndex(index) - startIndex;
 
-    IndexValueType scanlineIndex = outIt.GetIndex()[0];
-
-
-    while (!outIt.IsAtEndOfLine())
+    const IndexValueType firstScanlineIndex = outIt.GetIndex()[0];
+    for (SizeValueType x = 0; x < lineLength; ++x)
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
-      const double alpha =
+      const IndexValueType scanlineIndex = firstScanlineIndex + static_cast<IndexValueType>(x);
+      const double         alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-      ContinuousInputIndexType inputIndex(startIndex);
+      ContinuousInputIndexType & inputIndex = inputIndices[x];
+      inputIndex = startIndex;
       for (unsigned int i = 0; i < InputImageDimension; ++i)
       {
         inputIndex[i] += alpha * vectorFromStartIndex[i];
       }
+    }
 
+    SizeValueType x = 0;
+    while (x < lineLength)
+    {
       // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+      if (m_Interpolator->IsInsideBuffer(inputIndices[x]))
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        SizeValueType runEnd = x + 1;
+        while (runEnd < lineLength && m_Interpolator->IsInsideBuffer(inputIndices[runEnd]))
+        {
+          ++runEnd;
+        }
+        m_Interpolator->EvaluateAtContinuousIndices(&inputIndices[x], &values[x], runEnd - x);
+        for (; x < runEnd; ++x, ++outIt)
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(values[x]));
+        }
       }
       else
       {
@@ -504,12 +562,11 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
         }
         else
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[x])));
         }
+        ++outIt;
+        ++x;
       }
-
-      ++outIt;
-      ++scanlineIndex;
     }
     progress.Completed(outputRegionForThread.GetSize()[0]);
   }
@@ -674,6 +731,7 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
   os << indent << "Interpolator: " << m_Interpolator.GetPointer() << std::endl;
   os << indent << "Extrapolator: " << m_Extrapolator.GetPointer() << std::endl;
   os << indent << "UseReferenceImage: " << (m_UseReferenceImage ? "On" : "Off") << std::endl;
+  os << indent << "PointTransform: " << m_PointTransform.GetPointer() << std::endl;
 }
 } // end namespace itk
 
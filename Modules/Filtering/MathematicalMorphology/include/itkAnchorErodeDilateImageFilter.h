@@ -79,9 +79,12 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
+  /** Sweep the lines of each direction of the kernel decomposition
+   * over the whole requested region. The lines of one direction don't
+   * overlap, so they are processed in parallel, each work unit reusing
+   * its line buffers for all the lines it handles. */
   void
-  DynamicThreadedGenerateData(const InputImageRegionType & outputRegionForThread) override;
+  GenerateData() override;
 
 
   // should be set by the meta filter
@@ -18,21 +18,20 @@
 #ifndef itkAnchorErodeDilateImageFilter_hxx
 #define itkAnchorErodeDilateImageFilter_hxx
 
-
 #include "itkAnchorUtilities.h"
+#include "itkImageAlgorithm.h"
+#include "itkProgressTransformer.h"
+
 namespace itk
 {
 template <typename TImage, typename TKernel, typename TFunction1>
 AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::AnchorErodeDilateImageFilter()
   : m_Boundary(NumericTraits<InputImagePixelType>::ZeroValue())
-{
-  this->DynamicMultiThreadingOn();
-}
+{}
 
 template <typename TImage, typename TKernel, typename TFunction1>
 void
-AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenerateData(
-  const InputImageRegionType & outputRegionForThread)
+AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::GenerateData()
 {
   // check that we are using a decomposable kernel
   if (!this->GetKernel().GetDecomposable())
@@ -42,28 +41,32 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
   // TFunction1 will be < for erosions
   // TFunction2 will be <=
 
-  AnchorLineType AnchorLine;
-
   // the initial version will adopt the methodology of loading a line
   // at a time into a buffer vector, carrying out the opening or
   // closing, and then copy the result to the output. Hopefully this
   // will improve cache performance when working along non raster
   // directions.
 
-  InputImageConstPointer input = this->GetInput();
+  this->AllocateOutputs();
 
-  InputImageRegionType IReg = outputRegionForThread;
+  const InputImageType * input = this->GetInput();
+  InputImageType *       output = this->GetOutput();
+
+  // get the region size
+  const InputImageRegionType OReg = output->GetRequestedRegion();
+
+  // the lines are swept over the whole padded region, so that the
+  // pixels in the padding are only processed once per line direction,
+  // instead of once per work unit
+  InputImageRegionType IReg = OReg;
   IReg.PadByRadius(this->GetKernel().GetRadius());
-  IReg.Crop(this->GetInput()->GetRequestedRegion());
+  IReg.Crop(input->GetRequestedRegion());
 
   // allocate an internal buffer
   auto internalbuffer = InputImageType::New();
   internalbuffer->SetRegions(IReg);
   internalbuffer->Allocate();
-  InputImagePointer output = internalbuffer;
 
-  // get the region size
-  InputImageRegionType OReg = outputRegionForThread;
   // maximum buffer length is sum of dimensions
   unsigned int bufflength = 0;
   for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
@@ -74,21 +77,22 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
   // compat
   bufflength += 2;
 
-  std::vector<InputImagePixelType> buffer(bufflength);
-  std::vector<InputImagePixelType> inbuffer(bufflength);
-
   // iterate over all the structuring elements
-  typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
-  BresType                        BresLine;
+  const typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
+  BresType                              BresLine;
 
-  for (unsigned int i = 0; i < decomposition.size(); ++i)
-  {
-    typename KernelType::LType     ThisLine = decomposition[i];
-    typename BresType::OffsetArray TheseOffsets = BresLine.BuildLine(ThisLine, bufflength);
+  using KernelLType = typename KernelType::LType;
 
-    using KernelLType = typename KernelType::LType;
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
-    unsigned int SELength = GetLinePixels<KernelLType>(ThisLine);
+  const InputImageType * lineInput = input;
+  const auto             numberOfLines = static_cast<float>(decomposition.size());
+  for (unsigned int i = 0; i < decomposition.size(); ++i)
+  {
+    const KernelLType                    ThisLine = decomposition[i];
+    const typename BresType::OffsetArray TheseOffsets = BresLine.BuildLine(ThisLine, bufflength);
+    unsigned int                         SELength = GetLinePixels<KernelLType>(ThisLine);
 
     // want lines to be odd
     if (!(SELength % 2))
@@ -96,24 +100,40 @@ AnchorErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenera
       ++SELength;
     }
 
-    InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
-
-    AnchorLine.SetSize(SELength);
+    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(lineInput, IReg, ThisLine);
+
+    // each line starting in the face covers a distinct set of pixels,
+    // so the face can be split between the work units and the lines
+    // updated in place after the first pass
+    ProgressTransformer progress(i / numberOfLines, (i + 1) / numberOfLines, this);
+    multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+      BigFace,
+      [&](const InputImageRegionType & faceRegion) {
+        std::vector<InputImagePixelType> buffer(bufflength);
+        std::vector<InputImagePixelType> inbuffer(bufflength);
+
+        AnchorLineType AnchorLine;
+        AnchorLine.SetSize(SELength);
+
+        DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(lineInput,
+                                                                    internalbuffer.GetPointer(),
+                                                                    m_Boundary,
+                                                                    ThisLine,
+                                                                    AnchorLine,
+                                                                    TheseOffsets,
+                                                                    inbuffer,
+                                                                    buffer,
+                                                                    IReg,
+                                                                    faceRegion);
+      },
+      progress.GetProcessObject());
 
-    DoAnchorFace<TImage, BresType, AnchorLineType, KernelLType>(
-      input, output, m_Boundary, ThisLine, AnchorLine, TheseOffsets, inbuffer, buffer, IReg, BigFace);
     // after the first pass the input will be taken from the output
-    input = internalbuffer;
+    lineInput = internalbuffer;
   }
 
   // copy internal buffer to output
-  using IterType = ImageRegionIterator<InputImageType>;
-  IterType oit(this->GetOutput(), OReg);
-  IterType iit(internalbuffer, OReg);
-  for (oit.GoToBegin(), iit.GoToBegin(); !oit.IsAtEnd(); ++oit, ++iit)
-  {
-    oit.Set(iit.Get());
-  }
+  ImageAlgorithm::Copy(lineInput, output, OReg, OReg);
 }
 
 template <typename TImage, typename TKernel, typename TFunction1>
@@ -33,13 +33,13 @@ namespace itk
  */
 template <typename TImage, typename TBres, typename TLine>
 int
-ComputeStartEnd(const typename TImage::IndexType  StartIndex,
-                const TLine                       line,
-                const float                       tol,
-                const typename TBres::OffsetArray LineOffsets,
-                const typename TImage::RegionType AllImage,
-                unsigned int &                    start,
-                unsigned int &                    end);
+ComputeStartEnd(const typename TImage::IndexType    StartIndex,
+                const TLine                         line,
+                const float                         tol,
+                const typename TBres::OffsetArray & LineOffsets,
+                const typename TImage::RegionType   AllImage,
+                unsigned int &                      start,
+                unsigned int &                      end);
 
 template <typename TImage, typename TBres, typename TAnchor, typename TLine>
 void
@@ -48,7 +48,7 @@ DoAnchorFace(const TImage *                            input,
              typename TImage::PixelType                border,
              TLine                                     line,
              TAnchor &                                 AnchorLine,
-             typename TBres::OffsetArray               LineOffsets,
+             const typename TBres::OffsetArray &       LineOffsets,
              std::vector<typename TImage::PixelType> & inbuffer,
              std::vector<typename TImage::PixelType> & outbuffer,
              const typename TImage::RegionType         AllImage,
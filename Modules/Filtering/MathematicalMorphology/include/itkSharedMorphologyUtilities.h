@@ -29,21 +29,21 @@ NeedToDoFace(const TRegion AllImage, const TRegion face, const TLine line);
 
 template <typename TImage, typename TBres, typename TLine>
 int
-ComputeStartEnd(const typename TImage::IndexType  StartIndex,
-                const TLine                       line,
-                const float                       tol,
-                const typename TBres::OffsetArray LineOffsets,
-                const typename TImage::RegionType AllImage,
-                unsigned int &                    start,
-                unsigned int &                    end);
+ComputeStartEnd(const typename TImage::IndexType    StartIndex,
+                const TLine                         line,
+                const float                         tol,
+                const typename TBres::OffsetArray & LineOffsets,
+                const typename TImage::RegionType   AllImage,
+                unsigned int &                      start,
+                unsigned int &                      end);
 
 template <typename TImage, typename TBres, typename TLine>
 int
-FillLineBuffer(typename TImage::ConstPointer             input,
+FillLineBuffer(const TImage *                            input,
                const typename TImage::IndexType          StartIndex,
                const TLine                               line,
                const float                               tol,
-               const typename TBres::OffsetArray         LineOffsets,
+               const typename TBres::OffsetArray &       LineOffsets,
                const typename TImage::RegionType         AllImage,
                std::vector<typename TImage::PixelType> & inbuffer,
                unsigned int &                            start,
@@ -51,9 +51,9 @@ FillLineBuffer(typename TImage::ConstPointer             input,
 
 template <typename TImage, typename TBres>
 void
-CopyLineToImage(const typename TImage::Pointer            output,
+CopyLineToImage(TImage *                                  output,
                 const typename TImage::IndexType          StartIndex,
-                const typename TBres::OffsetArray         LineOffsets,
+                const typename TBres::OffsetArray &       LineOffsets,
                 std::vector<typename TImage::PixelType> & outbuffer,
                 const unsigned int                        start,
                 const unsigned int                        end);
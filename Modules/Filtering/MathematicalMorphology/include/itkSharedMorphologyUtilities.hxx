@@ -81,13 +81,13 @@ NeedToDoFace(const TRegion AllImage, const TRegion face, const TLine line)
 
 template <typename TImage, typename TBres, typename TLine>
 int
-ComputeStartEnd(const typename TImage::IndexType  StartIndex,
-                const TLine                       line,
-                const float                       tol,
-                const typename TBres::OffsetArray LineOffsets,
-                const typename TImage::RegionType AllImage,
-                unsigned int &                    start,
-                unsigned int &                    end)
+ComputeStartEnd(const typename TImage::IndexType    StartIndex,
+                const TLine                         line,
+                const float                         tol,
+                const typename TBres::OffsetArray & LineOffsets,
+                const typename TImage::RegionType   AllImage,
+                unsigned int &                      start,
+                unsigned int &                      end)
 {
   // compute intersection between ray and box
   typename TImage::IndexType ImStart = AllImage.GetIndex();
@@ -270,9 +270,9 @@ ComputeStartEnd(const typename TImage::IndexType  StartIndex,
 
 template <typename TImage, typename TBres>
 void
-CopyLineToImage(const typename TImage::Pointer            output,
+CopyLineToImage(TImage *                                  output,
                 const typename TImage::IndexType          StartIndex,
-                const typename TBres::OffsetArray         LineOffsets,
+                const typename TBres::OffsetArray &       LineOffsets,
                 std::vector<typename TImage::PixelType> & outbuffer,
                 const unsigned int                        start,
                 const unsigned int                        end)
@@ -289,9 +289,9 @@ CopyLineToImage(const typename TImage::Pointer            output,
 
 template <typename TInputImage, typename TLine>
 typename TInputImage::RegionType
-MakeEnlargedFace(const typename TInputImage::ConstPointer itkNotUsed(input),
-                 const typename TInputImage::RegionType   AllImage,
-                 const TLine                              line)
+MakeEnlargedFace(const TInputImage *                    itkNotUsed(input),
+                 const typename TInputImage::RegionType AllImage,
+                 const TLine                            line)
 {
   // the face list calculator strategy fails in multithreaded mode
   // with 1D kernels
@@ -420,11 +420,11 @@ MakeEnlargedFace(const typename TInputImage::ConstPointer itkNotUsed(input),
 
 template <typename TImage, typename TBres, typename TLine>
 int
-FillLineBuffer(typename TImage::ConstPointer             input,
+FillLineBuffer(const TImage *                            input,
                const typename TImage::IndexType          StartIndex,
                const TLine                               line, // unit vector
                const float                               tol,
-               const typename TBres::OffsetArray         LineOffsets,
+               const typename TBres::OffsetArray &       LineOffsets,
                const typename TImage::RegionType         AllImage,
                std::vector<typename TImage::PixelType> & inbuffer,
                unsigned int &                            start,
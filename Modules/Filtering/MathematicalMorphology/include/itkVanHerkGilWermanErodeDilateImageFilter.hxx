@@ -19,6 +19,8 @@
 #define itkVanHerkGilWermanErodeDilateImageFilter_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageAlgorithm.h"
+#include "itkProgressTransformer.h"
 
 #include "itkVanHerkGilWermanUtilities.h"
 
@@ -27,15 +29,11 @@ namespace itk
 template <typename TImage, typename TKernel, typename TFunction1>
 VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::VanHerkGilWermanErodeDilateImageFilter()
   : m_Boundary(NumericTraits<InputImagePixelType>::ZeroValue())
-{
-  this->DynamicMultiThreadingOn();
-  this->ThreaderUpdateProgressOff();
-}
+{}
 
 template <typename TImage, typename TKernel, typename TFunction1>
 void
-VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThreadedGenerateData(
-  const InputImageRegionType & outputRegionForThread)
+VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::GenerateData()
 {
   // check that we are using a decomposable kernel
   if (!this->GetKernel().GetDecomposable())
@@ -51,25 +49,26 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
   // will improve cache performance when working along non raster
   // directions.
 
-  InputImageConstPointer input = this->GetInput();
+  this->AllocateOutputs();
 
-  SizeValueType totalPixels =
-    this->GetKernel().GetLines().size() * this->GetOutput()->GetRequestedRegion().GetNumberOfPixels();
-  TotalProgressReporter progress(this, totalPixels);
+  const InputImageType * input = this->GetInput();
+  InputImageType *       output = this->GetOutput();
+
+  // get the region size
+  const InputImageRegionType OReg = output->GetRequestedRegion();
 
-  InputImageRegionType IReg = outputRegionForThread;
+  // the lines are swept over the whole padded region, so that the
+  // pixels in the padding are only processed once per line direction,
+  // instead of once per work unit
+  InputImageRegionType IReg = OReg;
   IReg.PadByRadius(this->GetKernel().GetRadius());
-  // IReg.PadByRadius( this->GetKernel().GetRadius() );
-  IReg.Crop(this->GetInput()->GetRequestedRegion());
+  IReg.Crop(input->GetRequestedRegion());
 
   // allocate an internal buffer
   auto internalbuffer = InputImageType::New();
   internalbuffer->SetRegions(IReg);
   internalbuffer->Allocate();
-  InputImagePointer output = internalbuffer;
 
-  // get the region size
-  InputImageRegionType OReg = outputRegionForThread;
   // maximum buffer length is sum of dimensions
   unsigned int bufflength = 0;
   for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
@@ -80,38 +79,61 @@ VanHerkGilWermanErodeDilateImageFilter<TImage, TKernel, TFunction1>::DynamicThre
   // compat
   bufflength += 2;
 
-  std::vector<InputImagePixelType> buffer(bufflength);
-  std::vector<InputImagePixelType> forward(bufflength);
-  std::vector<InputImagePixelType> reverse(bufflength);
   // iterate over all the structuring elements
-  typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
-  BresType                        BresLine;
+  const typename KernelType::DecompType decomposition = this->GetKernel().GetLines();
+  BresType                              BresLine;
 
   using KernelLType = typename KernelType::LType;
 
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+  const InputImageType * lineInput = input;
+  const auto             numberOfLines = static_cast<float>(decomposition.size());
   for (unsigned int i = 0; i < decomposition.size(); ++i)
   {
-    typename KernelType::LType     ThisLine = decomposition[i];
-    typename BresType::OffsetArray TheseOffsets = BresLine.BuildLine(ThisLine, bufflength);
-    unsigned int                   SELength = GetLinePixels<KernelLType>(ThisLine);
+    const KernelLType                    ThisLine = decomposition[i];
+    const typename BresType::OffsetArray TheseOffsets = BresLine.BuildLine(ThisLine, bufflength);
+    unsigned int                         SELength = GetLinePixels<KernelLType>(ThisLine);
     // want lines to be odd
     if (!(SELength % 2))
     {
       ++SELength;
     }
 
-    InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(input, IReg, ThisLine);
-
-    DoFace<TImage, BresType, TFunction1, KernelLType>(
-      input, output, m_Boundary, ThisLine, TheseOffsets, SELength, buffer, forward, reverse, IReg, BigFace);
+    const InputImageRegionType BigFace = MakeEnlargedFace<InputImageType, KernelLType>(lineInput, IReg, ThisLine);
+
+    // each line starting in the face covers a distinct set of pixels,
+    // so the face can be split between the work units and the lines
+    // updated in place after the first pass
+    ProgressTransformer progress(i / numberOfLines, (i + 1) / numberOfLines, this);
+    multiThreader->template ParallelizeImageRegion<InputImageDimension>(
+      BigFace,
+      [&](const InputImageRegionType & faceRegion) {
+        std::vector<InputImagePixelType> buffer(bufflength);
+        std::vector<InputImagePixelType> forward(bufflength);
+        std::vector<InputImagePixelType> reverse(bufflength);
+
+        DoFace<TImage, BresType, TFunction1, KernelLType>(lineInput,
+                                                          internalbuffer.GetPointer(),
+                                                          m_Boundary,
+                                                          ThisLine,
+                                                          TheseOffsets,
+                                                          SELength,
+                                                          buffer,
+                                                          forward,
+                                                          reverse,
+                                                          IReg,
+                                                          faceRegion);
+      },
+      progress.GetProcessObject());
 
     // after the first pass the input will be taken from the output
-    input = internalbuffer;
-    progress.Completed(IReg.GetNumberOfPixels());
+    lineInput = internalbuffer;
   }
 
   // copy internal buffer to output
-  ImageAlgorithm::Copy(input.GetPointer(), this->GetOutput(), OReg, OReg);
+  ImageAlgorithm::Copy(lineInput, output, OReg, OReg);
 }
 
 template <typename TImage, typename TKernel, typename TFunction1>
@@ -47,11 +47,11 @@ FillForwardExt(std::vector<PixelType> & pixbuffer,
 
 template <typename TImage, typename TBres, typename TFunction, typename TLine>
 void
-DoFace(typename TImage::ConstPointer             input,
-       typename TImage::Pointer                  output,
+DoFace(const TImage *                            input,
+       TImage *                                  output,
        typename TImage::PixelType                border,
        TLine                                     line,
-       const typename TBres::OffsetArray         LineOffsets,
+       const typename TBres::OffsetArray &       LineOffsets,
        const unsigned int                        KernLen,
        std::vector<typename TImage::PixelType> & pixbuffer,
        std::vector<typename TImage::PixelType> & fExtBuffer,
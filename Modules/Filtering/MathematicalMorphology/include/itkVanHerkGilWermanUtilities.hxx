@@ -21,6 +21,7 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include "itkIndexRange.h"
 
 namespace itk
 {
@@ -114,11 +115,11 @@ FillReverseExt(std::vector<PixelType> & pixbuffer,
 
 template <typename TImage, typename TBres, typename TFunction, typename TLine>
 void
-DoFace(typename TImage::ConstPointer             input,
-       typename TImage::Pointer                  output,
+DoFace(const TImage *                            input,
+       TImage *                                  output,
        typename TImage::PixelType                border,
        TLine                                     line,
-       const typename TBres::OffsetArray         LineOffsets,
+       const typename TBres::OffsetArray &       LineOffsets,
        const unsigned int                        KernLen,
        std::vector<typename TImage::PixelType> & pixbuffer,
        std::vector<typename TImage::PixelType> & fExtBuffer,
@@ -126,31 +127,17 @@ DoFace(typename TImage::ConstPointer             input,
        const typename TImage::RegionType         AllImage,
        const typename TImage::RegionType         face)
 {
-  // iterate over the face
-
-  // we can't use an iterator with a region outside the image. All we need here
-  // is to
-  // iterate over all the indexes of the face, without accessing the content of
-  // the image.
-  // I can't find any cleaner way, so we use a dumb image, not even allocated,
-  // to iterate
-  // over all the indexes inside the region.
-  //
-  // using ItType = ImageRegionConstIteratorWithIndex<TImage>;
-  // ItType it(input, face);
-
-  auto dumbImg = TImage::New();
-  dumbImg->SetRegions(face);
-
+  // iterate over all the indexes of the face. The face generally lies
+  // partly outside the image, so only the indexes are visited, without
+  // accessing any pixel.
   TLine NormLine = line;
   NormLine.Normalize();
   // set a generous tolerance
   float     tol = 1.0 / LineOffsets.size();
   TFunction m_TF;
-  for (unsigned int it = 0; it < face.GetNumberOfPixels(); ++it)
+  for (const typename TImage::IndexType & Ind : ImageRegionIndexRange<TImage::ImageDimension>(face))
   {
-    typename TImage::IndexType Ind = dumbImg->ComputeIndex(it);
-    unsigned int               start, end;
+    unsigned int start, end;
     if (FillLineBuffer<TImage, TBres, TLine>(input, Ind, NormLine, tol, LineOffsets, AllImage, pixbuffer, start, end))
     {
       const unsigned int len = end - start + 1;
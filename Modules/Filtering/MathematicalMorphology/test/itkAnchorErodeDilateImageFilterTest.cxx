@@ -17,7 +17,10 @@
  *=========================================================================*/
 
 #include "itkAnchorErodeDilateImageFilter.h"
+#include "itkBasicErodeImageFilter.h"
 #include "itkFlatStructuringElement.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkTestingMacros.h"
 
 
@@ -43,6 +46,93 @@ itkAnchorErodeDilateImageFilterTest(int, char ** const)
   ITK_TEST_SET_GET_VALUE(boundary, filter->GetBoundary());
 
 
+  // Compare an erosion of a pseudo random image with the one computed by
+  // the brute force implementation, for different numbers of work units
+  auto                      image = ImageType::New();
+  const ImageType::SizeType size = { { 67, 45 } };
+  image->SetRegions(size);
+  image->Allocate();
+  unsigned int seed = 1;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    seed = (seed * 1103515245 + 12345) % 2147483648u;
+    it.Set(static_cast<PixelType>(seed % 256));
+  }
+
+  using BasicFilterType = itk::BasicErodeImageFilter<ImageType, ImageType, KernelType>;
+  auto basicFilter = BasicFilterType::New();
+  basicFilter->SetInput(image);
+
+  filter->SetInput(image);
+  filter->SetBoundary(itk::NumericTraits<PixelType>::max());
+
+  // A box kernel is decomposed into axis aligned lines. A polygon kernel of
+  // isotropic radius is decomposed into axis aligned and diagonal lines, whose
+  // Bresenham lines have no gaps, so the decomposition is exactly the kernel
+  // wherever the kernel lies within the image. Closer to the border the lines
+  // are clipped differently than the neighborhood of the brute force
+  // implementation, so there the results must match those of one work unit.
+  KernelType::RadiusType boxRadius;
+  boxRadius[0] = 4;
+  boxRadius[1] = 3;
+  KernelType::RadiusType polygonRadius;
+  polygonRadius.Fill(3);
+  ImageType::RegionType polygonInterior = image->GetLargestPossibleRegion();
+  polygonInterior.ShrinkByRadius(polygonRadius);
+  const std::vector<std::pair<KernelType, ImageType::RegionType>> kernelsAndRegions = {
+    { KernelType::Box(boxRadius), image->GetLargestPossibleRegion() },
+    { KernelType::Polygon(polygonRadius, 4), polygonInterior }
+  };
+  for (const auto & kernelAndRegion : kernelsAndRegions)
+  {
+    const KernelType &            kernel = kernelAndRegion.first;
+    const ImageType::RegionType & bruteForceRegion = kernelAndRegion.second;
+
+    basicFilter->SetKernel(kernel);
+    ITK_TRY_EXPECT_NO_EXCEPTION(basicFilter->Update());
+
+    filter->SetKernel(kernel);
+    ImageType::Pointer singleWorkUnitOutput;
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3, 8 })
+    {
+      filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      filter->Modified();
+      ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+
+      const ImageType * output = filter->GetOutput();
+      for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, image->GetLargestPossibleRegion());
+           !it.IsAtEnd();
+           ++it)
+      {
+        const ImageType::IndexType index = it.GetIndex();
+        PixelType                  expected = it.Get();
+        if (bruteForceRegion.IsInside(index))
+        {
+          expected = basicFilter->GetOutput()->GetPixel(index);
+        }
+        else if (singleWorkUnitOutput)
+        {
+          expected = singleWorkUnitOutput->GetPixel(index);
+        }
+        if (itk::Math::NotExactlyEquals(it.Get(), expected))
+        {
+          std::cerr << "Test failed!" << std::endl;
+          std::cerr << "Error in erosion by a kernel of " << kernel.GetLines().size() << " lines with "
+                    << numberOfWorkUnits << " work units at index " << index << ": expected " << expected
+                    << ", but got " << it.Get() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      if (!singleWorkUnitOutput)
+      {
+        singleWorkUnitOutput = filter->GetOutput();
+        singleWorkUnitOutput->DisconnectPipeline();
+      }
+    }
+  }
+
+
   std::cout << "Test finished." << std::endl;
   return EXIT_SUCCESS;
 }
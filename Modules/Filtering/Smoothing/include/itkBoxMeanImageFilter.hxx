@@ -44,8 +44,8 @@ void
 BoxMeanImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  // Accumulate type is too small
-  using AccPixType = typename NumericTraits<PixelType>::RealType;
+  // Accumulate exactly in integers when possible, in the real type otherwise
+  using AccPixType = BoxAccumulateValueType<PixelType>;
   using AccumImageType = Image<AccPixType, TInputImage::ImageDimension>;
 
   typename TInputImage::SizeType internalRadius;
@@ -45,8 +45,8 @@ void
 BoxSigmaImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
-  // Accumulate type is too small
-  using AccValueType = typename itk::NumericTraits<PixelType>::RealType;
+  // Accumulate exactly in integers when possible, in the real type otherwise
+  using AccValueType = BoxAccumulateValueType<PixelType, true>;
   using AccPixType = typename itk::Vector<AccValueType, 2>;
   using AccumImageType = typename itk::Image<AccPixType, TInputImage::ImageDimension>;
 
@@ -28,6 +28,9 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkShapedNeighborhoodIterator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "itkImageScanlineIterator.h"
+
+#include <type_traits>
 
 /*
  *
@@ -94,10 +97,74 @@ setConnectivityEarlyBox(TIterator * it, bool fullyConnected = false)
 namespace itk
 {
 
+/** Value type of the accumulation images of the box filters. Integer
+ * pixels of at most 16 bits are accumulated exactly in 64-bit integers,
+ * and so are their squares for 8-bit pixels; the other pixels are
+ * accumulated in their real type. With an exact accumulation, the sum
+ * over a box does not depend on its position in the image. */
+template <typename TPixel, bool VSquares = false>
+using BoxAccumulateValueType =
+  std::conditional_t<std::is_integral<TPixel>::value && (sizeof(TPixel) <= (VSquares ? 1 : 2)),
+                     int64_t,
+                     typename NumericTraits<TPixel>::RealType>;
+
+/** Turn the values of image over region into their cumulative sums (the
+ * summed-area table), with one scan per dimension: a running sum along
+ * each line of the first dimension, then, for each of the following
+ * dimensions, the addition of the previous slice to each slice. All the
+ * scans go through the memory in order. */
+template <typename TImage>
+void
+BoxCumulativeSumFunction(TImage * image, const typename TImage::RegionType & region)
+{
+  using PixelType = typename TImage::PixelType;
+  using RegionType = typename TImage::RegionType;
+
+  for (ImageScanlineIterator<TImage> it(image, region); !it.IsAtEnd(); it.NextLine())
+  {
+    PixelType sum = NumericTraits<PixelType>::ZeroValue();
+    for (; !it.IsAtEndOfLine(); ++it)
+    {
+      sum += it.Get();
+      it.Set(sum);
+    }
+  }
+
+  for (unsigned int d = 1; d < TImage::ImageDimension; ++d)
+  {
+    if (region.GetSize(d) < 2)
+    {
+      continue;
+    }
+    // the previous slice is always complete when it is added, as it is
+    // before the current one in memory
+    RegionType currentRegion = region;
+    currentRegion.SetIndex(d, region.GetIndex(d) + 1);
+    currentRegion.SetSize(d, region.GetSize(d) - 1);
+    RegionType previousRegion = currentRegion;
+    previousRegion.SetIndex(d, region.GetIndex(d));
+
+    ImageScanlineIterator<TImage>      it(image, currentRegion);
+    ImageScanlineConstIterator<TImage> previousIt(image, previousRegion);
+    for (; !it.IsAtEnd(); it.NextLine(), previousIt.NextLine())
+    {
+      for (; !it.IsAtEndOfLine(); ++it, ++previousIt)
+      {
+        it.Set(it.Get() + previousIt.Get());
+      }
+    }
+  }
+}
+
+/** Compute the accumulation image of inputImage over inputRegion into
+ * outputImage over outputRegion, which must have the same size. The
+ * accumulation image can be used by BoxMeanCalculatorFunction with any
+ * radius, provided that the output region of the calculator, padded by
+ * the radius plus one, is within the accumulated region. */
 template <typename TInputImage, typename TOutputImage>
 void
 BoxAccumulateFunction(const TInputImage *               inputImage,
-                      const TOutputImage *              outputImage,
+                      TOutputImage *                    outputImage,
                       typename TInputImage::RegionType  inputRegion,
                       typename TOutputImage::RegionType outputRegion
 #if defined(ITKV4_COMPATIBILITY)
@@ -107,65 +174,22 @@ BoxAccumulateFunction(const TInputImage *               inputImage,
 )
 #endif
 {
-  // type alias
-  using InputImageType = TInputImage;
-  using OffsetType = typename TInputImage::OffsetType;
-  using OutputImageType = TOutputImage;
   using OutputPixelType = typename TOutputImage::PixelType;
 
-  using InputIterator = ImageRegionConstIterator<TInputImage>;
-
-  using NOutputIterator = ShapedNeighborhoodIterator<TOutputImage>;
-  InputIterator                  inIt(inputImage, inputRegion);
-  typename TInputImage::SizeType kernelRadius;
-  kernelRadius.Fill(1);
-
-  NOutputIterator noutIt(kernelRadius, outputImage, outputRegion);
-  // this iterator is fully connected
-  itk_impl_details::setConnectivityEarlyBox(&noutIt, true);
-
-  ConstantBoundaryCondition<OutputImageType> oBC;
-  oBC.SetConstant(NumericTraits<OutputPixelType>::ZeroValue());
-  noutIt.OverrideBoundaryCondition(&oBC);
-  // This uses several iterators. An alternative and probably better
-  // approach would be to copy the input to the output and convolve
-  // with the following weights (in 2D)
-  //   -(dim - 1)  1
-  //       1       1
-  // The result of each convolution needs to get written back to the
-  // image being convolved so that the accumulation propagates
-  // This should be implementable with neighborhood operators.
-
-  std::vector<int>                        weights;
-  typename NOutputIterator::ConstIterator sIt;
-  for (auto idxIt = noutIt.GetActiveIndexList().begin(); idxIt != noutIt.GetActiveIndexList().end(); ++idxIt)
+  ImageScanlineConstIterator<TInputImage> inIt(inputImage, inputRegion);
+  ImageScanlineIterator<TOutputImage>     outIt(outputImage, outputRegion);
+  for (; !outIt.IsAtEnd(); inIt.NextLine(), outIt.NextLine())
   {
-    OffsetType offset = noutIt.GetOffset(*idxIt);
-    int        w = -1;
-    for (unsigned int k = 0; k < InputImageType::ImageDimension; ++k)
+    for (; !outIt.IsAtEndOfLine(); ++inIt, ++outIt)
     {
-      if (offset[k] != 0)
-      {
-        w *= offset[k];
-      }
-    }
-    //     std::cout << offset << "  " << w << std::endl;
-    weights.push_back(w);
-  }
-
-  for (inIt.GoToBegin(), noutIt.GoToBegin(); !noutIt.IsAtEnd(); ++inIt, ++noutIt)
-  {
-    OutputPixelType sum = 0;
-    int             k;
-    for (k = 0, sIt = noutIt.Begin(); !sIt.IsAtEnd(); ++sIt, ++k)
-    {
-      sum += sIt.Get() * weights[k];
-    }
-    noutIt.SetCenterPixel(sum + inIt.Get());
+      outIt.Set(static_cast<OutputPixelType>(inIt.Get()));
 #if defined(ITKV4_COMPATIBILITY)
-    progress.CompletedPixel();
+      progress.CompletedPixel();
 #endif
+    }
   }
+
+  BoxCumulativeSumFunction(outputImage, outputRegion);
 }
 
 // a function to generate corners of arbitrary dimension box
@@ -245,10 +269,13 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
   }
 
   using AccPixType = typename NumericTraits<OutputPixelType>::RealType;
+  // the sums over the boxes are computed in the type of the accumulation,
+  // so that they are exact when the accumulation is exact
+  using SumType = typename InputImageType::PixelType;
   // get a set of offsets to corners for a unit hypercube in this image
   std::vector<OffsetType> unitCorners = CornerOffsets<TInputImage>(accImage);
   std::vector<OffsetType> realCorners;
-  std::vector<AccPixType> weights;
+  std::vector<SumType>    weights;
   // now compute the weights
   for (unsigned int k = 0; k < unitCorners.size(); ++k)
   {
@@ -266,7 +293,7 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
         thisCorner[i] = -(static_cast<OffsetValueType>(radius[i]) + 1);
       }
     }
-    weights.push_back((AccPixType)prod);
+    weights.push_back(static_cast<SumType>(prod));
     realCorners.push_back(thisCorner);
   }
 
@@ -304,7 +331,7 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
       // now do the work
       for (oIt.GoToBegin(); !oIt.IsAtEnd(); ++oIt)
       {
-        AccPixType sum = 0;
+        SumType sum{};
         // check each corner
         for (unsigned int k = 0; k < cornerItVec.size(); ++k)
         {
@@ -312,7 +339,7 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
           // increment each corner iterator
           ++(cornerItVec[k]);
         }
-        oIt.Set(static_cast<OutputPixelType>(sum / pixelscount));
+        oIt.Set(static_cast<OutputPixelType>(static_cast<AccPixType>(sum) / pixelscount));
 #if defined(ITKV4_COMPATIBILITY)
         progress.CompletedPixel();
 #endif
@@ -341,7 +368,7 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
         currentKernelRegion.SetIndex(kernelRegionIdx);
         currentKernelRegion.Crop(inputRegion);
         OffsetValueType edgepixelscount = currentKernelRegion.GetNumberOfPixels();
-        AccPixType      sum = 0;
+        SumType         sum{};
         // rules are : for each corner,
         //               for each dimension
         //                  if dimension offset is positive -> this is
@@ -380,7 +407,7 @@ BoxMeanCalculatorFunction(const TInputImage *               accImage,
           }
         }
 
-        oIt.Set(static_cast<OutputPixelType>(sum / (AccPixType)edgepixelscount));
+        oIt.Set(static_cast<OutputPixelType>(static_cast<AccPixType>(sum) / (AccPixType)edgepixelscount));
 #if defined(ITKV4_COMPATIBILITY)
         progress.CompletedPixel();
 #endif
@@ -433,10 +460,13 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
   }
 
   using AccPixType = typename NumericTraits<OutputPixelType>::RealType;
+  // the sums over the boxes are computed in the type of the accumulation,
+  // so that they are exact when the accumulation is exact
+  using SumType = typename InputPixelType::ValueType;
   // get a set of offsets to corners for a unit hypercube in this image
   std::vector<OffsetType> unitCorners = CornerOffsets<TInputImage>(accImage);
   std::vector<OffsetType> realCorners;
-  std::vector<AccPixType> weights;
+  std::vector<SumType>    weights;
   // now compute the weights
   for (unsigned int k = 0; k < unitCorners.size(); ++k)
   {
@@ -454,7 +484,7 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
         thisCorner[i] = -(static_cast<OffsetValueType>(radius[i]) + 1);
       }
     }
-    weights.push_back((AccPixType)prod);
+    weights.push_back(static_cast<SumType>(prod));
     realCorners.push_back(thisCorner);
   }
 
@@ -492,8 +522,8 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
       // now do the work
       for (oIt.GoToBegin(); !oIt.IsAtEnd(); ++oIt)
       {
-        AccPixType sum = 0;
-        AccPixType squareSum = 0;
+        SumType sum{};
+        SumType squareSum{};
         // check each corner
         for (unsigned int k = 0; k < cornerItVec.size(); ++k)
         {
@@ -504,7 +534,9 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
           ++(cornerItVec[k]);
         }
 
-        oIt.Set(static_cast<OutputPixelType>(std::sqrt((squareSum - sum * sum / pixelscount) / (pixelscount - 1))));
+        const auto realSum = static_cast<AccPixType>(sum);
+        oIt.Set(static_cast<OutputPixelType>(
+          std::sqrt((static_cast<AccPixType>(squareSum) - realSum * realSum / pixelscount) / (pixelscount - 1))));
 #if defined(ITKV4_COMPATIBILITY)
         progress.CompletedPixel();
 #endif
@@ -533,8 +565,8 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
         currentKernelRegion.SetIndex(kernelRegionIdx);
         currentKernelRegion.Crop(inputRegion);
         SizeValueType edgepixelscount = currentKernelRegion.GetNumberOfPixels();
-        AccPixType    sum = 0;
-        AccPixType    squareSum = 0;
+        SumType       sum{};
+        SumType       squareSum{};
         // rules are : for each corner,
         //               for each dimension
         //                  if dimension offset is positive -> this is
@@ -575,8 +607,9 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
           }
         }
 
-        oIt.Set(
-          static_cast<OutputPixelType>(std::sqrt((squareSum - sum * sum / edgepixelscount) / (edgepixelscount - 1))));
+        const auto realSum = static_cast<AccPixType>(sum);
+        oIt.Set(static_cast<OutputPixelType>(std::sqrt(
+          (static_cast<AccPixType>(squareSum) - realSum * realSum / edgepixelscount) / (edgepixelscount - 1))));
 #if defined(ITKV4_COMPATIBILITY)
         progress.CompletedPixel();
 #endif
@@ -585,6 +618,9 @@ BoxSigmaCalculatorFunction(const TInputImage *               accImage,
   }
 }
 
+/** Compute the accumulation image of the values and of the squared
+ * values of inputImage, in the first and second components of the pixels
+ * of outputImage. See BoxAccumulateFunction. */
 template <typename TInputImage, typename TOutputImage>
 void
 BoxSquareAccumulateFunction(const TInputImage *               inputImage,
@@ -598,73 +634,27 @@ BoxSquareAccumulateFunction(const TInputImage *               inputImage,
 )
 #endif
 {
-  // type alias
-  using InputImageType = TInputImage;
-  using OffsetType = typename TInputImage::OffsetType;
-  using OutputImageType = TOutputImage;
   using OutputPixelType = typename TOutputImage::PixelType;
   using ValueType = typename OutputPixelType::ValueType;
-  using InputPixelType = typename TInputImage::PixelType;
-
-  using InputIterator = ImageRegionConstIterator<TInputImage>;
-
-  using NOutputIterator = ShapedNeighborhoodIterator<TOutputImage>;
-  InputIterator                  inIt(inputImage, inputRegion);
-  typename TInputImage::SizeType kernelRadius;
-  kernelRadius.Fill(1);
-
-  NOutputIterator noutIt(kernelRadius, outputImage, outputRegion);
-  // this iterator is fully connected
-  itk_impl_details::setConnectivityEarlyBox(&noutIt, true);
-
-  ConstantBoundaryCondition<OutputImageType> oBC;
-  oBC.SetConstant(NumericTraits<OutputPixelType>::ZeroValue());
-  noutIt.OverrideBoundaryCondition(&oBC);
-  // This uses several iterators. An alternative and probably better
-  // approach would be to copy the input to the output and convolve
-  // with the following weights (in 2D)
-  //   -(dim - 1)  1
-  //       1       1
-  // The result of each convolution needs to get written back to the
-  // image being convolved so that the accumulation propagates
-  // This should be implementable with neighborhood operators.
-
-  std::vector<int>                        weights;
-  typename NOutputIterator::ConstIterator sIt;
-  for (auto idxIt = noutIt.GetActiveIndexList().begin(); idxIt != noutIt.GetActiveIndexList().end(); ++idxIt)
-  {
-    OffsetType offset = noutIt.GetOffset(*idxIt);
-    int        w = -1;
-    for (unsigned int k = 0; k < InputImageType::ImageDimension; ++k)
-    {
-      if (offset[k] != 0)
-      {
-        w *= offset[k];
-      }
-    }
-    weights.push_back(w);
-  }
 
-  for (inIt.GoToBegin(), noutIt.GoToBegin(); !noutIt.IsAtEnd(); ++inIt, ++noutIt)
+  ImageScanlineConstIterator<TInputImage> inIt(inputImage, inputRegion);
+  ImageScanlineIterator<TOutputImage>     outIt(outputImage, outputRegion);
+  for (; !outIt.IsAtEnd(); inIt.NextLine(), outIt.NextLine())
   {
-    ValueType sum = 0;
-    ValueType squareSum = 0;
-    int       k;
-    for (k = 0, sIt = noutIt.Begin(); !sIt.IsAtEnd(); ++sIt, ++k)
+    for (; !outIt.IsAtEndOfLine(); ++inIt, ++outIt)
     {
-      const OutputPixelType & v = sIt.Get();
-      sum += v[0] * weights[k];
-      squareSum += v[1] * weights[k];
-    }
-    OutputPixelType        o;
-    const InputPixelType & i = inIt.Get();
-    o[0] = sum + i;
-    o[1] = squareSum + i * i;
-    noutIt.SetCenterPixel(o);
+      const auto      value = static_cast<ValueType>(inIt.Get());
+      OutputPixelType o;
+      o[0] = value;
+      o[1] = value * value;
+      outIt.Set(o);
 #if defined(ITKV4_COMPATIBILITY)
-    progress.CompletedPixel();
+      progress.CompletedPixel();
 #endif
+    }
   }
+
+  BoxCumulativeSumFunction(outputImage, outputRegion);
 }
 } // namespace itk
 
@@ -0,0 +1,175 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBoxMeanImageFilter.h"
+#include "itkBoxSigmaImageFilter.h"
+#include "itkBoxUtilities.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using OutputImageType = itk::Image<double, Dimension>;
+using RegionType = OutputImageType::RegionType;
+using SizeType = OutputImageType::SizeType;
+
+// Compare the output with the mean, or the standard deviation, of the
+// pixels of the box cropped by the image.
+template <typename TImage>
+bool
+CheckAgainstBruteForce(const TImage *          input,
+                       const OutputImageType * output,
+                       const SizeType &        radius,
+                       bool                    sigma,
+                       double                  tolerance)
+{
+  const RegionType region = input->GetLargestPossibleRegion();
+  for (itk::ImageRegionConstIteratorWithIndex<OutputImageType> it(output, region); !it.IsAtEnd(); ++it)
+  {
+    RegionType box(it.GetIndex(), { { 1, 1, 1 } });
+    box.PadByRadius(radius);
+    box.Crop(region);
+
+    double sum = 0.0;
+    double squareSum = 0.0;
+    for (itk::ImageRegionConstIterator<TImage> boxIt(input, box); !boxIt.IsAtEnd(); ++boxIt)
+    {
+      const auto value = static_cast<double>(boxIt.Get());
+      sum += value;
+      squareSum += value * value;
+    }
+    const auto   count = static_cast<double>(box.GetNumberOfPixels());
+    const double expected = sigma ? std::sqrt((squareSum - sum * sum / count) / (count - 1)) : sum / count;
+
+    if (itk::Math::abs(it.Get() - expected) > tolerance * (1.0 + itk::Math::abs(expected)))
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the " << (sigma ? "sigma" : "mean") << " at " << it.GetIndex() << " with radius "
+                << radius << ": expected " << expected << ", but got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TPixel>
+int
+TestBoxFilters(double tolerance)
+{
+  using InputImageType = itk::Image<TPixel, Dimension>;
+
+  auto           input = InputImageType::New();
+  const SizeType size = { { 23, 17, 9 } };
+  input->SetRegions(size);
+  input->Allocate();
+
+  unsigned int seed = 11;
+  for (itk::ImageRegionIterator<InputImageType> it(input, input->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    seed = (seed * 1103515245 + 12345) % 2147483648u;
+    it.Set(static_cast<TPixel>((seed >> 8) % 256));
+  }
+
+  using MeanFilterType = itk::BoxMeanImageFilter<InputImageType, OutputImageType>;
+  auto meanFilter = MeanFilterType::New();
+  meanFilter->SetInput(input);
+
+  using SigmaFilterType = itk::BoxSigmaImageFilter<InputImageType, OutputImageType>;
+  auto sigmaFilter = SigmaFilterType::New();
+  sigmaFilter->SetInput(input);
+
+  const SizeType radii[] = { { { 1, 2, 3 } }, { { 4, 0, 2 } }, { { 12, 1, 5 } } };
+  for (const SizeType & radius : radii)
+  {
+    meanFilter->SetRadius(radius);
+    sigmaFilter->SetRadius(radius);
+    for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+    {
+      meanFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      sigmaFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+      ITK_TRY_EXPECT_NO_EXCEPTION(meanFilter->Update());
+      ITK_TRY_EXPECT_NO_EXCEPTION(sigmaFilter->Update());
+
+      if (!CheckAgainstBruteForce(input.GetPointer(), meanFilter->GetOutput(), radius, false, tolerance) ||
+          !CheckAgainstBruteForce(input.GetPointer(), sigmaFilter->GetOutput(), radius, true, tolerance))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The same accumulation image serves all the radii
+  using AccumImageType = itk::Image<itk::BoxAccumulateValueType<TPixel>, Dimension>;
+  const RegionType region = input->GetLargestPossibleRegion();
+  auto             accImage = AccumImageType::New();
+  accImage->SetRegions(region);
+  accImage->Allocate();
+  itk::BoxAccumulateFunction<InputImageType, AccumImageType>(input, accImage, region, region);
+
+  auto output = OutputImageType::New();
+  output->SetRegions(region);
+  output->Allocate();
+  for (const SizeType & radius : radii)
+  {
+    itk::BoxMeanCalculatorFunction<AccumImageType, OutputImageType>(accImage, output, region, region, radius);
+    if (!CheckAgainstBruteForce(input.GetPointer(), output.GetPointer(), radius, false, tolerance))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkBoxMeanSigmaImageFilterTest(int, char *[])
+{
+  static_assert(std::is_same<itk::BoxAccumulateValueType<unsigned char, true>, int64_t>::value,
+                "8-bit pixels and their squares are accumulated exactly");
+  static_assert(std::is_same<itk::BoxAccumulateValueType<short>, int64_t>::value,
+                "16-bit pixels are accumulated exactly");
+  static_assert(std::is_same<itk::BoxAccumulateValueType<short, true>, double>::value,
+                "the squares of 16-bit pixels are accumulated in double");
+  static_assert(std::is_same<itk::BoxAccumulateValueType<float>, double>::value,
+                "float pixels are accumulated in double");
+
+  int result = EXIT_SUCCESS;
+
+  std::cout << "unsigned char" << std::endl;
+  if (TestBoxFilters<unsigned char>(1e-12) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  std::cout << "short" << std::endl;
+  if (TestBoxFilters<short>(1e-9) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  std::cout << "float" << std::endl;
+  if (TestBoxFilters<float>(1e-9) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
@@ -186,6 +186,15 @@ public:
   itkGetMacro(UseSeed, bool);
   itkBooleanMacro(UseSeed);
 
+  /** Evaluate the cost function at the positions of the particles of each
+   * generation concurrently.  The cost function must then be safe to
+   * evaluate from several threads at once, which is not the case of the
+   * ImageToImageMetric classes: they set the parameters of their transform.
+   * Default is Off. */
+  itkSetMacro(EvaluateParticlesConcurrently, bool);
+  itkGetMacro(EvaluateParticlesConcurrently, bool);
+  itkBooleanMacro(EvaluateParticlesConcurrently);
+
   /** Get the function value for the current position.
    *  NOTE: This value is only valid during and after the execution of the
    *        StartOptimization() method.*/
@@ -225,6 +234,11 @@ protected:
   virtual void
   Initialize();
 
+  /** Evaluate the cost function at the current parameters of all the
+   * particles, concurrently if EvaluateParticlesConcurrently is On. */
+  void
+  EvaluateParticles();
+
   void
   RandomInitialization();
   void
@@ -247,6 +261,7 @@ protected:
   NumberOfIterationsType                  m_IterationIndex{ 0 };
   RandomVariateGeneratorType::IntegerType m_Seed{};
   bool                                    m_UseSeed{};
+  bool                                    m_EvaluateParticlesConcurrently{};
 };
 } // end namespace itk
 
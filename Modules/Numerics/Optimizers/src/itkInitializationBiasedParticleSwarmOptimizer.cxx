@@ -79,8 +79,13 @@ InitializationBiasedParticleSwarmOptimizer::UpdateSwarm()
       {
         p.m_CurrentParameters[k] = m_ParameterBounds[k].second;
       }
-    } // evaluate function at new position
-    p.m_CurrentValue = m_CostFunction->GetValue(p.m_CurrentParameters);
+    }
+  }
+
+  // evaluate function at new positions
+  this->EvaluateParticles();
+  for (ParticleData & p : m_Particles)
+  {
     if (p.m_CurrentValue < p.m_BestValue)
     {
       p.m_BestValue = p.m_CurrentValue;
@@ -17,6 +17,7 @@
  *=========================================================================*/
 #include <algorithm>
 #include "itkParticleSwarmOptimizerBase.h"
+#include "itkMultiThreaderBase.h"
 
 namespace itk
 {
@@ -35,6 +36,7 @@ ParticleSwarmOptimizerBase::ParticleSwarmOptimizerBase()
   this->m_FunctionConvergenceTolerance = 1e-4;
   this->m_Seed = 0;
   this->m_UseSeed = false;
+  this->m_EvaluateParticlesConcurrently = false;
 }
 
 ParticleSwarmOptimizerBase::~ParticleSwarmOptimizerBase() = default;
@@ -165,6 +167,7 @@ ParticleSwarmOptimizerBase::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Function convergence tolerance: " << this->m_FunctionConvergenceTolerance << std::endl;
   os << indent << "UseSeed: " << m_UseSeed << std::endl;
   os << indent << "Seed: " << m_Seed << std::endl;
+  os << indent << "EvaluateParticlesConcurrently: " << m_EvaluateParticlesConcurrently << std::endl;
 
   os << '\n';
   // printing the swarm, usually should be avoided (too much information)
@@ -498,11 +501,33 @@ ParticleSwarmOptimizerBase::RandomInitialization()
     }
   }
   // initial function evaluations
+  this->EvaluateParticles();
   for (i = 0; i < this->m_NumberOfParticles; ++i)
   {
-    this->m_Particles[i].m_CurrentValue = this->m_CostFunction->GetValue(m_Particles[i].m_CurrentParameters);
     this->m_Particles[i].m_BestValue = m_Particles[i].m_CurrentValue;
   }
 }
 
+void
+ParticleSwarmOptimizerBase::EvaluateParticles()
+{
+  if (this->m_EvaluateParticlesConcurrently)
+  {
+    MultiThreaderBase::New()->ParallelizeArray(
+      0,
+      this->m_NumberOfParticles,
+      [this](SizeValueType i) {
+        this->m_Particles[i].m_CurrentValue = this->m_CostFunction->GetValue(this->m_Particles[i].m_CurrentParameters);
+      },
+      nullptr);
+  }
+  else
+  {
+    for (ParticleData & particle : this->m_Particles)
+    {
+      particle.m_CurrentValue = this->m_CostFunction->GetValue(particle.m_CurrentParameters);
+    }
+  }
+}
+
 } // namespace itk
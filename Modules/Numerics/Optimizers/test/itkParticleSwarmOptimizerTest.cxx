@@ -48,6 +48,14 @@ PSOTest2();
 int
 PSOTest3();
 
+
+/**
+ * Test that evaluating the particles concurrently, with the 2D Rosenbrock
+ * function, gives the same swarm as evaluating them one after the other.
+ */
+int
+PSOTestConcurrentEvaluation();
+
 bool verboseFlag = false;
 
 /**
@@ -88,6 +96,12 @@ itkParticleSwarmOptimizerTest(int argc, char * argv[])
 
   std::cout << "All Tests Completed." << std::endl;
 
+  if (PSOTestConcurrentEvaluation() != EXIT_SUCCESS)
+  {
+    std::cout << "[FAILURE]\n";
+    return EXIT_FAILURE;
+  }
+
   if (static_cast<double>(success1) / static_cast<double>(allIterations) <= threshold ||
       static_cast<double>(success2) / static_cast<double>(allIterations) <= threshold ||
       static_cast<double>(success3) / static_cast<double>(allIterations) <= threshold)
@@ -481,3 +495,67 @@ PSOTest3()
   std::cout << "[Test 3 SUCCESS]" << std::endl;
   return EXIT_SUCCESS;
 }
+
+
+int
+PSOTestConcurrentEvaluation()
+{
+  std::cout << "Particle Swarm Optimizer Test of the concurrent evaluation\n";
+  std::cout << "-------------------------------\n";
+
+  itk::ParticleSwarmTestF3::Pointer costFunction = itk::ParticleSwarmTestF3::New();
+
+  OptimizerType::ParametersType finalParameters[2];
+  OptimizerType::MeasureType    finalValues[2];
+  for (const bool concurrent : { false, true })
+  {
+    auto itkOptimizer = OptimizerType::New();
+    itkOptimizer->UseSeedOn();
+    itkOptimizer->SetSeed(8775070);
+
+    OptimizerType::ParameterBoundsType bounds;
+    bounds.push_back(std::make_pair(-100, 100));
+    bounds.push_back(std::make_pair(-100, 100));
+    OptimizerType::ParametersType initialParameters(2);
+    initialParameters[0] = 100;
+    initialParameters[1] = 100;
+
+    itkOptimizer->SetParameterBounds(bounds);
+    itkOptimizer->SetNumberOfParticles(100);
+    itkOptimizer->SetMaximalNumberOfIterations(50);
+    itkOptimizer->SetParametersConvergenceTolerance(0.1, costFunction->GetNumberOfParameters());
+    itkOptimizer->SetFunctionConvergenceTolerance(0.01);
+    itkOptimizer->SetCostFunction(costFunction);
+    itkOptimizer->SetInitialPosition(initialParameters);
+
+    if (itkOptimizer->GetEvaluateParticlesConcurrently())
+    {
+      std::cout << "[Concurrent evaluation FAILURE] The default is On" << std::endl;
+      return EXIT_FAILURE;
+    }
+    itkOptimizer->SetEvaluateParticlesConcurrently(concurrent);
+
+    try
+    {
+      itkOptimizer->StartOptimization();
+    }
+    catch (const itk::ExceptionObject & e)
+    {
+      std::cout << "[Concurrent evaluation FAILURE]" << std::endl;
+      std::cout << "Description = " << e.GetDescription() << std::endl;
+      return EXIT_FAILURE;
+    }
+    finalParameters[concurrent] = itkOptimizer->GetCurrentPosition();
+    finalValues[concurrent] = itkOptimizer->GetValue();
+  }
+
+  std::cout << "Serial evaluation:     " << finalParameters[0] << " " << finalValues[0] << std::endl;
+  std::cout << "Concurrent evaluation: " << finalParameters[1] << " " << finalValues[1] << std::endl;
+  if (finalParameters[1] != finalParameters[0] || finalValues[1] != finalValues[0])
+  {
+    std::cout << "[Concurrent evaluation FAILURE]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "[Concurrent evaluation SUCCESS]" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -73,6 +73,11 @@ namespace itk
  * the number of steps along each dimension, a side of the region is
  * stepLength*(2*numberOfSteps[d]+1)*scaling[d].
  *
+ * When worker metrics are added with AddWorkerMetric(), the grid positions
+ * are evaluated concurrently, in batches, by the metric and the worker
+ * metrics.  The IterationEvents are still invoked in the order of the grid,
+ * once the values of a batch are known.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -160,6 +165,20 @@ protected:
   void
   IncrementIndex(ParametersType & newPosition);
 
+  /** Advance a grid index to the next grid position.  Returns false, with
+   * the index back to the first grid position, after the last one. */
+  bool
+  ComputeNextIndex(ParametersType & index) const;
+
+  /** Compute the position of a grid index. */
+  void
+  ComputePosition(const ParametersType & index, ParametersType & position) const;
+
+  /** Compute the current position and the next positions of the walk, which
+   * are evaluated concurrently when there are worker metrics. */
+  void
+  ComputeNextPositions(const ParametersType & currentPosition, std::vector<ParametersType> & positions) const;
+
 protected:
   ParametersType m_InitialPosition{};
   MeasureType    m_CurrentValue{ 0 };
@@ -18,6 +18,7 @@
 #ifndef itkExhaustiveOptimizerv4_hxx
 #define itkExhaustiveOptimizerv4_hxx
 
+#include <exception>
 
 namespace itk
 {
@@ -99,6 +100,12 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
   itkDebugMacro("ResumeWalk");
   m_Stop = false;
 
+  const bool                      evaluateConcurrently = !this->m_WorkerMetrics.empty();
+  std::vector<ParametersType>     nextPositions;
+  std::vector<MeasureType>        nextValues;
+  std::vector<std::exception_ptr> nextExceptions;
+  size_t                          nextPositionIndex = 0;
+
   while (!m_Stop)
   {
     ParametersType currentPosition = this->GetCurrentPosition();
@@ -109,7 +116,27 @@ ExhaustiveOptimizerv4<TInternalComputationValueType>::ResumeWalking()
       break;
     }
 
-    m_CurrentValue = this->m_Metric->GetValue();
+    if (evaluateConcurrently)
+    {
+      // Evaluate the next positions of the walk concurrently, then walk
+      // through their values
+      if (nextPositionIndex == nextPositions.size())
+      {
+        this->ComputeNextPositions(currentPosition, nextPositions);
+        this->EvaluateCandidates(nextPositions, nextValues, nextExceptions);
+        this->m_Metric->SetParameters(currentPosition);
+        nextPositionIndex = 0;
+      }
+      if (nextExceptions[nextPositionIndex])
+      {
+        std::rethrow_exception(nextExceptions[nextPositionIndex]);
+      }
+      m_CurrentValue = nextValues[nextPositionIndex++];
+    }
+    else
+    {
+      m_CurrentValue = this->m_Metric->GetValue();
+    }
 
     if (m_CurrentValue > m_MaximumMetricValue)
     {
@@ -168,37 +195,67 @@ template <typename TInternalComputationValueType>
 void
 ExhaustiveOptimizerv4<TInternalComputationValueType>::IncrementIndex(ParametersType & newPosition)
 {
-  unsigned int       idx = 0;
   const unsigned int spaceDimension = this->m_Metric->GetParameters().GetSize();
 
-  while (idx < spaceDimension)
+  if (!this->ComputeNextIndex(m_CurrentIndex))
   {
-    m_CurrentIndex[idx]++;
+    m_Stop = true;
+    m_StopConditionDescription.str("");
+    m_StopConditionDescription << this->GetNameOfClass() << ": "
+                               << "Completed sampling of parametric space of size " << spaceDimension;
+  }
 
-    if (m_CurrentIndex[idx] > (2 * m_NumberOfSteps[idx]))
-    {
-      m_CurrentIndex[idx] = 0;
-      ++idx;
-    }
-    else
+  this->ComputePosition(m_CurrentIndex, newPosition);
+}
+
+template <typename TInternalComputationValueType>
+bool
+ExhaustiveOptimizerv4<TInternalComputationValueType>::ComputeNextIndex(ParametersType & index) const
+{
+  const unsigned int spaceDimension = index.GetSize();
+
+  for (unsigned int idx = 0; idx < spaceDimension; ++idx)
+  {
+    index[idx]++;
+
+    if (index[idx] <= (2 * m_NumberOfSteps[idx]))
     {
-      break;
+      return true;
     }
+    index[idx] = 0;
   }
+  return false;
+}
 
-  if (idx == spaceDimension)
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::ComputePosition(const ParametersType & index,
+                                                                      ParametersType &       position) const
+{
+  const ScalesType & scales = this->GetScales();
+  for (unsigned int i = 0; i < index.GetSize(); ++i)
   {
-    m_Stop = true;
-    m_StopConditionDescription.str("");
-    m_StopConditionDescription << this->GetNameOfClass() << ": "
-                               << "Completed sampling of parametric space of size " << spaceDimension;
+    position[i] = (index[i] - m_NumberOfSteps[i]) * m_StepLength * scales[i] + m_InitialPosition[i];
   }
+}
 
-  const ScalesType & scales = this->GetScales();
-  for (unsigned int i = 0; i < spaceDimension; ++i)
+template <typename TInternalComputationValueType>
+void
+ExhaustiveOptimizerv4<TInternalComputationValueType>::ComputeNextPositions(
+  const ParametersType &        currentPosition,
+  std::vector<ParametersType> & positions) const
+{
+  // Enough positions to balance the evaluations over the metrics
+  const size_t numberOfPositions = 16 * (this->m_WorkerMetrics.size() + 1);
+
+  positions.assign(1, currentPosition);
+
+  ParametersType index = m_CurrentIndex;
+  ParametersType position(currentPosition.GetSize());
+  while (positions.size() < numberOfPositions && this->ComputeNextIndex(index))
   {
-    newPosition[i] =
-      (m_CurrentIndex[i] - m_NumberOfSteps[i]) * m_StepLength * scales[i] + this->GetInitialPosition()[i];
+    this->ComputePosition(index, position);
+    positions.push_back(position);
   }
 }
 
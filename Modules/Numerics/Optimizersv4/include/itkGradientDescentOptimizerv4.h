@@ -122,6 +122,21 @@ public:
   itkSetMacro(MaximumStepSizeInPhysicalUnits, TInternalComputationValueType);
   itkGetConstReferenceMacro(MaximumStepSizeInPhysicalUnits, TInternalComputationValueType);
 
+  /** Set/Get the exponent \f$\alpha\f$ and the offset \f$A\f$ of the decay of
+   *  the learning rate over the iterations.  At iteration \f$k\f$, the
+   *  gradient is multiplied by the learning rate times
+   *  \f$((A + 1) / (A + k + 1))^\alpha\f$, as with the gains of stochastic
+   *  gradient descent, e.g., \f$\alpha = 0.602\f$ and \f$A\f$ about a tenth
+   *  of the number of iterations.  Decaying steps average out the noise of
+   *  metrics which are evaluated on new random samples at each iteration.
+   *
+   *  The default exponent of 0 keeps the learning rate constant.
+   */
+  itkSetMacro(LearningRateDecayExponent, TInternalComputationValueType);
+  itkGetConstReferenceMacro(LearningRateDecayExponent, TInternalComputationValueType);
+  itkSetMacro(LearningRateDecayOffset, TInternalComputationValueType);
+  itkGetConstReferenceMacro(LearningRateDecayOffset, TInternalComputationValueType);
+
   /** Option to use ScalesEstimator for learning rate estimation at
    * *each* iteration. The estimation overrides the learning rate
    * set by SetLearningRate(). Default is false.
@@ -226,6 +241,8 @@ protected:
 
 
   TInternalComputationValueType m_LearningRate{};
+  TInternalComputationValueType m_LearningRateDecayExponent{};
+  TInternalComputationValueType m_LearningRateDecayOffset{};
   TInternalComputationValueType m_MinimumConvergenceValue{};
   TInternalComputationValueType m_ConvergenceValue{};
 
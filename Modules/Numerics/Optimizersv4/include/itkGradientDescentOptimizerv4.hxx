@@ -231,10 +231,18 @@ void
 GradientDescentOptimizerv4Template<TInternalComputationValueType>::ModifyGradientByLearningRateOverSubRange(
   const IndexRangeType & subrange)
 {
+  TInternalComputationValueType learningRate = this->m_LearningRate;
+  if (this->m_LearningRateDecayExponent != 0)
+  {
+    const TInternalComputationValueType offset = this->m_LearningRateDecayOffset + 1;
+    learningRate *= std::pow(offset / (offset + static_cast<TInternalComputationValueType>(this->m_CurrentIteration)),
+                             this->m_LearningRateDecayExponent);
+  }
+
   // Loop over the range. It is inclusive.
   for (IndexValueType j = subrange[0]; j <= subrange[1]; ++j)
   {
-    this->m_Gradient[j] = this->m_Gradient[j] * this->m_LearningRate;
+    this->m_Gradient[j] = this->m_Gradient[j] * learningRate;
   }
 }
 
@@ -271,6 +279,12 @@ GradientDescentOptimizerv4Template<TInternalComputationValueType>::PrintSelf(std
   os << indent << "LearningRate: "
      << static_cast<typename NumericTraits<TInternalComputationValueType>::PrintType>(this->m_LearningRate)
      << std::endl;
+  os << indent << "LearningRateDecayExponent: "
+     << static_cast<typename NumericTraits<TInternalComputationValueType>::PrintType>(this->m_LearningRateDecayExponent)
+     << std::endl;
+  os << indent << "LearningRateDecayOffset: "
+     << static_cast<typename NumericTraits<TInternalComputationValueType>::PrintType>(this->m_LearningRateDecayOffset)
+     << std::endl;
   os << indent << "MinimumConvergenceValue: " << this->m_MinimumConvergenceValue << std::endl;
   os << indent << "ConvergenceValue: "
      << static_cast<typename NumericTraits<TInternalComputationValueType>::PrintType>(this->m_ConvergenceValue)
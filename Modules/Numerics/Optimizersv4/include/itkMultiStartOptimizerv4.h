@@ -36,6 +36,10 @@ namespace itk
  *   focus modifying the parameter sample space.  This is why we place the burden on the user to provide
  *   the parameter samples over which to optimize.
  *
+ *   Without local optimizer, i.e., when the metric is only evaluated at the given parameter samples,
+ *   the samples are evaluated concurrently by the metric and the worker metrics added with
+ *   AddWorkerMetric().  With a local optimizer, the samples are optimized one after the other.
+ *
  * \ingroup ITKOptimizersv4
  */
 template <typename TInternalComputationValueType>
@@ -20,6 +20,8 @@
 
 #include "itkPrintHelper.h"
 
+#include <exception>
+
 
 namespace itk
 {
@@ -164,6 +166,19 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
   this->m_StopConditionDescription << this->GetNameOfClass() << ": ";
   this->InvokeEvent(StartEvent());
 
+  // Without local optimizer, the remaining start points are independent
+  // evaluations of the metric, which the worker metrics share
+  const bool                      evaluateConcurrently = !this->m_WorkerMetrics.empty() && !this->m_LocalOptimizer;
+  const SizeValueType             firstIteration = this->m_CurrentIteration;
+  std::vector<MeasureType>        values;
+  std::vector<std::exception_ptr> exceptions;
+  if (evaluateConcurrently)
+  {
+    const ParametersListType remainingParametersList(this->m_ParametersList.begin() + firstIteration,
+                                                     this->m_ParametersList.end());
+    this->EvaluateCandidates(remainingParametersList, values, exceptions);
+  }
+
   this->m_Stop = false;
   while (!this->m_Stop)
   {
@@ -171,13 +186,25 @@ MultiStartOptimizerv4Template<TInternalComputationValueType>::ResumeOptimization
     try
     {
       this->m_Metric->SetParameters(this->m_ParametersList[this->m_CurrentIteration]);
-      if (this->m_LocalOptimizer)
+      if (evaluateConcurrently)
+      {
+        const SizeValueType index = this->m_CurrentIteration - firstIteration;
+        if (exceptions[index])
+        {
+          std::rethrow_exception(exceptions[index]);
+        }
+        this->m_CurrentMetricValue = values[index];
+      }
+      else
       {
-        this->m_LocalOptimizer->SetMetric(this->m_Metric);
-        this->m_LocalOptimizer->StartOptimization();
-        this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        if (this->m_LocalOptimizer)
+        {
+          this->m_LocalOptimizer->SetMetric(this->m_Metric);
+          this->m_LocalOptimizer->StartOptimization();
+          this->m_ParametersList[this->m_CurrentIteration] = this->m_Metric->GetParameters();
+        }
+        this->m_CurrentMetricValue = this->m_Metric->GetValue();
       }
-      this->m_CurrentMetricValue = this->m_Metric->GetValue();
       this->m_MetricValuesList.push_back(this->m_CurrentMetricValue);
     }
     catch (const ExceptionObject &)
@@ -228,6 +228,13 @@ public:
   MeasureType
   GetCurrentValue() const;
 
+  /** Set the maximum number of work units of the evaluations of the metric.
+   * Metrics which multi-thread their evaluations override it, the default
+   * does nothing. */
+  virtual void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType itkNotUsed(number))
+  {}
+
   using MetricCategoryEnum = itk::ObjectToObjectMetricBaseTemplateEnums::MetricCategory;
 #if !defined(ITK_LEGACY_REMOVE)
   /**Exposes enums values for backwards compatibility*/
@@ -25,6 +25,9 @@
 #include "itkObjectToObjectMetricBase.h"
 #include "itkIntTypes.h"
 
+#include <exception>
+#include <vector>
+
 namespace itk
 {
 /** \class ObjectToObjectOptimizerBaseTemplateEnums
@@ -104,6 +107,15 @@ extern ITKOptimizersv4_EXPORT std::ostream &
  * Threading of some optimizer operations may be handled within
  * derived classes, for example in GradientDescentOptimizer.
  *
+ * Optimizers which evaluate independent candidate positions, such as
+ * ExhaustiveOptimizerv4 and MultiStartOptimizerv4, can evaluate them
+ * concurrently.  A metric can not evaluate several positions at once, since
+ * the position is the state of its transform, so the user adds worker
+ * metrics with AddWorkerMetric(): each one is equivalent to the metric of the
+ * optimizer, e.g., with the same images, but has its own transform, and is
+ * initialized.  The candidates are then evaluated by the metric of the
+ * optimizer and by the worker metrics concurrently.
+ *
  * \note Derived classes must override StartOptimization, and then call
  * this base class version to perform common initializations.
  *
@@ -154,6 +166,24 @@ public:
   itkSetObjectMacro(Metric, MetricType);
   itkGetModifiableObjectMacro(Metric, MetricType);
 
+  /** Add a worker metric, which evaluates candidate positions concurrently
+   * with the metric of the optimizer, in the optimizers which support it.
+   * It must be initialized, and give the same values as the metric of the
+   * optimizer for the same parameters. */
+  virtual void
+  AddWorkerMetric(MetricType * metric);
+
+  /** Remove all the worker metrics. */
+  virtual void
+  ClearWorkerMetrics();
+
+  /** Get the number of worker metrics. */
+  SizeValueType
+  GetNumberOfWorkerMetrics() const
+  {
+    return static_cast<SizeValueType>(m_WorkerMetrics.size());
+  }
+
   /** Accessor for metric value. Returns the value
    *  stored in m_CurrentMetricValue from the most recent
    *  call to evaluate the metric. */
@@ -276,10 +306,24 @@ protected:
   ObjectToObjectOptimizerBaseTemplate();
   ~ObjectToObjectOptimizerBaseTemplate() override;
 
-  MetricTypePointer m_Metric{};
-  ThreadIdType      m_NumberOfWorkUnits{};
-  SizeValueType     m_CurrentIteration{};
-  SizeValueType     m_NumberOfIterations{};
+  /** Evaluate the metric at each candidate position, with the metric of the
+   * optimizer and the worker metrics concurrently.  An exception thrown by
+   * the evaluation of a candidate is stored in \c exceptions, and its value
+   * is left undefined.  The parameters of the metric of the optimizer are
+   * those of one of the candidates on return.  When several metrics evaluate
+   * the candidates, each of them is given max(1, P / M) work units with
+   * SetMaximumNumberOfWorkUnits(), P being the default number of threads
+   * and M the number of metrics, and keeps them on return. */
+  void
+  EvaluateCandidates(const std::vector<ParametersType> & candidates,
+                     std::vector<MeasureType> &          values,
+                     std::vector<std::exception_ptr> &   exceptions);
+
+  MetricTypePointer              m_Metric{};
+  std::vector<MetricTypePointer> m_WorkerMetrics{};
+  ThreadIdType                   m_NumberOfWorkUnits{};
+  SizeValueType                  m_CurrentIteration{};
+  SizeValueType                  m_NumberOfIterations{};
 
   /** Metric measure value at a given iteration, as most recently evaluated. */
   MeasureType m_CurrentMetricValue{};
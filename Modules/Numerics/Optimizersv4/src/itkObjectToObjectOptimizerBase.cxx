@@ -18,6 +18,10 @@
 #define ITK_TEMPLATE_EXPLICIT_ObjectToObjectOptimizerBaseTemplate
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkPlatformMultiThreader.h"
+
+#include <algorithm>
+#include <atomic>
 
 namespace itk
 {
@@ -50,6 +54,7 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::PrintSelf(st
   Superclass::PrintSelf(os, indent);
 
   itkPrintSelfObjectMacro(Metric);
+  os << indent << "NumberOfWorkerMetrics: " << m_WorkerMetrics.size() << std::endl;
 
   os << indent
      << "NumberOfWorkUnits: " << static_cast<typename NumericTraits<ThreadIdType>::PrintType>(m_NumberOfWorkUnits)
@@ -89,6 +94,93 @@ ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::SetNumberOfW
   }
 }
 
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::AddWorkerMetric(MetricType * metric)
+{
+  if (metric == nullptr)
+  {
+    itkExceptionMacro("The worker metric is null.");
+  }
+  this->m_WorkerMetrics.push_back(metric);
+  this->Modified();
+}
+
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::ClearWorkerMetrics()
+{
+  if (!this->m_WorkerMetrics.empty())
+  {
+    this->m_WorkerMetrics.clear();
+    this->Modified();
+  }
+}
+
+template <typename TInternalComputationValueType>
+void
+ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::EvaluateCandidates(
+  const std::vector<ParametersType> & candidates,
+  std::vector<MeasureType> &          values,
+  std::vector<std::exception_ptr> &   exceptions)
+{
+  const auto numberOfCandidates = static_cast<SizeValueType>(candidates.size());
+  values.assign(numberOfCandidates, MeasureType{});
+  exceptions.assign(numberOfCandidates, nullptr);
+
+  std::vector<MetricType *> metrics{ this->m_Metric.GetPointer() };
+  for (const auto & workerMetric : this->m_WorkerMetrics)
+  {
+    metrics.push_back(workerMetric.GetPointer());
+  }
+  const auto numberOfMetrics = std::min(static_cast<SizeValueType>(metrics.size()), numberOfCandidates);
+
+  // Each metric evaluates the next candidate which has not been evaluated
+  // yet until there is none left, on a thread of its own, so that metrics
+  // which are slower than the others evaluate fewer candidates.
+  std::atomic<SizeValueType> nextIndex{ 0 };
+  const auto                 evaluateCandidates = [&](SizeValueType metricIndex) {
+    MetricType * metric = metrics[metricIndex];
+    for (SizeValueType index = nextIndex++; index < numberOfCandidates; index = nextIndex++)
+    {
+      try
+      {
+        ParametersType parameters = candidates[index];
+        metric->SetParameters(parameters);
+        values[index] = metric->GetValue();
+      }
+      catch (...)
+      {
+        exceptions[index] = std::current_exception();
+      }
+    }
+  };
+
+  if (numberOfMetrics <= 1)
+  {
+    evaluateCandidates(0);
+    return;
+  }
+
+  // The metrics multi-thread their evaluations on the P threads of the
+  // default multi-threader, with P / numberOfMetrics work units each, so
+  // that the evaluations do not use more than P threads together.  The
+  // threads which run the metrics are not those of the pool of the default
+  // multi-threader, as the evaluations could otherwise wait forever for a
+  // thread of the pool which is running a metric.
+  const auto numberOfWorkUnitsPerMetric = static_cast<ThreadIdType>(
+    std::max<SizeValueType>(1, MultiThreaderBase::GetGlobalDefaultNumberOfThreads() / numberOfMetrics));
+  for (SizeValueType metricIndex = 0; metricIndex < numberOfMetrics; ++metricIndex)
+  {
+    metrics[metricIndex]->SetMaximumNumberOfWorkUnits(numberOfWorkUnitsPerMetric);
+  }
+
+  auto multiThreader = PlatformMultiThreader::New();
+  multiThreader->SetMaximumNumberOfThreads(static_cast<ThreadIdType>(numberOfMetrics));
+  multiThreader->SetNumberOfWorkUnits(static_cast<ThreadIdType>(numberOfMetrics));
+  multiThreader->ParallelizeArray(0, numberOfMetrics, evaluateCandidates, nullptr);
+}
+
 template <typename TInternalComputationValueType>
 void
 ObjectToObjectOptimizerBaseTemplate<TInternalComputationValueType>::StartOptimization(
@@ -22,6 +22,7 @@
 #include "itkExhaustiveOptimizerv4.h"
 
 #include "itkMath.h"
+#include "itkMultiThreaderBase.h"
 #include "itkTestingMacros.h"
 
 /**
@@ -144,9 +145,22 @@ public:
   UpdateTransformParameters(const DerivativeType &, ParametersValueType) override
   {}
 
+  void
+  SetMaximumNumberOfWorkUnits(const itk::ThreadIdType number) override
+  {
+    m_MaximumNumberOfWorkUnits = number;
+  }
+
+  itk::ThreadIdType
+  GetMaximumNumberOfWorkUnits() const
+  {
+    return m_MaximumNumberOfWorkUnits;
+  }
+
 private:
-  ParametersType m_Parameters;
-  bool           m_HasLocalSupport;
+  ParametersType    m_Parameters;
+  bool              m_HasLocalSupport;
+  itk::ThreadIdType m_MaximumNumberOfWorkUnits{ 0 };
 };
 
 
@@ -328,6 +342,52 @@ itkExhaustiveOptimizerv4Test(int, char *[])
   }
 
 
+  // The same walk, with the positions evaluated concurrently by worker
+  // metrics, must give the same results
+  auto concurrentOptimizer = OptimizerType::New();
+  auto concurrentIdxObserver = IndexObserver::New();
+  concurrentOptimizer->AddObserver(itk::IterationEvent(), concurrentIdxObserver);
+  metric->SetParameters(initialPosition);
+  concurrentOptimizer->SetMetric(metric);
+  std::vector<ExhaustiveOptv4Metric::Pointer> workerMetrics;
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    auto workerMetric = ExhaustiveOptv4Metric::New();
+    workerMetric->Initialize();
+    concurrentOptimizer->AddWorkerMetric(workerMetric);
+    workerMetrics.push_back(workerMetric);
+  }
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetNumberOfWorkerMetrics(), 3);
+  ITK_TRY_EXPECT_EXCEPTION(concurrentOptimizer->AddWorkerMetric(nullptr));
+  concurrentOptimizer->SetScales(parametersScale);
+  concurrentOptimizer->SetStepLength(stepLength);
+  concurrentOptimizer->SetNumberOfSteps(steps);
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(concurrentOptimizer->StartOptimization());
+
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMinimumMetricValue(), itkOptimizer->GetMinimumMetricValue());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMaximumMetricValue(), itkOptimizer->GetMaximumMetricValue());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMinimumMetricValuePosition(),
+                        itkOptimizer->GetMinimumMetricValuePosition());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetMaximumMetricValuePosition(),
+                        itkOptimizer->GetMaximumMetricValuePosition());
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetCurrentIteration(), itkOptimizer->GetCurrentIteration());
+  ITK_TEST_EXPECT_EQUAL(concurrentIdxObserver->m_VisitedIndices == idxObserver->m_VisitedIndices, true);
+  ITK_TEST_EXPECT_EQUAL(metric->GetParameters(), itkOptimizer->GetCurrentPosition());
+
+  // The four metrics share the threads of the default multi-threader
+  const itk::ThreadIdType numberOfWorkUnits =
+    std::max<itk::ThreadIdType>(1, itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads() / 4);
+  ITK_TEST_EXPECT_EQUAL(metric->GetMaximumNumberOfWorkUnits(), numberOfWorkUnits);
+  for (const auto & workerMetric : workerMetrics)
+  {
+    ITK_TEST_EXPECT_EQUAL(workerMetric->GetMaximumNumberOfWorkUnits(), numberOfWorkUnits);
+  }
+
+  concurrentOptimizer->ClearWorkerMetrics();
+  ITK_TEST_EXPECT_EQUAL(concurrentOptimizer->GetNumberOfWorkerMetrics(), 0);
+
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 }
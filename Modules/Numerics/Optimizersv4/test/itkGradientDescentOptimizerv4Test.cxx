@@ -250,6 +250,12 @@ itkGradientDescentOptimizerv4Test(int, char *[])
   bool returnBestParametersAndValue = false;
   ITK_TEST_SET_GET_BOOLEAN(itkOptimizer, ReturnBestParametersAndValue, returnBestParametersAndValue);
 
+  double learningRateDecayExponent = 0.0;
+  ITK_TEST_SET_GET_VALUE(learningRateDecayExponent, itkOptimizer->GetLearningRateDecayExponent());
+
+  double learningRateDecayOffset = 0.0;
+  ITK_TEST_SET_GET_VALUE(learningRateDecayOffset, itkOptimizer->GetLearningRateDecayOffset());
+
   // Truth
   ParametersType trueParameters(2);
   trueParameters[0] = 2;
@@ -262,6 +268,23 @@ itkGradientDescentOptimizerv4Test(int, char *[])
     result = EXIT_FAILURE;
   }
 
+  // test with a decaying learning rate
+  std::cout << "Test optimization with a decaying learning rate:" << std::endl;
+  learningRateDecayExponent = 0.602;
+  itkOptimizer->SetLearningRateDecayExponent(learningRateDecayExponent);
+  ITK_TEST_SET_GET_VALUE(learningRateDecayExponent, itkOptimizer->GetLearningRateDecayExponent());
+  learningRateDecayOffset = 10.0;
+  itkOptimizer->SetLearningRateDecayOffset(learningRateDecayOffset);
+  ITK_TEST_SET_GET_VALUE(learningRateDecayOffset, itkOptimizer->GetLearningRateDecayOffset());
+  itkOptimizer->SetNumberOfIterations(100);
+  metric->SetParameters(initialPosition);
+  if (GradientDescentOptimizerv4RunTest(itkOptimizer, trueParameters) == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  itkOptimizer->SetLearningRateDecayExponent(0.0);
+  itkOptimizer->SetNumberOfIterations(numberOfIterations);
+
   // test with non-idenity scales
   std::cout << "Test optimization with non-identity scales:" << std::endl;
   ScalesType scales(metric->GetNumberOfLocalParameters());
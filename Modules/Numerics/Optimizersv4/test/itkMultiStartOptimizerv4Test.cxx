@@ -254,6 +254,31 @@ itkMultiStartOptimizerv4Test(int, char *[])
   }
   std::cout << "Test 1 passed." << std::endl;
 
+  /*
+   * Test 1 with the start points evaluated concurrently by worker metrics
+   */
+  std::cout << "Test optimization 1 with worker metrics:" << std::endl;
+  const OptimizerType::MetricValuesListType metricValuesList = itkOptimizer->GetMetricValuesList();
+  const ParametersType                      bestParameters = itkOptimizer->GetBestParameters();
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    auto workerMetric = MultiStartOptimizerv4TestMetric::New();
+    workerMetric->Initialize();
+    itkOptimizer->AddWorkerMetric(workerMetric);
+  }
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetNumberOfWorkerMetrics(), 3);
+  metric->SetParameters(parametersList[0]);
+  itkOptimizer->SetParametersList(parametersList);
+  if (MultiStartOptimizerv4RunTest(itkOptimizer) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  ITK_TEST_EXPECT_TRUE(itkOptimizer->GetMetricValuesList() == metricValuesList);
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetBestParameters(), bestParameters);
+  itkOptimizer->ClearWorkerMetrics();
+  ITK_TEST_EXPECT_EQUAL(itkOptimizer->GetNumberOfWorkerMetrics(), 0);
+  std::cout << "Test 1 with worker metrics passed." << std::endl;
+
   /*
    * Test 2
    */
@@ -37,17 +37,25 @@ namespace itk
  * points are stored as point coordinates. Points of the input point set
  * must have unique identifiers within range 0..N-1, where N is the number
  * of points. Pixels (pointData) of input point set are not used.
- * Additionally, by default, feature points are expected to lie at least
+ * Additionally, feature points are expected to lie at least
  * (SearchRadius + BlockRadius) voxels from a boundary. This is usually
  * achieved by using an appropriate mask during selection of feature points.
- * If you are unsure whether feature points satisfy the above condition set
- * CheckBoundary flag to true which turns on boundary checks.
+ * Closer points are still matched, taking the pixels beyond the boundary as
+ * the nearest boundary pixels.
  * The default output(0) is a PointSet with displacements stored as vectors.
  * Additional output(1) is a PointSet containing similarities. Similarities
  * are needed to compute displacements and are always computed. The number
  * of points in the output PointSet is equal to the number of points in the
  * input PointSet.
  *
+ * For each feature point, the block of the moving image around the point is
+ * compared to the blocks of the fixed image around every candidate position
+ * within SearchRadius of the point, by their squared normalized
+ * cross-correlation. The sums over the fixed blocks are taken from
+ * summed-area tables of the search area, so that only the cross-correlation
+ * is accumulated over each candidate block. The feature points are divided
+ * among the threads, each with its own scratch buffers.
+ *
  * The filter is templated over fixed Image, moving Image, input PointSet,
  * output displacements PointSet and output similarities PointSet.
  *
@@ -181,6 +189,7 @@ protected:
   virtual void
   BeforeThreadedGenerateData();
 
+  /** Search the blocks of the feature points assigned to the given thread. */
   virtual void
   ThreadedGenerateData(ThreadIdType threadId);
 
@@ -214,6 +223,13 @@ protected:
   };
 
 private:
+  /** Copy the pixels of the region of the image to the buffer, in raster
+   * order. Indices outside of the buffered region of the image are clamped
+   * to it, as by the zero flux Neumann boundary condition. */
+  template <typename TImage>
+  static void
+  CopyRegionToBuffer(const TImage * image, const ImageRegionType & region, SimilaritiesValue * buffer);
+
   // algorithm parameters
   ImageSizeType m_BlockRadius{};
   ImageSizeType m_SearchRadius{};
@@ -24,6 +24,10 @@
 #include "itkMultiThreaderBase.h"
 #include "itkMakeUniqueForOverwrite.h"
 
+#include <algorithm>
+#include <bitset>
+#include <vector>
+
 
 namespace itk
 {
@@ -269,6 +273,56 @@ BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, T
   return ITK_THREAD_RETURN_DEFAULT_VALUE;
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TFeatures,
+          typename TDisplacements,
+          typename TSimilarities>
+template <typename TImage>
+void
+BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, TSimilarities>::CopyRegionToBuffer(
+  const TImage *          image,
+  const ImageRegionType & region,
+  SimilaritiesValue *     buffer)
+{
+  const ImageRegionType & bufferedRegion = image->GetBufferedRegion();
+  if (bufferedRegion.IsInside(region))
+  {
+    for (ImageRegionConstIterator<TImage> it(image, region); !it.IsAtEnd(); ++it, ++buffer)
+    {
+      *buffer = it.Get();
+    }
+    return;
+  }
+
+  const ImageIndexType bufferedFirst = bufferedRegion.GetIndex();
+  const ImageIndexType bufferedLast = bufferedRegion.GetUpperIndex();
+  const ImageIndexType first = region.GetIndex();
+  const ImageIndexType last = region.GetUpperIndex();
+
+  ImageIndexType index = first;
+  for (SizeValueType i = 0, n = region.GetNumberOfPixels(); i < n; ++i)
+  {
+    ImageIndexType clampedIndex;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      clampedIndex[d] = std::clamp(index[d], bufferedFirst[d], bufferedLast[d]);
+    }
+    buffer[i] = image->GetPixel(clampedIndex);
+
+    // next index in raster order
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (index[d] < last[d])
+      {
+        ++index[d];
+        break;
+      }
+      index[d] = first[d];
+    }
+  }
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TFeatures,
@@ -278,6 +332,8 @@ void
 BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, TSimilarities>::ThreadedGenerateData(
   ThreadIdType threadId)
 {
+  using RealType = typename NumericTraits<SimilaritiesValue>::RealType;
+
   FixedImageConstPointer    fixedImage = this->GetFixedImage();
   MovingImageConstPointer   movingImage = this->GetMovingImage();
   FeaturePointsConstPointer featurePoints = this->GetFeaturePoints();
@@ -292,22 +348,72 @@ BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, T
     count += this->m_PointsCount % workUnitCount;
   }
 
-  // start constructing window region and center region (single voxel)
-  ImageRegionType window;
-  ImageRegionType center;
-  ImageSizeType   windowSize;
-  windowSize.Fill(1);
-  center.SetSize(windowSize); // size of center region is 1
-  windowSize += m_SearchRadius + m_SearchRadius;
-  window.SetSize(windowSize); // size of window region is 1+2*m_BlockHalfWindow
-
-  // start constructing block iterator
+  // The fixed image is searched in the window of 1+2*m_SearchRadius
+  // candidate centers, whose blocks cover the area of the window enlarged by
+  // m_BlockRadius. The area of the fixed image and the block of the moving
+  // image are copied to scratch buffers, and the sums of the fixed values and
+  // squared values over the blocks are taken from summed-area tables of the
+  // area, which have an extra leading row of zeros along each dimension.
+  ImageSizeType blockSize;
+  ImageSizeType windowSize;
+  ImageSizeType areaSize;
+  SizeValueType areaStrides[ImageDimension];
+  SizeValueType tableStrides[ImageDimension];
   SizeValueType numberOfVoxelInBlock = 1;
-  for (unsigned int i = 0; i < ImageSizeType::Dimension; ++i)
+  SizeValueType numberOfVoxelInArea = 1;
+  SizeValueType numberOfEntriesInTable = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    blockSize[d] = m_BlockRadius[d] + 1 + m_BlockRadius[d];
+    windowSize[d] = m_SearchRadius[d] + 1 + m_SearchRadius[d];
+    areaSize[d] = windowSize[d] + blockSize[d] - 1;
+    areaStrides[d] = numberOfVoxelInArea;
+    tableStrides[d] = numberOfEntriesInTable;
+    numberOfVoxelInBlock *= blockSize[d];
+    numberOfVoxelInArea *= areaSize[d];
+    numberOfEntriesInTable *= areaSize[d] + 1;
+  }
+
+  // offsets of the block rows in the area, in the order of the neighborhood
+  // iterators, and offsets and signs of the block corners in the tables
+  std::vector<SizeValueType> blockRowOffsets(numberOfVoxelInBlock / blockSize[0]);
+  for (SizeValueType row = 0; row < blockRowOffsets.size(); ++row)
   {
-    numberOfVoxelInBlock *= m_BlockRadius[i] + 1 + m_BlockRadius[i];
+    SizeValueType remainder = row;
+    blockRowOffsets[row] = 0;
+    for (unsigned int d = 1; d < ImageDimension; ++d)
+    {
+      blockRowOffsets[row] += (remainder % blockSize[d]) * areaStrides[d];
+      remainder /= blockSize[d];
+    }
+  }
+  constexpr unsigned int numberOfCorners = 1u << ImageDimension;
+  SizeValueType          cornerOffsets[numberOfCorners];
+  RealType               cornerSigns[numberOfCorners];
+  for (unsigned int corner = 0; corner < numberOfCorners; ++corner)
+  {
+    cornerOffsets[corner] = 0;
+    cornerSigns[corner] = ((ImageDimension - std::bitset<ImageDimension>(corner).count()) % 2 == 0) ? 1.0 : -1.0;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (corner & (1u << d))
+      {
+        cornerOffsets[corner] += blockSize[d] * tableStrides[d];
+      }
+    }
   }
 
+  // scratch buffers used exclusively by this thread
+  std::vector<SimilaritiesValue> fixedArea(numberOfVoxelInArea);
+  std::vector<SimilaritiesValue> movingBlock(numberOfVoxelInBlock);
+  std::vector<RealType>          fixedSums(numberOfEntriesInTable);
+  std::vector<RealType>          fixedSumsOfSquares(numberOfEntriesInTable);
+
+  ImageRegionType area;
+  area.SetSize(areaSize);
+  ImageRegionType block;
+  block.SetSize(blockSize);
+
   // loop thru feature points
   for (SizeValueType idx = first, last = first + count; idx < last; ++idx)
   {
@@ -321,42 +427,91 @@ BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, T
     // New point location
     DisplacementsVector displacement;
 
-    // set centers of window and center regions to current location
-    ImageIndexType start = fixedIndex - this->m_SearchRadius;
-    window.SetIndex(start);
-    center.SetIndex(movingIndex);
-
-    // iterate over neighborhoods in region window, for each neighborhood: iterate over voxels in blockRadius
-    ConstNeighborhoodIterator<FixedImageType> windowIterator(m_BlockRadius, fixedImage, window);
+    // the window starts at the first candidate center
+    const ImageIndexType start = fixedIndex - this->m_SearchRadius;
+    area.SetIndex(start - this->m_BlockRadius);
+    block.SetIndex(movingIndex - this->m_BlockRadius);
+    CopyRegionToBuffer(fixedImage.GetPointer(), area, fixedArea.data());
+    CopyRegionToBuffer(movingImage.GetPointer(), block, movingBlock.data());
+
+    // the moving block is the same for all candidates
+    SimilaritiesValue movingSum{};
+    SimilaritiesValue movingSumOfSquares{};
+    for (const SimilaritiesValue movingValue : movingBlock)
+    {
+      movingSum += movingValue;
+      movingSumOfSquares += movingValue * movingValue;
+    }
+    const SimilaritiesValue movingMean = movingSum / numberOfVoxelInBlock;
+    const SimilaritiesValue movingVariance = movingSumOfSquares - numberOfVoxelInBlock * movingMean * movingMean;
 
-    // iterate over voxels in neighborhood of current feature point
-    ConstNeighborhoodIterator<MovingImageType> centerIterator(m_BlockRadius, movingImage, center);
-    centerIterator.GoToBegin();
+    // summed-area tables of the fixed area; the leading rows of zeros are
+    // never written to
+    const SimilaritiesValue * fixedAreaRow = fixedArea.data();
+    for (SizeValueType row = 0; row < numberOfVoxelInArea / areaSize[0]; ++row)
+    {
+      SizeValueType remainder = row;
+      SizeValueType entry = 1;
+      for (unsigned int d = 1; d < ImageDimension; ++d)
+      {
+        entry += (remainder % areaSize[d] + 1) * tableStrides[d];
+        remainder /= areaSize[d];
+      }
+      for (SizeValueType i = 0; i < areaSize[0]; ++i, ++entry)
+      {
+        const RealType fixedValue = fixedAreaRow[i];
+        fixedSums[entry] = fixedValue;
+        fixedSumsOfSquares[entry] = fixedValue * fixedValue;
+      }
+      fixedAreaRow += areaSize[0];
+    }
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const SizeValueType stride = tableStrides[d];
+      const SizeValueType span = stride * (areaSize[d] + 1);
+      for (SizeValueType outer = 0; outer < numberOfEntriesInTable; outer += span)
+      {
+        for (SizeValueType entry = outer + stride; entry < outer + span; ++entry)
+        {
+          fixedSums[entry] += fixedSums[entry - stride];
+          fixedSumsOfSquares[entry] += fixedSumsOfSquares[entry - stride];
+        }
+      }
+    }
 
-    // iterate over neighborhoods in region window
-    for (windowIterator.GoToBegin(); !windowIterator.IsAtEnd(); ++windowIterator)
+    // iterate over the candidate centers of the window, in raster order
+    typename ImageIndexType::OffsetType windowOffset{};
+    SizeValueType                       areaOffset = 0;
+    SizeValueType                       tableOffset = 0;
+    while (true)
     {
-      SimilaritiesValue fixedSum{};
-      SimilaritiesValue fixedSumOfSquares{};
-      SimilaritiesValue movingSum{};
-      SimilaritiesValue movingSumOfSquares{};
-      SimilaritiesValue covariance{};
+      RealType fixedBlockSum{};
+      RealType fixedBlockSumOfSquares{};
+      for (unsigned int corner = 0; corner < numberOfCorners; ++corner)
+      {
+        fixedBlockSum += cornerSigns[corner] * fixedSums[tableOffset + cornerOffsets[corner]];
+        fixedBlockSumOfSquares += cornerSigns[corner] * fixedSumsOfSquares[tableOffset + cornerOffsets[corner]];
+      }
+      const auto fixedSum = static_cast<SimilaritiesValue>(fixedBlockSum);
+      const auto fixedSumOfSquares = static_cast<SimilaritiesValue>(fixedBlockSumOfSquares);
 
       // iterate over voxels in blockRadius
-      for (SizeValueType i = 0; i < numberOfVoxelInBlock; ++i) // windowIterator.Size() == numberOfVoxelInBlock
+      // the rows are accumulated separately, to shorten the dependency chain
+      SimilaritiesValue         covariance{};
+      const SimilaritiesValue * movingRow = movingBlock.data();
+      for (const SizeValueType rowOffset : blockRowOffsets)
       {
-        const SimilaritiesValue fixedValue = windowIterator.GetPixel(i);
-        const SimilaritiesValue movingValue = centerIterator.GetPixel(i);
-        movingSum += movingValue;
-        fixedSum += fixedValue;
-        movingSumOfSquares += movingValue * movingValue;
-        fixedSumOfSquares += fixedValue * fixedValue;
-        covariance += fixedValue * movingValue;
+        const SimilaritiesValue * fixedRow = fixedArea.data() + areaOffset + rowOffset;
+        SimilaritiesValue         rowCovariance{};
+        for (SizeValueType i = 0; i < blockSize[0]; ++i)
+        {
+          rowCovariance += fixedRow[i] * movingRow[i];
+        }
+        covariance += rowCovariance;
+        movingRow += blockSize[0];
       }
       const SimilaritiesValue fixedMean = fixedSum / numberOfVoxelInBlock;
-      const SimilaritiesValue movingMean = movingSum / numberOfVoxelInBlock;
       const SimilaritiesValue fixedVariance = fixedSumOfSquares - numberOfVoxelInBlock * fixedMean * fixedMean;
-      const SimilaritiesValue movingVariance = movingSumOfSquares - numberOfVoxelInBlock * movingMean * movingMean;
       covariance -= numberOfVoxelInBlock * fixedMean * movingMean;
 
       SimilaritiesValue sim{};
@@ -368,10 +523,30 @@ BlockMatchingImageFilter<TFixedImage, TMovingImage, TFeatures, TDisplacements, T
       if (sim >= similarity)
       {
         FeaturePointsPhysicalCoordinates newLocation;
-        fixedImage->TransformIndexToPhysicalPoint(windowIterator.GetIndex(), newLocation);
+        fixedImage->TransformIndexToPhysicalPoint(start + windowOffset, newLocation);
         displacement = newLocation - originalLocation;
         similarity = sim;
       }
+
+      // next candidate center
+      unsigned int d = 0;
+      for (; d < ImageDimension; ++d)
+      {
+        if (static_cast<SizeValueType>(windowOffset[d]) + 1 < windowSize[d])
+        {
+          ++windowOffset[d];
+          areaOffset += areaStrides[d];
+          tableOffset += tableStrides[d];
+          break;
+        }
+        areaOffset -= windowOffset[d] * areaStrides[d];
+        tableOffset -= windowOffset[d] * tableStrides[d];
+        windowOffset[d] = 0;
+      }
+      if (d == ImageDimension)
+      {
+        break;
+      }
     }
     this->m_DisplacementsVectorsArray[idx] = displacement;
     this->m_SimilaritiesValuesArray[idx] = similarity;
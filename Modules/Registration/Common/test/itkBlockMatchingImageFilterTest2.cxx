@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBlockMatchingImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+/*
+ * Match the blocks of a synthetic image with a translated copy of it, and
+ * verify that the translation is found for the feature points away from the
+ * boundary, that the feature points close to the boundary are matched too,
+ * and that the results do not depend on the number of work units.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+constexpr unsigned int ImageSize = 32;
+
+using ImageType = itk::Image<float, Dimension>;
+using BlockMatchingFilterType = itk::BlockMatchingImageFilter<ImageType>;
+using PointSetType = BlockMatchingFilterType::FeaturePointsType;
+
+ImageType::Pointer
+CreateImage(const ImageType::OffsetType & translation)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(ImageSize));
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex() - translation;
+    const double               x = index[0];
+    const double               y = index[1];
+    const double               z = index[2];
+    it.Set(static_cast<float>(100.0 + 50.0 * std::sin(0.7 * x + 0.3 * y) * std::cos(0.5 * z - 0.2 * x) +
+                              30.0 * std::sin(0.13 * x * y + 0.4 * z)));
+  }
+  return image;
+}
+} // namespace
+
+int
+itkBlockMatchingImageFilterTest2(int, char *[])
+{
+  const ImageType::OffsetType translation = { { 2, -1, 1 } };
+  const auto                  fixedImage = CreateImage(translation);
+  const auto                  movingImage = CreateImage(ImageType::OffsetType{});
+
+  BlockMatchingFilterType::ImageSizeType blockRadius;
+  blockRadius.Fill(2);
+  BlockMatchingFilterType::ImageSizeType searchRadius;
+  searchRadius.Fill(3);
+  searchRadius[2] = 2;
+
+  // feature points on a grid covering the whole image
+  auto         featurePoints = PointSetType::New();
+  unsigned int numberOfPoints = 0;
+  for (unsigned int k = 0; k < ImageSize; k += 5)
+  {
+    for (unsigned int j = 0; j < ImageSize; j += 4)
+    {
+      for (unsigned int i = 0; i < ImageSize; i += 3)
+      {
+        PointSetType::PointType point;
+        point[0] = i;
+        point[1] = j;
+        point[2] = k;
+        featurePoints->SetPoint(numberOfPoints++, point);
+      }
+    }
+  }
+
+  BlockMatchingFilterType::DisplacementsType::PointDataContainer::Pointer referenceDisplacements;
+  BlockMatchingFilterType::SimilaritiesType::PointDataContainer::Pointer  referenceSimilarities;
+  for (const unsigned int numberOfWorkUnits : { 1, 3 })
+  {
+    auto blockMatchingFilter = BlockMatchingFilterType::New();
+    blockMatchingFilter->SetFixedImage(fixedImage);
+    blockMatchingFilter->SetMovingImage(movingImage);
+    blockMatchingFilter->SetFeaturePoints(featurePoints);
+    blockMatchingFilter->SetBlockRadius(blockRadius);
+    blockMatchingFilter->SetSearchRadius(searchRadius);
+    blockMatchingFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(blockMatchingFilter->Update());
+
+    const auto * displacements = blockMatchingFilter->GetDisplacements()->GetPointData();
+    const auto * similarities = blockMatchingFilter->GetSimilarities()->GetPointData();
+    ITK_TEST_EXPECT_EQUAL(displacements->Size(), numberOfPoints);
+    ITK_TEST_EXPECT_EQUAL(similarities->Size(), numberOfPoints);
+
+    unsigned int numberOfInteriorPoints = 0;
+    for (unsigned int p = 0; p < numberOfPoints; ++p)
+    {
+      const auto                                       displacement = displacements->GetElement(p);
+      const BlockMatchingFilterType::SimilaritiesValue similarity = similarities->GetElement(p);
+      if (!(similarity >= 0.0 && similarity <= 1.0 + 1e-9))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error: similarity " << similarity << " of point " << p << " is not within [0, 1]" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // points whose search area lies within the image
+      const PointSetType::PointType point = featurePoints->GetPoint(p);
+      bool                          interior = true;
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        const double margin = searchRadius[d] + blockRadius[d];
+        interior &= point[d] >= margin && point[d] + margin < ImageSize;
+      }
+      if (interior)
+      {
+        ++numberOfInteriorPoints;
+        for (unsigned int d = 0; d < Dimension; ++d)
+        {
+          if (itk::Math::NotAlmostEquals(displacement[d], translation[d]) || similarity < 1.0 - 1e-6)
+          {
+            std::cerr << "Test failed!" << std::endl;
+            std::cerr << "Error: displacement " << displacement << " with similarity " << similarity << " of point "
+                      << point << " differs from the translation " << translation << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+
+      if (referenceDisplacements &&
+          (displacement != referenceDisplacements->GetElement(p) || similarity != referenceSimilarities->GetElement(p)))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error: results of point " << p << " differ with " << numberOfWorkUnits << " work units"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    ITK_TEST_EXPECT_TRUE(numberOfInteriorPoints > 0);
+
+    referenceDisplacements = blockMatchingFilter->GetDisplacements()->GetPointData();
+    referenceSimilarities = blockMatchingFilter->GetSimilarities()->GetPointData();
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
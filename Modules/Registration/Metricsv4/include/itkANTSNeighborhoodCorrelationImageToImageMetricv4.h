@@ -52,8 +52,10 @@ namespace itk
  * the evaluation up considerably and works well in practice. This assumption
  * is the main differentiation of this approach from a more generic one.
  *
- * 2) The evaluation uses on-the-fly queues with multi-threading and a sliding
- * neighborhood window. This is described in the above paper and specifically
+ * 2) The local sums of the dense evaluation are computed with separable box
+ * filters over the region of each thread, so that the images are evaluated
+ * about once per voxel whatever the radius. This replaces the sliding
+ * neighborhood window described in the above paper, and is specifically
  * optimized for dense registration.
  *
  *  Example of usage:
@@ -21,10 +21,9 @@
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
 #include "itkThreadedImageRegionPartitioner.h"
 #include "itkThreadedIndexedContainerPartitioner.h"
-#include "itkConstNeighborhoodIterator.h"
 
-#include <deque>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -41,10 +40,12 @@ struct IdentityHelper
 
 /** \class ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader
  * \brief Threading implementation for ANTS CC metric \c ANTSNeighborhoodCorrelationImageToImageMetricv4 .
- * Supports both dense and sparse threading ways. The dense threader iterates over the whole image domain
- * in order and use a neighborhood scanning window to compute the local cross correlation metric and
- * its derivative incrementally inside the window. The sparse threader uses a sampled point set partitioner to
- * computer local cross correlation only at the sampled positions.
+ * Supports both dense and sparse threading ways. The dense threader evaluates the fixed and moving images
+ * once per voxel of its sub region, padded by the radius, and computes the sums of the local cross correlation
+ * over the neighborhood windows with separable box filters. The slices of the last dimension are box filtered
+ * along the other dimensions as they are evaluated, and the window sums of a voxel add the filtered slices
+ * of its window, kept in a ring buffer. The sparse threader uses a sampled point set partitioner to compute
+ * the local cross correlation only at the sampled positions, summing over the window of each sample.
  *
  * This threader class is designed to host the dense and sparse threader under the same name so most computation
  * routine functions and interior member variables can be shared. This eliminates the need to duplicate codes
@@ -98,51 +99,46 @@ public:
   using MovingImageType = typename NeighborhoodCorrelationMetricType::MovingImageType;
   using RadiusType = typename NeighborhoodCorrelationMetricType::RadiusType;
 
-  // interested values here updated during scanning
-  using QueueRealType = InternalComputationValueType;
-  using SumQueueType = std::deque<QueueRealType>;
-  using ScanIteratorType = ConstNeighborhoodIterator<VirtualImageType>;
-
-  // one ScanMemType for each thread
-  struct ScanMemType
+  /** Terms of the local cross correlation of one voxel, or their sums over
+   * a set of voxels: the number of valid voxels, the sums of the fixed and
+   * moving values, of their squares and of their product. */
+  struct WindowSumsType
   {
-    // queues used in the scanning
-    // sum of the fixed value squared
-    SumQueueType QsumFixed2;
-    // sum of the moving value squared
-    SumQueueType QsumMoving2;
-    SumQueueType QsumFixed;
-    SumQueueType QsumMoving;
-    SumQueueType QsumFixedMoving;
-    SumQueueType Qcount;
-
-    QueueRealType fixedA;
-    QueueRealType movingA;
-    QueueRealType sFixedMoving;
-    QueueRealType sFixedFixed;
-    QueueRealType sMovingMoving;
-
-    FixedImageGradientType  fixedImageGradient;
-    MovingImageGradientType movingImageGradient;
-
-    FixedImagePointType  mappedFixedPoint;
-    MovingImagePointType mappedMovingPoint;
-    VirtualPointType     virtualPoint;
+    InternalComputationValueType Count;
+    InternalComputationValueType Fixed;
+    InternalComputationValueType Moving;
+    InternalComputationValueType Fixed2;
+    InternalComputationValueType Moving2;
+    InternalComputationValueType FixedMoving;
+
+    WindowSumsType &
+    operator+=(const WindowSumsType & other)
+    {
+      Count += other.Count;
+      Fixed += other.Fixed;
+      Moving += other.Moving;
+      Fixed2 += other.Fixed2;
+      Moving2 += other.Moving2;
+      FixedMoving += other.FixedMoving;
+      return *this;
+    }
   };
 
-  // For dense scan over one image region
-  struct ScanParametersType
+  // The local cross correlation information of the current voxel
+  struct ScanMemType
   {
-    // const values during scanning
-    ImageRegionType scanRegion;
-    SizeValueType   numberOfFillZero; // for each queue
-    SizeValueType   windowLength;     // number of voxels in the scanning window
-    IndexValueType  scanRegionBeginIndexDim0;
-
-    typename FixedImageType::ConstPointer   fixedImage;
-    typename MovingImageType::ConstPointer  movingImage;
-    typename VirtualImageType::ConstPointer virtualImage;
-    RadiusType                              radius;
+    InternalComputationValueType fixedA{};
+    InternalComputationValueType movingA{};
+    InternalComputationValueType sFixedMoving{};
+    InternalComputationValueType sFixedFixed{};
+    InternalComputationValueType sMovingMoving{};
+
+    FixedImageGradientType  fixedImageGradient{};
+    MovingImageGradientType movingImageGradient{};
+
+    FixedImagePointType  mappedFixedPoint{};
+    MovingImagePointType mappedMovingPoint{};
+    VirtualPointType     virtualPoint{};
   };
 
 protected:
@@ -247,53 +243,37 @@ protected:
   void
   ThreadedExecution_impl(IdentityHelper<T> itkNotUsed(self), const DomainType & domain, const ThreadIdType threadId);
 
-  /** Common functions for computing correlation over scanning windows **/
+  /** Common functions for computing correlation over neighborhood windows **/
 
-  /** Create an iterator over the virtual sub region */
-  void
-  InitializeScanning(const ImageRegionType & scanRegion,
-                     ScanIteratorType &      scanIt,
-                     ScanMemType &           scanMem,
-                     ScanParametersType &    scanParameters) const;
+  /** Evaluate the images at a virtual index, and return the terms of the
+   * local cross correlation of the voxel, which are zero if it is not valid. */
+  WindowSumsType
+  EvaluateWindowTerms(const VirtualIndexType & virtualIndex) const;
 
-  /** Update the queues for the next point.  Calls either \c
-   * UpdateQueuesAtBeginningOfLine or \c UpdateQueuesToNextScanWindow. */
-  void
-  UpdateQueues(const ScanIteratorType &   scanIt,
-               ScanMemType &              scanMem,
-               const ScanParametersType & scanParameters,
-               const ThreadIdType         threadId) const;
+  /** Sum the terms of the voxels of the window. */
+  WindowSumsType
+  ComputeWindowSums(const ImageRegionType & window) const;
 
+  /** Evaluate the images at the slice of the last dimension of the padded
+   * tile, and box filter the terms along the other dimensions. */
   void
-  UpdateQueuesAtBeginningOfLine(const ScanIteratorType &   scanIt,
-                                ScanMemType &              scanMem,
-                                const ScanParametersType & scanParameters,
-                                const ThreadIdType         threadId) const;
-
-  /** Increment the iterator and check to see if we're at the end of the
-   * line.  If so, go to the next line.  Otherwise, add the
-   * the values for the next hyperplane. */
-  void
-  UpdateQueuesToNextScanWindow(const ScanIteratorType &   scanIt,
-                               ScanMemType &              scanMem,
-                               const ScanParametersType & scanParameters,
-                               const ThreadIdType         threadId) const;
+  ComputeSliceWindowSums(const ImageRegionType &       paddedSlice,
+                         WindowSumsType *              slice,
+                         std::vector<WindowSumsType> & lineBuffer) const;
 
-  /** Test to see if there are any voxels we need to handle in the current
-   * window. */
+  /** Compute the local cross correlation information at the center of a
+   * window from the sums of the window. Returns false if the center or all
+   * the voxels of the window are not valid. */
   bool
-  ComputeInformationFromQueues(const ScanIteratorType &   scanIt,
-                               ScanMemType &              scanMem,
-                               const ScanParametersType & scanParameters,
-                               const ThreadIdType         threadId) const;
+  ComputeInformationFromWindowSums(const VirtualIndexType & virtualIndex,
+                                   const WindowSumsType &   sums,
+                                   ScanMemType &            scanMem) const;
 
   void
-  ComputeMovingTransformDerivative(const ScanIteratorType &   scanIt,
-                                   ScanMemType &              scanMem,
-                                   const ScanParametersType & scanParameters,
-                                   DerivativeType &           deriv,
-                                   MeasureType &              localCC,
-                                   const ThreadIdType         threadId) const;
+  ComputeMovingTransformDerivative(ScanMemType &      scanMem,
+                                   DerivativeType &   deriv,
+                                   MeasureType &      localCC,
+                                   const ThreadIdType threadId) const;
 
 private:
   /** Internal pointer to the metric object in use by this threader.
@@ -18,6 +18,9 @@
 #ifndef itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 #define itkANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader_hxx
 
+#include "itkIndexRange.h"
+
+#include <algorithm>
 
 namespace itk
 {
@@ -41,62 +44,139 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
 
   std::call_once(this->m_ANTSAssociateOnceFlag, [this, &associate]() { this->m_ANTSAssociate = associate; });
 
-  VirtualPointType   virtualPoint;
-  MeasureType        metricValueResult{};
-  MeasureType        metricValueSum{};
-  bool               pointIsValid;
-  ScanIteratorType   scanIt;
-  ScanParametersType scanParameters;
-  ScanMemType        scanMem;
+  constexpr unsigned int lastDimension = TImageToImageMetric::VirtualImageDimension - 1;
+  // Maximum number of window terms buffered by each thread
+  constexpr SizeValueType maximumBufferSize = SizeValueType{ 1 } << 18;
 
-  DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
+  const RadiusType        radius = associate->GetRadius();
+  const ImageRegionType & virtualRegion = associate->GetVirtualRegion();
 
-  /* Create an iterator over the virtual sub region */
-  // associate->InitializeScanning( virtualImageSubRegion, scanIt, scanMem, scanParameters );
-  this->InitializeScanning(virtualImageSubRegion, scanIt, scanMem, scanParameters);
+  ImageRegionType paddedRegion = virtualImageSubRegion;
+  paddedRegion.PadByRadius(radius);
+  if (!paddedRegion.Crop(virtualRegion))
+  {
+    return;
+  }
 
-  /* Iterate over the sub region */
-  scanIt.GoToBegin();
-  while (!scanIt.IsAtEnd())
+  /* The filtered slices of the last dimension in the window of the current
+   * slice are kept in a ring buffer. The sub region is split into tiles along
+   * the next to last dimension so that the buffer fits in maximumBufferSize. */
+  const SizeValueType ringLength = std::min<SizeValueType>(2 * radius[lastDimension] + 1,
+                                                           paddedRegion.GetSize(lastDimension));
+  SizeValueType       tileLength = 1;
+  SizeValueType       maximumSliceSize = 1;
+  if constexpr (lastDimension > 0)
   {
-    /* Get the virtual point */
-    associate->TransformVirtualIndexToPhysicalPoint(scanIt.GetIndex(), virtualPoint);
+    constexpr unsigned int tileDimension = lastDimension - 1;
+    SizeValueType          rowSize = 1;
+    for (unsigned int d = 0; d < tileDimension; ++d)
+    {
+      rowSize *= paddedRegion.GetSize(d);
+    }
+    const SizeValueType maximumPaddedTileLength =
+      std::max<SizeValueType>(maximumBufferSize / (rowSize * (ringLength + 1)), 2 * radius[tileDimension] + 1);
+    tileLength = std::min<SizeValueType>(maximumPaddedTileLength - 2 * radius[tileDimension],
+                                         virtualImageSubRegion.GetSize(tileDimension));
+    maximumSliceSize = rowSize * std::min<SizeValueType>(tileLength + 2 * radius[tileDimension],
+                                                         paddedRegion.GetSize(tileDimension));
+  }
+  std::vector<WindowSumsType> ring(ringLength * maximumSliceSize);
+  std::vector<WindowSumsType> lineBuffer(maximumSliceSize);
+
+  std::vector<const WindowSumsType *> windowSlices(ringLength);
 
-    /* Call the user method in derived classes to do the specific
-     * calculations for value and derivative. */
-    try
+  MeasureType      metricValueResult{};
+  MeasureType      metricValueSum{};
+  ScanMemType      scanMem;
+  DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
+
+  SizeValueType numberOfTiles = 1;
+  if constexpr (lastDimension > 0)
+  {
+    numberOfTiles = (virtualImageSubRegion.GetSize(lastDimension - 1) + tileLength - 1) / tileLength;
+  }
+  for (SizeValueType tileNumber = 0; tileNumber < numberOfTiles; ++tileNumber)
+  {
+    ImageRegionType tile = virtualImageSubRegion;
+    ImageRegionType paddedTile = paddedRegion;
+    if constexpr (lastDimension > 0)
     {
-      this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
-      pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
-      if (pointIsValid)
-      {
-        this->ComputeMovingTransformDerivative(
-          scanIt, scanMem, scanParameters, localDerivativeResult, metricValueResult, threadId);
-      }
+      constexpr unsigned int tileDimension = lastDimension - 1;
+      const SizeValueType    tileOffset = tileNumber * tileLength;
+      tile.SetIndex(tileDimension,
+                    virtualImageSubRegion.GetIndex(tileDimension) + static_cast<IndexValueType>(tileOffset));
+      tile.SetSize(tileDimension, std::min(tileLength, virtualImageSubRegion.GetSize(tileDimension) - tileOffset));
+      paddedTile = tile;
+      paddedTile.PadByRadius(radius);
+      paddedTile.Crop(virtualRegion);
     }
-    catch (const ExceptionObject & exc)
+
+    SizeValueType                        sliceSize = 1;
+    typename ImageRegionType::OffsetType sliceOffsetTable{};
+    for (unsigned int d = 0; d < lastDimension; ++d)
     {
-      // NOTE: there must be a cleaner way to do this:
-      std::string msg("Caught exception: \n");
-      msg += exc.what();
-      throw ExceptionObject(__FILE__, __LINE__, msg);
+      sliceOffsetTable[d] = static_cast<OffsetValueType>(sliceSize);
+      sliceSize *= paddedTile.GetSize(d);
     }
 
-    /* Assign the results */
-    if (pointIsValid)
+    const IndexValueType firstSlice = paddedTile.GetIndex(lastDimension);
+    const IndexValueType lastSlice = firstSlice + static_cast<IndexValueType>(paddedTile.GetSize(lastDimension)) - 1;
+    IndexValueType       nextSlice = firstSlice;
+
+    const IndexValueType tileBegin = tile.GetIndex(lastDimension);
+    const IndexValueType tileEnd = tileBegin + static_cast<IndexValueType>(tile.GetSize(lastDimension));
+    for (IndexValueType currentSlice = tileBegin; currentSlice < tileEnd; ++currentSlice)
     {
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
-      metricValueSum -= metricValueResult;
-      /* Store the result. This depends on what type of
-       * transform is being used. */
-      if (this->GetComputeDerivative())
+      /* Filter the slices up to the end of the window of the current slice */
+      const IndexValueType windowBegin =
+        std::max(currentSlice - static_cast<IndexValueType>(radius[lastDimension]), firstSlice);
+      const IndexValueType windowEnd =
+        std::min(currentSlice + static_cast<IndexValueType>(radius[lastDimension]), lastSlice);
+      for (; nextSlice <= windowEnd; ++nextSlice)
       {
-        this->StorePointDerivativeResult(scanIt.GetIndex(), threadId);
+        ImageRegionType paddedSlice = paddedTile;
+        paddedSlice.SetIndex(lastDimension, nextSlice);
+        paddedSlice.SetSize(lastDimension, 1);
+        this->ComputeSliceWindowSums(
+          paddedSlice, &ring[((nextSlice - firstSlice) % ringLength) * sliceSize], lineBuffer);
       }
-    }
+      SizeValueType numberOfWindowSlices = 0;
+      for (IndexValueType windowSlice = windowBegin; windowSlice <= windowEnd; ++windowSlice)
+      {
+        windowSlices[numberOfWindowSlices++] = &ring[((windowSlice - firstSlice) % ringLength) * sliceSize];
+      }
+
+      ImageRegionType currentSliceRegion = tile;
+      currentSliceRegion.SetIndex(lastDimension, currentSlice);
+      currentSliceRegion.SetSize(lastDimension, 1);
+      for (const VirtualIndexType & virtualIndex : ImageRegionIndexRange<lastDimension + 1>(currentSliceRegion))
+      {
+        OffsetValueType offset = 0;
+        for (unsigned int d = 0; d < lastDimension; ++d)
+        {
+          offset += (virtualIndex[d] - paddedTile.GetIndex(d)) * sliceOffsetTable[d];
+        }
+        WindowSumsType sums{};
+        for (SizeValueType i = 0; i < numberOfWindowSlices; ++i)
+        {
+          sums += windowSlices[i][offset];
+        }
 
-    // next index
-    ++scanIt;
+        /* Assign the results */
+        if (this->ComputeInformationFromWindowSums(virtualIndex, sums, scanMem))
+        {
+          this->ComputeMovingTransformDerivative(scanMem, localDerivativeResult, metricValueResult, threadId);
+          this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+          metricValueSum -= metricValueResult;
+          /* Store the result. This depends on what type of
+           * transform is being used. */
+          if (this->GetComputeDerivative())
+          {
+            this->StorePointDerivativeResult(virtualIndex, threadId);
+          }
+        }
+      }
+    }
   }
 
   /* Store metric value result for this thread. */
@@ -125,186 +205,48 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
-void
+auto
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   TDomainPartitioner,
   TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::UpdateQueuesAtBeginningOfLine(const ScanIteratorType &   scanIt,
-                                                                 ScanMemType &              scanMem,
-                                                                 const ScanParametersType & scanParameters,
-                                                                 const ThreadIdType) const
+  TNeighborhoodCorrelationMetric>::EvaluateWindowTerms(const VirtualIndexType & virtualIndex) const -> WindowSumsType
 {
-  const SizeValueType numberOfFillZero = scanParameters.numberOfFillZero;
-  const SizeValueType hoodlen = scanParameters.windowLength;
+  VirtualPointType     virtualPoint;
+  FixedImagePointType  mappedFixedPoint;
+  FixedImagePixelType  fixedImageValue;
+  MovingImagePointType mappedMovingPoint;
+  MovingImagePixelType movingImageValue;
 
-  InternalComputationValueType zero{};
-  scanMem.QsumFixed2 = SumQueueType(numberOfFillZero, zero);
-  scanMem.QsumMoving2 = SumQueueType(numberOfFillZero, zero);
-  scanMem.QsumFixed = SumQueueType(numberOfFillZero, zero);
-  scanMem.QsumMoving = SumQueueType(numberOfFillZero, zero);
-  scanMem.QsumFixedMoving = SumQueueType(numberOfFillZero, zero);
-  scanMem.Qcount = SumQueueType(numberOfFillZero, zero);
+  this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(virtualIndex, virtualPoint);
 
-  using LocalRealType = InternalComputationValueType;
-
-  // Now add the rest of the values from each hyperplane
-  SizeValueType diameter = 2 * scanParameters.radius[0];
-
-  const LocalRealType localZero{};
-  for (SizeValueType i = numberOfFillZero; i < (diameter + NumericTraits<SizeValueType>::OneValue()); ++i)
+  WindowSumsType terms{};
+  if (this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue) &&
+      this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue))
   {
-    LocalRealType sumFixed2 = localZero;
-    LocalRealType sumMoving2 = localZero;
-    LocalRealType sumFixed = localZero;
-    LocalRealType sumMoving = localZero;
-    LocalRealType sumFixedMoving = localZero;
-    LocalRealType count = localZero;
-
-    for (SizeValueType indct = i; indct < hoodlen; indct += (diameter + NumericTraits<SizeValueType>::OneValue()))
-    {
-      typename ScanIteratorType::OffsetType internalIndex, offset;
-      bool                                  isInBounds = scanIt.IndexInBounds(indct, internalIndex, offset);
-      if (!isInBounds)
-      {
-        // std::cout << "DEBUG: error" << std::endl;
-        continue;
-      }
-
-      typename VirtualImageType::IndexType index = scanIt.GetIndex(indct);
-
-      VirtualPointType     virtualPoint;
-      FixedImagePointType  mappedFixedPoint;
-      FixedImagePixelType  fixedImageValue;
-      MovingImagePointType mappedMovingPoint;
-      MovingImagePixelType movingImageValue;
-      bool                 pointIsValid;
-
-      this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(index, virtualPoint);
-
-      try
-      {
-        pointIsValid =
-          this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue);
-        if (pointIsValid)
-        {
-          pointIsValid =
-            this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
-        }
-      }
-      catch (const ExceptionObject & exc)
-      {
-        // NOTE: there must be a cleaner way to do this:
-        std::string msg("Caught exception: \n");
-        msg += exc.what();
-        throw ExceptionObject(__FILE__, __LINE__, msg);
-      }
-
-
-      if (pointIsValid)
-      {
-        sumFixed2 += fixedImageValue * fixedImageValue;
-        sumMoving2 += movingImageValue * movingImageValue;
-        sumFixed += fixedImageValue;
-        sumMoving += movingImageValue;
-        sumFixedMoving += fixedImageValue * movingImageValue;
-        count += NumericTraits<LocalRealType>::OneValue();
-      }
-    } // for indct
-
-    scanMem.QsumFixed2.push_back(sumFixed2);
-    scanMem.QsumMoving2.push_back(sumMoving2);
-    scanMem.QsumFixed.push_back(sumFixed);
-    scanMem.QsumMoving.push_back(sumMoving);
-    scanMem.QsumFixedMoving.push_back(sumFixedMoving);
-    scanMem.Qcount.push_back(count);
+    terms.Count = NumericTraits<InternalComputationValueType>::OneValue();
+    terms.Fixed = fixedImageValue;
+    terms.Moving = movingImageValue;
+    terms.Fixed2 = fixedImageValue * fixedImageValue;
+    terms.Moving2 = movingImageValue * movingImageValue;
+    terms.FixedMoving = fixedImageValue * movingImageValue;
   }
+  return terms;
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
-void
+auto
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   TDomainPartitioner,
   TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::UpdateQueuesToNextScanWindow(const ScanIteratorType &   scanIt,
-                                                                ScanMemType &              scanMem,
-                                                                const ScanParametersType & scanParameters,
-                                                                const ThreadIdType) const
+  TNeighborhoodCorrelationMetric>::ComputeWindowSums(const ImageRegionType & window) const -> WindowSumsType
 {
-  const SizeValueType hoodlen = scanParameters.windowLength;
-
-  using LocalRealType = InternalComputationValueType;
-
-  const LocalRealType localZero{};
-
-  LocalRealType sumFixed2 = localZero;
-  LocalRealType sumMoving2 = localZero;
-  LocalRealType sumFixed = localZero;
-  LocalRealType sumMoving = localZero;
-  LocalRealType sumFixedMoving = localZero;
-  LocalRealType count = localZero;
-
-  SizeValueType diameter = 2 * scanParameters.radius[0];
-
-  for (SizeValueType indct = diameter; indct < hoodlen; indct += (diameter + NumericTraits<SizeValueType>::OneValue()))
+  WindowSumsType sums{};
+  for (const VirtualIndexType & virtualIndex :
+       ImageRegionIndexRange<TImageToImageMetric::VirtualImageDimension>(window))
   {
-    typename ScanIteratorType::OffsetType internalIndex, offset;
-    bool                                  isInBounds = scanIt.IndexInBounds(indct, internalIndex, offset);
-
-    if (!isInBounds)
-    {
-      continue;
-    }
-
-    typename VirtualImageType::IndexType index = scanIt.GetIndex(indct);
-
-    VirtualPointType     virtualPoint;
-    FixedImagePointType  mappedFixedPoint;
-    FixedImagePixelType  fixedImageValue;
-    MovingImagePointType mappedMovingPoint;
-    MovingImagePixelType movingImageValue;
-    bool                 pointIsValid;
-
-    this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(index, virtualPoint);
-    try
-    {
-      pointIsValid =
-        this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue);
-      if (pointIsValid)
-      {
-        pointIsValid =
-          this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
-      }
-    }
-    catch (const ExceptionObject & exc)
-    {
-      // NOTE: there must be a cleaner way to do this:
-      std::string msg("Caught exception: \n");
-      msg += exc.what();
-      throw ExceptionObject(__FILE__, __LINE__, msg);
-    }
-    if (pointIsValid)
-    {
-      sumFixed2 += fixedImageValue * fixedImageValue;
-      sumMoving2 += movingImageValue * movingImageValue;
-      sumFixed += fixedImageValue;
-      sumMoving += movingImageValue;
-      sumFixedMoving += fixedImageValue * movingImageValue;
-      count += NumericTraits<LocalRealType>::OneValue();
-    }
+    sums += this->EvaluateWindowTerms(virtualIndex);
   }
-  scanMem.QsumFixed2.push_back(sumFixed2);
-  scanMem.QsumMoving2.push_back(sumMoving2);
-  scanMem.QsumFixed.push_back(sumFixed);
-  scanMem.QsumMoving.push_back(sumMoving);
-  scanMem.QsumFixedMoving.push_back(sumFixedMoving);
-  scanMem.Qcount.push_back(count);
-
-  scanMem.QsumFixed2.pop_front();
-  scanMem.QsumMoving2.pop_front();
-  scanMem.QsumFixed.pop_front();
-  scanMem.QsumMoving.pop_front();
-  scanMem.QsumFixedMoving.pop_front();
-  scanMem.Qcount.pop_front();
+  return sums;
 }
 
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
@@ -312,118 +254,81 @@ void
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   TDomainPartitioner,
   TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::InitializeScanning(const ImageRegionType & scanRegion,
-                                                      ScanIteratorType &      scanIt,
-                                                      ScanMemType &           scanMem,
-                                                      ScanParametersType &    scanParameters) const
+  TNeighborhoodCorrelationMetric>::ComputeSliceWindowSums(const ImageRegionType &       paddedSlice,
+                                                          WindowSumsType *              slice,
+                                                          std::vector<WindowSumsType> & lineBuffer) const
 {
-  scanParameters.scanRegion = scanRegion;
-  scanParameters.fixedImage = this->m_ANTSAssociate->m_FixedImage;
-  scanParameters.movingImage = this->m_ANTSAssociate->m_MovingImage;
-  scanParameters.virtualImage = this->m_ANTSAssociate->GetVirtualImage();
-  scanParameters.radius = this->m_ANTSAssociate->GetRadius();
-
-  OffsetValueType numberOfFillZero =
-    this->m_ANTSAssociate->GetVirtualRegion().GetIndex(0) - (scanRegion.GetIndex(0) - scanParameters.radius[0]);
-
-  if (numberOfFillZero < NumericTraits<OffsetValueType>::ZeroValue())
+  WindowSumsType * terms = slice;
+  for (const VirtualIndexType & virtualIndex :
+       ImageRegionIndexRange<TImageToImageMetric::VirtualImageDimension>(paddedSlice))
   {
-    numberOfFillZero = NumericTraits<OffsetValueType>::ZeroValue();
+    *(terms++) = this->EvaluateWindowTerms(virtualIndex);
   }
 
-  scanParameters.numberOfFillZero = numberOfFillZero;
-
-  scanIt = ScanIteratorType(scanParameters.radius, scanParameters.virtualImage, scanRegion);
-  scanParameters.windowLength = scanIt.Size();
-  scanParameters.scanRegionBeginIndexDim0 = scanIt.GetBeginIndex()[0];
-
-  scanMem.fixedA = NumericTraits<QueueRealType>::ZeroValue();
-  scanMem.movingA = NumericTraits<QueueRealType>::ZeroValue();
-  scanMem.sFixedMoving = NumericTraits<QueueRealType>::ZeroValue();
-  scanMem.sFixedFixed = NumericTraits<QueueRealType>::ZeroValue();
-  scanMem.sMovingMoving = NumericTraits<QueueRealType>::ZeroValue();
-
-  scanMem.fixedImageGradient.Fill(0.0);
-  scanMem.movingImageGradient.Fill(0.0);
-  scanMem.mappedMovingPoint.Fill(0.0);
-}
-
-template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
-void
-ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
-  TDomainPartitioner,
-  TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::UpdateQueues(const ScanIteratorType &   scanIt,
-                                                ScanMemType &              scanMem,
-                                                const ScanParametersType & scanParameters,
-                                                const ThreadIdType         threadId) const
-{
-  if (scanIt.GetIndex()[0] == scanParameters.scanRegionBeginIndexDim0)
-  {
-    this->UpdateQueuesAtBeginningOfLine(scanIt, scanMem, scanParameters, threadId);
-  }
-  else
+  /* Box filter along each dimension but the last one. The slice is made of
+   * blocks of lines along the dimension, each line holding stride contiguous
+   * elements, so that the sums of the lines are done on contiguous memory.
+   * The windows are clipped to the padded slice, which is clipped to the
+   * virtual domain, and span the whole radius for the voxels of the tile. */
+  const RadiusType    radius = this->m_ANTSAssociate->GetRadius();
+  const SizeValueType sliceSize = paddedSlice.GetNumberOfPixels();
+  SizeValueType       stride = 1;
+  for (unsigned int d = 0; d + 1 < TImageToImageMetric::VirtualImageDimension; ++d)
   {
-    this->UpdateQueuesToNextScanWindow(scanIt, scanMem, scanParameters, threadId);
+    const auto          length = static_cast<OffsetValueType>(paddedSlice.GetSize(d));
+    const auto          dimensionRadius = static_cast<OffsetValueType>(radius[d]);
+    const SizeValueType blockSize = length * stride;
+    if (dimensionRadius > 0)
+    {
+      for (WindowSumsType * block = slice; block < slice + sliceSize; block += blockSize)
+      {
+        std::copy_n(block, blockSize, lineBuffer.begin());
+        for (OffsetValueType x = 0; x < length; ++x)
+        {
+          WindowSumsType * const out = block + x * stride;
+          std::fill_n(out, stride, WindowSumsType{});
+          for (OffsetValueType y = std::max<OffsetValueType>(x - dimensionRadius, 0),
+                               yEnd = std::min(x + dimensionRadius, length - 1);
+               y <= yEnd;
+               ++y)
+          {
+            const WindowSumsType * const in = lineBuffer.data() + y * stride;
+            for (SizeValueType i = 0; i < stride; ++i)
+            {
+              out[i] += in[i];
+            }
+          }
+        }
+      }
+    }
+    stride = blockSize;
   }
 }
 
-
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
 bool
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   TDomainPartitioner,
   TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::ComputeInformationFromQueues(const ScanIteratorType & scanIt,
-                                                                ScanMemType &            scanMem,
-                                                                const ScanParametersType &,
-                                                                const ThreadIdType) const
+  TNeighborhoodCorrelationMetric>::ComputeInformationFromWindowSums(const VirtualIndexType & virtualIndex,
+                                                                    const WindowSumsType &   sums,
+                                                                    ScanMemType &            scanMem) const
 {
   using LocalRealType = InternalComputationValueType;
 
-  const LocalRealType localZero{};
-
-  LocalRealType count = localZero;
-
-  auto itcount = scanMem.Qcount.begin();
-  while (itcount != scanMem.Qcount.end())
-  {
-    count += *itcount;
-    ++itcount;
-  }
-
-  if (count <= localZero)
+  const LocalRealType count = sums.Count;
+  if (count <= LocalRealType{})
   {
-    // no points available in the queue, perhaps out of image region
+    // no points available in the window, perhaps out of image region
     return false;
   }
 
   // If there are values, we need to calculate the different quantities
-  LocalRealType sumFixed2 = localZero;
-  LocalRealType sumMoving2 = localZero;
-  LocalRealType sumFixed = localZero;
-  LocalRealType sumMoving = localZero;
-  LocalRealType sumFixedMoving = localZero;
-  auto          itFixed2 = scanMem.QsumFixed2.begin();
-  auto          itMoving2 = scanMem.QsumMoving2.begin();
-  auto          itFixed = scanMem.QsumFixed.begin();
-  auto          itMoving = scanMem.QsumMoving.begin();
-  auto          itFixedMoving = scanMem.QsumFixedMoving.begin();
-
-  while (itFixed2 != scanMem.QsumFixed2.end())
-  {
-    sumFixed2 += *itFixed2;
-    sumMoving2 += *itMoving2;
-    sumFixed += *itFixed;
-    sumMoving += *itMoving;
-    sumFixedMoving += *itFixedMoving;
-
-    ++itFixed2;
-    ++itMoving2;
-    ++itFixed;
-    ++itMoving;
-    ++itFixedMoving;
-  }
+  const LocalRealType sumFixed2 = sums.Fixed2;
+  const LocalRealType sumMoving2 = sums.Moving2;
+  const LocalRealType sumFixed = sums.Fixed;
+  const LocalRealType sumMoving = sums.Moving;
+  const LocalRealType sumFixedMoving = sums.FixedMoving;
 
   LocalRealType fixedMean = sumFixed / count;
   LocalRealType movingMean = sumMoving / count;
@@ -434,8 +339,6 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   LocalRealType sFixedMoving =
     sumFixedMoving - movingMean * sumFixed - fixedMean * sumMoving + count * movingMean * fixedMean;
 
-  typename VirtualImageType::IndexType oindex = scanIt.GetIndex();
-
   VirtualPointType        virtualPoint;
   FixedImagePointType     mappedFixedPoint;
   FixedImagePixelType     fixedImageValue;
@@ -445,36 +348,25 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   MovingImageGradientType movingImageGradient;
   bool                    pointIsValid;
 
-  this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(oindex, virtualPoint);
+  this->m_ANTSAssociate->TransformVirtualIndexToPhysicalPoint(virtualIndex, virtualPoint);
 
-  try
+  pointIsValid = this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue);
+  if (pointIsValid)
   {
     pointIsValid =
-      this->m_ANTSAssociate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, fixedImageValue);
-    if (pointIsValid)
+      this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
+    if (pointIsValid && this->m_ANTSAssociate->GetComputeDerivative())
     {
-      pointIsValid =
-        this->m_ANTSAssociate->TransformAndEvaluateMovingPoint(virtualPoint, mappedMovingPoint, movingImageValue);
-      if (pointIsValid && this->m_ANTSAssociate->GetComputeDerivative())
+      if (this->m_ANTSAssociate->GetGradientSourceIncludesFixed())
       {
-        if (this->m_ANTSAssociate->GetGradientSourceIncludesFixed())
-        {
-          this->m_ANTSAssociate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, fixedImageGradient);
-        }
-        if (this->m_ANTSAssociate->GetGradientSourceIncludesMoving())
-        {
-          this->m_ANTSAssociate->ComputeMovingImageGradientAtPoint(mappedMovingPoint, movingImageGradient);
-        }
+        this->m_ANTSAssociate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, fixedImageGradient);
+      }
+      if (this->m_ANTSAssociate->GetGradientSourceIncludesMoving())
+      {
+        this->m_ANTSAssociate->ComputeMovingImageGradientAtPoint(mappedMovingPoint, movingImageGradient);
       }
     }
   }
-  catch (const ExceptionObject & exc)
-  {
-    // NOTE: there must be a cleaner way to do this:
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    throw ExceptionObject(__FILE__, __LINE__, msg);
-  }
 
   if (pointIsValid)
   {
@@ -506,9 +398,7 @@ void
 ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   TDomainPartitioner,
   TImageToImageMetric,
-  TNeighborhoodCorrelationMetric>::ComputeMovingTransformDerivative(const ScanIteratorType &,
-                                                                    ScanMemType & scanMem,
-                                                                    const ScanParametersType &,
+  TNeighborhoodCorrelationMetric>::ComputeMovingTransformDerivative(ScanMemType &      scanMem,
                                                                     DerivativeType &   deriv,
                                                                     MeasureType &      localCC,
                                                                     const ThreadIdType threadId) const
@@ -549,19 +439,11 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
     }
 
     /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      scanMem.virtualPoint, jacobian, jacobianPositional);
+    const NumberOfParametersType numberOfJacobianColumns =
+      this->ComputeMovingTransformJacobian(scanMem.virtualPoint, threadId);
+    const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-    NumberOfParametersType numberOfLocalParameters =
-      this->m_Associate->GetMovingTransform()->GetNumberOfLocalParameters();
-
-    for (NumberOfParametersType par = 0; par < numberOfLocalParameters; ++par)
+    for (NumberOfParametersType par = 0; par < numberOfJacobianColumns; ++par)
     {
       deriv[par] = NumericTraits<DerivativeValueType>::ZeroValue();
       for (ImageDimensionType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
@@ -573,8 +455,8 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
 }
 
 /*
- * Specific implementation for sparse threader. It reuse most of the routine from the dense threader by
- * reinitializing the scanning at every point.
+ * Specific implementation for sparse threader. It sums the terms over the
+ * window of the point, and reuses the computations of the dense threader.
  */
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TNeighborhoodCorrelationMetric>
 bool
@@ -586,58 +468,33 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<TDo
                            const VirtualPointType &                            itkNotUsed(virtualPoint),
                            const ThreadIdType                                  threadId)
 {
-
-  MeasureType        metricValueResult{};
-  bool               pointIsValid;
-  ScanIteratorType   scanIt;
-  ScanParametersType scanParameters;
-  ScanMemType        scanMem;
+  MeasureType metricValueResult{};
+  ScanMemType scanMem;
 
   DerivativeType & localDerivativeResult = this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives;
 
-
-  // convert virtualPoint to a single point region
-  typename ImageRegionType::SizeType singlePointSize;
-  singlePointSize.Fill(1);
-  const ImageRegionType singlePointRegion(virtualIndex, singlePointSize);
-
-  // use scanning variables just for a single point region
-  // iterate over the single point and initialize the scanning variables
-  this->InitializeScanning(singlePointRegion, scanIt, scanMem, scanParameters);
-
-  /* Iterate over the sub region of a single point*/
-  scanIt.GoToBegin();
-
-  try
+  // The window of the point, in the virtual domain
+  ImageRegionType window(virtualIndex, RadiusType::Filled(1));
+  window.PadByRadius(this->m_ANTSAssociate->GetRadius());
+  if (!window.Crop(this->m_ANTSAssociate->GetVirtualRegion()))
   {
-    pointIsValid = false;
-
-    this->UpdateQueues(scanIt, scanMem, scanParameters, threadId);
-    pointIsValid = this->ComputeInformationFromQueues(scanIt, scanMem, scanParameters, threadId);
-    if (pointIsValid)
-    {
-      this->ComputeMovingTransformDerivative(
-        scanIt, scanMem, scanParameters, localDerivativeResult, metricValueResult, threadId);
-    }
-  }
-  catch (const ExceptionObject & exc)
-  {
-    // NOTE: there must be a cleaner way to do this:
-    std::string msg("Caught exception: \n");
-    msg += exc.what();
-    throw ExceptionObject(__FILE__, __LINE__, msg);
+    return false;
   }
 
+  const bool pointIsValid =
+    this->ComputeInformationFromWindowSums(virtualIndex, this->ComputeWindowSums(window), scanMem);
+
   /* Assign the results */
   if (pointIsValid)
   {
+    this->ComputeMovingTransformDerivative(scanMem, localDerivativeResult, metricValueResult, threadId);
     this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
     this->m_GetValueAndDerivativePerThreadVariables[threadId].Measure -= metricValueResult;
     /* Store the result. This depends on what type of
      * transform is being used. */
     if (this->GetComputeDerivative())
     {
-      this->StorePointDerivativeResult(scanIt.GetIndex(), threadId);
+      this->StorePointDerivativeResult(virtualIndex, threadId);
     }
   }
 
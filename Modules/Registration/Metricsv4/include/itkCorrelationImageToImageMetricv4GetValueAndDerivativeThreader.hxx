@@ -190,13 +190,8 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
    * then we otherwise get when exceptions are caught in MultiThreaderBase. */
   try
   {
-    pointIsValid = this->m_CorrelationAssociate->TransformAndEvaluateFixedPoint(
-      virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
-    if (pointIsValid && this->m_CorrelationAssociate->GetComputeDerivative() &&
-        this->m_CorrelationAssociate->GetGradientSourceIncludesFixed())
-    {
-      this->m_CorrelationAssociate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
-    }
+    pointIsValid = this->TransformAndEvaluateFixedPoint(
+      virtualPoint, mappedFixedPoint, mappedFixedPixelValue, mappedFixedImageGradient, threadId);
   }
   catch (const ExceptionObject & exc)
   {
@@ -304,16 +299,13 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   if (this->m_CorrelationAssociate->GetComputeDerivative())
   {
     /* Use a pre-allocated jacobian object for efficiency */
-    using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-    JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-
-    /** For dense transforms, this returns identity */
-    this->m_CorrelationAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    const NumberOfParametersType numberOfJacobianColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+    const typename TImageToImageMetric::JacobianType & jacobian =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+    const NonZeroJacobianIndicesType & nonZeroJacobianIndices =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].NonZeroJacobianIndices;
 
-    for (unsigned int par = 0; par < this->m_CorrelationAssociate->GetNumberOfLocalParameters(); ++par)
+    for (NumberOfParametersType par = 0; par < numberOfJacobianColumns; ++par)
     {
       InternalComputationValueType sum{};
       for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
@@ -321,8 +313,9 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
         sum += movingImageGradient[dim] * jacobian(dim, par);
       }
 
-      cumsum.fdm[par] += f1 * sum;
-      cumsum.mdm[par] += m1 * sum;
+      const NumberOfParametersType parameterIndex = nonZeroJacobianIndices[par];
+      cumsum.fdm[parameterIndex] += f1 * sum;
+      cumsum.mdm[parameterIndex] += m1 * sum;
     }
   }
 
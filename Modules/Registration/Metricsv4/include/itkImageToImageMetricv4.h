@@ -27,11 +27,14 @@
 #include "itkThreadedIndexedContainerPartitioner.h"
 #include "itkThreadedImageRegionPartitioner.h"
 #include "itkImageToImageFilter.h"
+#include "itkCompositeTransform.h"
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
 #include "itkPointSet.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkDefaultImageToImageMetricTraitsv4.h"
 
+#include <vector>
+
 namespace itk
 {
 /** \class ImageToImageMetricv4
@@ -69,6 +72,9 @@ namespace itk
  *  calculated once, and for metrics that need to access image gradients more
  *  than once for a particular point. The fixed image gradients are only
  *  calculated once when this option is set, during \c Initialize.
+ *  The gradient images have the real type of the image pixels; for images
+ *  of double, FloatGradientImageToImageMetricTraitsv4 stores them as float,
+ *  which halves their memory.
  * 2) Otherwise, an image gradient calculator based on ImageFunction is used.
  *  By default the CentralDifferenceImageFunction is used. This calculation
  *  is not smoothed and gives different results than
@@ -100,13 +106,11 @@ namespace itk
  * SetFixedSampledPointSet is called or SetVirtualSampledPointSet
  * along with SetUseVirtualSampledPointSet.
  * \note If the point set is sparse, the option SetUse[Fixed|Moving]ImageGradientFilter
- * typically should be disabled to avoid excessive computation. However,
- * the gradient values of the fixed image are not cached
- * when using a point set (there are plans for this in the future), so
- * depending on the number of iterations (when used during optimization)
- * and the level of sparsity, it may be more efficient to
- * use a gradient image filter for it because it will only be
- * calculated once.
+ * typically should be disabled to avoid excessive computation. The fixed
+ * image values and gradients at the points, and the moving transform
+ * jacobians when they do not change with the transform parameters, can be
+ * computed once and reused by all the iterations of an optimization by
+ * enabling UseSampleCache.
  *
  * Vector Images
  *
@@ -462,6 +466,25 @@ public:
   itkGetConstReferenceMacro(UseVirtualSampledPointSet, bool);
   itkBooleanMacro(UseVirtualSampledPointSet);
 
+  /** Set/Get flag to cache, for each point of the sampled point set, the
+   * mapped fixed point, the fixed pixel value and the fixed image gradient,
+   * and the jacobian of the moving transform when it only depends on the
+   * fixed parameters of the transform, as for BSplineTransform.
+   * The cache is built by the first evaluation after Initialize(), and
+   * reused by the following evaluations, e.g. the iterations of a
+   * registration level, until the fixed image, the fixed transform, the
+   * sampled point set or the fixed parameters of the moving transform
+   * change. Only used with UseSampledPointSet. Off by default. */
+  itkSetMacro(UseSampleCache, bool);
+  itkGetConstReferenceMacro(UseSampleCache, bool);
+  itkBooleanMacro(UseSampleCache);
+
+  /** Set/Get the maximum size, in bytes, of the sample cache. The moving
+   * transform jacobians are not cached when they do not fit, and nothing
+   * is cached when the fixed samples alone do not fit. 256 MiB by default. */
+  itkSetMacro(SampleCacheMemoryLimit, SizeValueType);
+  itkGetConstMacro(SampleCacheMemoryLimit, SizeValueType);
+
 #if !defined(ITK_LEGACY_REMOVE)
   /** UseFixedSampledPointSet is deprecated and has been replaced
    * with UseSampledPointsSet. */
@@ -504,8 +527,8 @@ public:
   /** Set number of work units to use. This the maximum number of work units to use
    * when multithreaded.  The actual number of work units used (may be less than
    * this value) can be obtained with \c GetNumberOfWorkUnitsUsed. */
-  virtual void
-  SetMaximumNumberOfWorkUnits(const ThreadIdType number);
+  void
+  SetMaximumNumberOfWorkUnits(const ThreadIdType number) override;
   virtual ThreadIdType
   GetMaximumNumberOfWorkUnits() const;
 
@@ -715,6 +738,24 @@ protected:
   /** Get accessor for flag to calculate derivative. */
   itkGetConstMacro(ComputeDerivative, bool);
 
+  /** Fixed image values of a point of the sampled point set, as held by
+   * the sample cache. */
+  struct CachedFixedSampleType
+  {
+    FixedImagePointType    MappedFixedPoint;
+    FixedImagePixelType    MappedFixedPixelValue;
+    FixedImageGradientType MappedFixedImageGradient;
+    bool                   IsValid;
+  };
+  using JacobianValueType = typename JacobianType::element_type;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
+
+  /** Build the sample cache when \c UseSampleCache is on and the cache is
+   * out of date, or clear it when it does not fit in the memory limit.
+   * Called by InitializeForIteration(). */
+  virtual void
+  UpdateSampleCache() const;
+
   FixedImageConstPointer  m_FixedImage{};
   MovingImageConstPointer m_MovingImage{};
 
@@ -774,6 +815,15 @@ protected:
   FixedSampledPointSet */
   bool m_UseVirtualSampledPointSet{};
 
+  /** Sample cache, empty when not in use. The moving transform jacobian
+   * of sample \c i, and its non-zero jacobian indices, start at
+   * i * VirtualImageDimension * m_SampleCacheNumberOfNonZeroJacobianIndices
+   * and i * m_SampleCacheNumberOfNonZeroJacobianIndices. */
+  mutable std::vector<CachedFixedSampleType> m_SampleCacheFixedSamples{};
+  mutable std::vector<JacobianValueType>     m_SampleCacheJacobians{};
+  mutable NonZeroJacobianIndicesType         m_SampleCacheNonZeroJacobianIndices{};
+  mutable NumberOfParametersType             m_SampleCacheNumberOfNonZeroJacobianIndices{};
+
   ImageToImageMetricv4();
   ~ImageToImageMetricv4() override = default;
 
@@ -790,7 +840,7 @@ private:
   LocalTransformPoint(const typename FixedTransformType::OutputPointType & virtualPoint,
                       typename FixedTransformType::OutputPointType &       mappedFixedPoint) const
   {
-    mappedFixedPoint = this->m_FixedTransform->TransformPoint(virtualPoint);
+    mappedFixedPoint = this->m_FixedPointTransform->TransformPoint(virtualPoint);
   }
   // cast the virtual point
   template <typename TVirtualPoint>
@@ -802,7 +852,7 @@ private:
 
     localVirtualPoint.CastFrom(virtualPoint);
 
-    mappedFixedPoint = this->m_FixedTransform->TransformPoint(localVirtualPoint);
+    mappedFixedPoint = this->m_FixedPointTransform->TransformPoint(localVirtualPoint);
   }
   // cast the mapped Fixed Point
   template <typename TFixedImagePoint>
@@ -812,7 +862,7 @@ private:
   {
     typename FixedTransformType::OutputPointType localMappedFixedPoint;
     localMappedFixedPoint.CastFrom(mappedFixedPoint);
-    localMappedFixedPoint = this->m_FixedTransform->TransformPoint(virtualPoint);
+    localMappedFixedPoint = this->m_FixedPointTransform->TransformPoint(virtualPoint);
     mappedFixedPoint.CastFrom(localMappedFixedPoint);
   }
   // cast both mapped and fixed point.
@@ -826,14 +876,24 @@ private:
     localVirtualPoint.CastFrom(virtualPoint);
     localMappedFixedPoint.CastFrom(mappedFixedPoint);
 
-    localMappedFixedPoint = this->m_FixedTransform->TransformPoint(localVirtualPoint);
+    localMappedFixedPoint = this->m_FixedPointTransform->TransformPoint(localVirtualPoint);
     mappedFixedPoint.CastFrom(localMappedFixedPoint);
   }
 
+  /** Set the transforms which map the points: the precomposed form of a
+   * CompositeTransform, or the transform itself. */
+  void
+  InitializePointTransforms() const;
+
   /** Flag for warning about use of GetValue. Will be removed when
    *  GetValue implementation is improved. */
   mutable bool m_HaveMadeGetValueWarning{};
 
+  /** Transforms mapping the points, set by Initialize() and
+   * InitializeForIteration(). */
+  mutable typename FixedTransformType::ConstPointer  m_FixedPointTransform{};
+  mutable typename MovingTransformType::ConstPointer m_MovingPointTransform{};
+
   /** Keep track of the number of sampled fixed points that are
    * deemed invalid during conversion to virtual domain.
    * For informational purposes. */
@@ -847,6 +907,14 @@ private:
   /** Flag to know if derivative should be calculated */
   mutable bool m_ComputeDerivative{};
 
+  bool          m_UseSampleCache{ false };
+  SizeValueType m_SampleCacheMemoryLimit{ 256 * 1024 * 1024 };
+
+  /** State the sample cache was built for, to know when to rebuild it. */
+  mutable ModifiedTimeType                                  m_SampleCacheTime{};
+  mutable const MovingTransformType *                       m_SampleCacheMovingTransform{};
+  mutable typename MovingTransformType::FixedParametersType m_SampleCacheMovingTransformFixedParameters{};
+
 /** Only floating-point images are currently supported. To support integer images,
  * several small changes must be made */
 #ifdef ITK_USE_CONCEPT_CHECKING
@@ -24,6 +24,8 @@
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkIdentityTransform.h"
 
+#include <algorithm> // For copy, copy_n and max.
+
 namespace itk
 {
 
@@ -106,6 +108,7 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   {
     itkExceptionMacro("MovingTransform is not present");
   }
+  this->InitializePointTransforms();
 
   // If the image is provided by a source, update the source.
   this->m_MovingImage->UpdateSource();
@@ -185,6 +188,12 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     itkDebugMacro("Initialize: ComputeMovingImageGradientFilterImage");
     this->ComputeMovingImageGradientFilterImage();
   }
+
+  /* The sample cache is built again by the next evaluation. */
+  this->m_SampleCacheFixedSamples = {};
+  this->m_SampleCacheJacobians = {};
+  this->m_SampleCacheNonZeroJacobianIndices = {};
+  this->m_SampleCacheTime = 0;
 }
 
 template <typename TFixedImage,
@@ -283,6 +292,9 @@ void
 ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
   InitializeForIteration() const
 {
+  this->InitializePointTransforms();
+  this->UpdateSampleCache();
+
   if (this->m_ComputeDerivative)
   {
     /* This size always comes from the active transform */
@@ -296,6 +308,138 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  InitializePointTransforms() const
+{
+  // Map the points through a single affine transform for each run of
+  // consecutive linear transforms of a CompositeTransform. The transforms
+  // themselves are still used for the Jacobians.
+  this->m_FixedPointTransform = this->m_FixedTransform;
+  this->m_MovingPointTransform = this->m_MovingTransform;
+  if constexpr (VirtualImageDimension == FixedImageDimension)
+  {
+    using CompositeTransformType =
+      CompositeTransform<typename FixedTransformType::ParametersValueType, VirtualImageDimension>;
+    if (const auto * compositeTransform =
+          dynamic_cast<const CompositeTransformType *>(this->m_FixedTransform.GetPointer()))
+    {
+      this->m_FixedPointTransform = compositeTransform->GetPrecomposedTransform();
+    }
+  }
+  if constexpr (VirtualImageDimension == MovingImageDimension)
+  {
+    using CompositeTransformType =
+      CompositeTransform<typename MovingTransformType::ParametersValueType, VirtualImageDimension>;
+    if (const auto * compositeTransform =
+          dynamic_cast<const CompositeTransformType *>(this->m_MovingTransform.GetPointer()))
+    {
+      this->m_MovingPointTransform = compositeTransform->GetPrecomposedTransform();
+    }
+  }
+}
+
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  UpdateSampleCache() const
+{
+  if (!this->m_UseSampleCache || !this->m_UseSampledPointSet || this->m_VirtualSampledPointSet.IsNull())
+  {
+    this->m_SampleCacheFixedSamples = {};
+    this->m_SampleCacheJacobians = {};
+    this->m_SampleCacheNonZeroJacobianIndices = {};
+    this->m_SampleCacheTime = 0;
+    return;
+  }
+
+  /* The cached fixed samples depend on the fixed image side only, and the
+   * cached jacobians on the fixed parameters of the moving transform. */
+  ModifiedTimeType time = std::max({ this->GetMTime(),
+                                     this->m_FixedImage->GetMTime(),
+                                     this->m_FixedTransform->GetMTime(),
+                                     this->m_VirtualSampledPointSet->GetMTime() });
+  if (this->m_FixedImageMask)
+  {
+    time = std::max(time, this->m_FixedImageMask->GetMTime());
+  }
+  if (time == this->m_SampleCacheTime && this->m_MovingTransform.GetPointer() == this->m_SampleCacheMovingTransform &&
+      this->m_MovingTransform->GetFixedParameters() == this->m_SampleCacheMovingTransformFixedParameters)
+  {
+    return;
+  }
+  this->m_SampleCacheTime = time;
+  this->m_SampleCacheMovingTransform = this->m_MovingTransform.GetPointer();
+  this->m_SampleCacheMovingTransformFixedParameters = this->m_MovingTransform->GetFixedParameters();
+
+  /* Only the jacobian of the transforms linear in their parameters, such as
+   * BSplineTransform, stays the same when the parameters are updated. */
+  const SizeValueType          numberOfSamples = this->GetNumberOfDomainPoints();
+  const NumberOfParametersType numberOfNonZeroJacobianIndices =
+    this->m_MovingTransform->GetNumberOfNonZeroJacobianIndices();
+  bool cacheJacobians =
+    this->m_MovingTransform->GetTransformCategory() == MovingTransformType::TransformCategoryEnum::BSpline &&
+    numberOfNonZeroJacobianIndices < this->m_MovingTransform->GetNumberOfLocalParameters();
+
+  const SizeValueType fixedSamplesSize = numberOfSamples * sizeof(CachedFixedSampleType);
+  const SizeValueType jacobiansSize =
+    numberOfSamples * numberOfNonZeroJacobianIndices *
+    (VirtualImageDimension * sizeof(JacobianValueType) + sizeof(typename NonZeroJacobianIndicesType::value_type));
+  if (fixedSamplesSize > this->m_SampleCacheMemoryLimit)
+  {
+    itkDebugMacro("The sample cache does not fit in " << this->m_SampleCacheMemoryLimit << " bytes.");
+    this->m_SampleCacheFixedSamples = {};
+    this->m_SampleCacheJacobians = {};
+    this->m_SampleCacheNonZeroJacobianIndices = {};
+    return;
+  }
+  cacheJacobians = cacheJacobians && fixedSamplesSize + jacobiansSize <= this->m_SampleCacheMemoryLimit;
+
+  this->m_SampleCacheFixedSamples.resize(numberOfSamples);
+  this->m_SampleCacheNumberOfNonZeroJacobianIndices = cacheJacobians ? numberOfNonZeroJacobianIndices : 0;
+  const SizeValueType jacobianSize = VirtualImageDimension * this->m_SampleCacheNumberOfNonZeroJacobianIndices;
+  this->m_SampleCacheJacobians.resize(numberOfSamples * jacobianSize);
+  this->m_SampleCacheNonZeroJacobianIndices.resize(numberOfSamples *
+                                                   this->m_SampleCacheNumberOfNonZeroJacobianIndices);
+
+  const bool computeFixedImageGradient = this->GetGradientSourceIncludesFixed();
+  this->m_SparseGetValueAndDerivativeThreader->GetMultiThreader()->ParallelizeArray(
+    0,
+    numberOfSamples,
+    [this, cacheJacobians, computeFixedImageGradient, jacobianSize](SizeValueType i) {
+      const VirtualPointType & virtualPoint = this->m_VirtualSampledPointSet->GetPoint(i);
+      CachedFixedSampleType &  sample = this->m_SampleCacheFixedSamples[i];
+      sample.IsValid =
+        this->TransformAndEvaluateFixedPoint(virtualPoint, sample.MappedFixedPoint, sample.MappedFixedPixelValue);
+      if (sample.IsValid && computeFixedImageGradient)
+      {
+        this->ComputeFixedImageGradientAtPoint(sample.MappedFixedPoint, sample.MappedFixedImageGradient);
+      }
+      if (cacheJacobians)
+      {
+        const NumberOfParametersType numberOfIndices = this->m_SampleCacheNumberOfNonZeroJacobianIndices;
+        JacobianType                 jacobian(VirtualImageDimension, numberOfIndices);
+        NonZeroJacobianIndicesType   nonZeroJacobianIndices(numberOfIndices);
+        this->m_MovingTransform->ComputeSparseJacobianWithRespectToParameters(
+          virtualPoint, jacobian, nonZeroJacobianIndices);
+        std::copy_n(jacobian.data_block(), jacobianSize, &this->m_SampleCacheJacobians[i * jacobianSize]);
+        std::copy(nonZeroJacobianIndices.cbegin(),
+                  nonZeroJacobianIndices.cend(),
+                  &this->m_SampleCacheNonZeroJacobianIndices[i * numberOfIndices]);
+      }
+    },
+    nullptr);
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -361,7 +505,7 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   localVirtualPoint.CastFrom(virtualPoint);
   localMappedMovingPoint.CastFrom(mappedMovingPoint);
 
-  localMappedMovingPoint = this->m_MovingTransform->TransformPoint(localVirtualPoint);
+  localMappedMovingPoint = this->m_MovingPointTransform->TransformPoint(localVirtualPoint);
   mappedMovingPoint.CastFrom(localMappedMovingPoint);
 
   // check against the mask if one is assigned
@@ -669,7 +813,9 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
      << indent << "GetUseFixedImageGradientFilter: " << this->GetUseFixedImageGradientFilter() << std::endl
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
-     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl
+     << indent << "UseSampleCache: " << this->GetUseSampleCache() << std::endl
+     << indent << "SampleCacheMemoryLimit: " << this->GetSampleCacheMemoryLimit() << std::endl;
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
@@ -89,6 +89,7 @@ public:
   using typename Superclass::FixedOutputPointType;
   using typename Superclass::MovingTransformType;
   using typename Superclass::MovingOutputPointType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
@@ -165,6 +166,7 @@ public:
   using typename Superclass::FixedOutputPointType;
   using typename Superclass::MovingTransformType;
   using typename Superclass::MovingOutputPointType;
+  using typename Superclass::NonZeroJacobianIndicesType;
 
   using typename Superclass::MeasureType;
   using typename Superclass::DerivativeType;
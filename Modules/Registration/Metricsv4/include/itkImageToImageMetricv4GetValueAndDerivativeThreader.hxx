@@ -57,6 +57,7 @@ ImageToImageMetricv4GetValueAndDerivativeThreader<ThreadedIndexedContainerPartit
   {
     const VirtualPointType & virtualPoint = virtualSampledPointSet->GetPoint(i);
     const auto               virtualIndex = virtualImage->TransformPhysicalPointToIndex(virtualPoint);
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].SampleIndex = i;
     this->ProcessVirtualPoint(virtualIndex, virtualPoint, threadId);
   }
   // Finalize per thread actions
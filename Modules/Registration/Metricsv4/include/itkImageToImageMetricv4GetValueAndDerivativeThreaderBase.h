@@ -78,6 +78,7 @@ public:
   using FixedOutputPointType = typename FixedTransformType::OutputPointType;
   using MovingTransformType = typename ImageToImageMetricv4Type::MovingTransformType;
   using MovingOutputPointType = typename MovingTransformType::OutputPointType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
 
   using MeasureType = typename ImageToImageMetricv4Type::MeasureType;
   using DerivativeType = typename ImageToImageMetricv4Type::DerivativeType;
@@ -95,6 +96,17 @@ public:
   virtual bool
   GetComputeDerivative() const;
 
+  /** Whether the per-thread moving transform jacobian is sparse, i.e. holds
+   * the columns of the parameters in the support of each point only. This is
+   * the case for global transforms that report fewer non-zero jacobian
+   * indices than local parameters, such as BSplineTransform.
+   * Only valid once threading has been started. */
+  bool
+  GetUseSparseJacobian() const
+  {
+    return this->m_UseSparseJacobian;
+  }
+
 protected:
   ImageToImageMetricv4GetValueAndDerivativeThreaderBase();
   ~ImageToImageMetricv4GetValueAndDerivativeThreaderBase() override = default;
@@ -122,6 +134,18 @@ protected:
                       const VirtualPointType & virtualPoint,
                       const ThreadIdType       threadId);
 
+  /** Transform \c virtualPoint into the fixed image space, evaluate the
+   * fixed image there, and its gradient when the derivative is computed
+   * from fixed image gradients. The results are taken from the sample cache
+   * of the metric when it is in use, for the sample SampleIndex of
+   * \c threadId. Returns whether the mapped point is valid. */
+  bool
+  TransformAndEvaluateFixedPoint(const VirtualPointType & virtualPoint,
+                                 FixedImagePointType &    mappedFixedPoint,
+                                 FixedImagePixelType &    mappedFixedPixelValue,
+                                 FixedImageGradientType & mappedFixedImageGradient,
+                                 const ThreadIdType       threadId) const;
+
   /** Method to calculate the metric value and derivative
    * given a point, value and image derivative for both fixed and moving
    * spaces. The provided values have been calculated from \c virtualPoint,
@@ -170,6 +194,17 @@ protected:
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Compute the jacobian of the moving transform with respect to its
+   * parameters at \c virtualPoint into the MovingTransformJacobian of
+   * \c threadId, and return its number of columns. Column \c j refers to
+   * the parameter NonZeroJacobianIndices[j] of the thread, which is the
+   * identity mapping unless GetUseSparseJacobian() is true. The local
+   * derivative given to StorePointDerivativeResult() has one entry per
+   * column. The jacobian is copied from the sample cache of the metric
+   * when it holds the one of \c virtualPoint. */
+  NumberOfParametersType
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const;
+
   struct GetValueAndDerivativePerThreadStruct
   {
     /** Intermediary threaded metric value storage. */
@@ -186,6 +221,11 @@ protected:
      * classes for efficiency. */
     JacobianType MovingTransformJacobian;
     JacobianType MovingTransformJacobianPositional;
+    /** Parameter index of each column of MovingTransformJacobian. */
+    NonZeroJacobianIndicesType NonZeroJacobianIndices;
+    /** Index in the sampled point set of the point being processed, set by
+     * the sparse threader to look up the sample cache of the metric. */
+    SizeValueType SampleIndex;
   };
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
                GetValueAndDerivativePerThreadStruct,
@@ -199,6 +239,10 @@ protected:
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType m_CachedNumberOfParameters{};
   mutable NumberOfParametersType m_CachedNumberOfLocalParameters{};
+  mutable NumberOfParametersType m_CachedNumberOfNonZeroJacobianIndices{};
+  mutable bool                   m_UseSparseJacobian{ false };
+  mutable bool                   m_UseSampleCache{ false };
+  mutable bool                   m_UseSampleCacheJacobians{ false };
 };
 
 } // end namespace itk
@@ -20,6 +20,10 @@
 
 #include "itkNumericTraits.h"
 #include "itkMakeUniqueForOverwrite.h"
+#include "itkThreadedIndexedContainerPartitioner.h"
+#include <algorithm> // For copy_n.
+#include <numeric>   // For iota.
+#include <type_traits>
 
 namespace itk
 {
@@ -44,6 +48,31 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
 
+  /* Use the sparse jacobian of global transforms with a local support */
+  this->m_CachedNumberOfNonZeroJacobianIndices = this->m_CachedNumberOfLocalParameters;
+  this->m_UseSparseJacobian = false;
+  if (this->m_Associate->GetComputeDerivative() &&
+      this->m_Associate->m_MovingTransform->GetTransformCategory() !=
+        MovingTransformType::TransformCategoryEnum::DisplacementField)
+  {
+    const NumberOfParametersType numberOfNonZeroJacobianIndices =
+      this->m_Associate->m_MovingTransform->GetNumberOfNonZeroJacobianIndices();
+    if (numberOfNonZeroJacobianIndices < this->m_CachedNumberOfLocalParameters)
+    {
+      this->m_CachedNumberOfNonZeroJacobianIndices = numberOfNonZeroJacobianIndices;
+      this->m_UseSparseJacobian = true;
+    }
+  }
+
+  /* Use the sample cache of the metric, built for its sampled point set */
+  this->m_UseSampleCache = std::is_same_v<TDomainPartitioner, ThreadedIndexedContainerPartitioner> &&
+                           !this->m_Associate->m_SampleCacheFixedSamples.empty() &&
+                           this->m_Associate->m_SampleCacheFixedSamples.size() ==
+                             this->m_Associate->GetNumberOfDomainPoints();
+  this->m_UseSampleCacheJacobians =
+    this->m_UseSampleCache && this->m_UseSparseJacobian &&
+    this->m_Associate->m_SampleCacheNumberOfNonZeroJacobianIndices == this->m_CachedNumberOfNonZeroJacobianIndices;
+
   /* Per-thread results */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
   this->m_GetValueAndDerivativePerThreadVariables =
@@ -56,9 +85,13 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
       /* Allocate intermediary per-thread storage used to get results from
        * derived classes */
       this->m_GetValueAndDerivativePerThreadVariables[i].LocalDerivatives.SetSize(
-        this->m_CachedNumberOfLocalParameters);
+        this->m_CachedNumberOfNonZeroJacobianIndices);
       this->m_GetValueAndDerivativePerThreadVariables[i].MovingTransformJacobian.SetSize(
-        this->m_Associate->VirtualImageDimension, this->m_CachedNumberOfLocalParameters);
+        this->m_Associate->VirtualImageDimension, this->m_CachedNumberOfNonZeroJacobianIndices);
+      NonZeroJacobianIndicesType & nonZeroJacobianIndices =
+        this->m_GetValueAndDerivativePerThreadVariables[i].NonZeroJacobianIndices;
+      nonZeroJacobianIndices.resize(this->m_CachedNumberOfNonZeroJacobianIndices);
+      std::iota(nonZeroJacobianIndices.begin(), nonZeroJacobianIndices.end(), NumberOfParametersType{ 0 });
       // Not pre-allocated since it may not be used
       // this->m_GetValueAndDerivativePerThreadVariables[i].MovingTransformJacobianPositional
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() ==
@@ -194,13 +227,8 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
    * then we otherwise get when exceptions are caught in MultiThreaderBase. */
   try
   {
-    pointIsValid =
-      this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
-    if (pointIsValid && this->m_Associate->GetComputeDerivative() &&
-        this->m_Associate->GetGradientSourceIncludesFixed())
-    {
-      this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
-    }
+    pointIsValid = this->TransformAndEvaluateFixedPoint(
+      virtualPoint, mappedFixedPoint, mappedFixedPixelValue, mappedFixedImageGradient, threadId);
   }
   catch (const ExceptionObject & exc)
   {
@@ -283,10 +311,12 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
       MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
     /* Global support */
+    const NumberOfParametersType numberOfLocalDerivatives =
+      this->m_UseSparseJacobian ? this->m_CachedNumberOfNonZeroJacobianIndices : this->m_CachedNumberOfParameters;
     if (this->m_Associate->GetUseFloatingPointCorrection())
     {
       DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
-      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
       {
         auto test = static_cast<intmax_t>(
           this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] * correctionResolution);
@@ -294,10 +324,24 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
           static_cast<DerivativeValueType>(test / correctionResolution);
       }
     }
-    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+    if (this->m_UseSparseJacobian)
     {
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      /* Scatter the derivatives of the parameters in the support of the point */
+      const NonZeroJacobianIndicesType & nonZeroJacobianIndices =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].NonZeroJacobianIndices;
+      for (NumberOfParametersType j = 0; j < numberOfLocalDerivatives; ++j)
+      {
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[nonZeroJacobianIndices[j]] +=
+          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[j];
+      }
+    }
+    else
+    {
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
+      {
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
+          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      }
     }
   }
   else
@@ -328,6 +372,70 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+bool
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  TransformAndEvaluateFixedPoint(const VirtualPointType & virtualPoint,
+                                 FixedImagePointType &    mappedFixedPoint,
+                                 FixedImagePixelType &    mappedFixedPixelValue,
+                                 FixedImageGradientType & mappedFixedImageGradient,
+                                 const ThreadIdType       threadId) const
+{
+  if (this->m_UseSampleCache)
+  {
+    const auto & sample =
+      this->m_Associate
+        ->m_SampleCacheFixedSamples[this->m_GetValueAndDerivativePerThreadVariables[threadId].SampleIndex];
+    mappedFixedPoint = sample.MappedFixedPoint;
+    mappedFixedPixelValue = sample.MappedFixedPixelValue;
+    mappedFixedImageGradient = sample.MappedFixedImageGradient;
+    return sample.IsValid;
+  }
+
+  const bool pointIsValid =
+    this->m_Associate->TransformAndEvaluateFixedPoint(virtualPoint, mappedFixedPoint, mappedFixedPixelValue);
+  if (pointIsValid && this->m_Associate->GetComputeDerivative() && this->m_Associate->GetGradientSourceIncludesFixed())
+  {
+    this->m_Associate->ComputeFixedImageGradientAtPoint(mappedFixedPoint, mappedFixedImageGradient);
+  }
+  return pointIsValid;
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetricv4>
+auto
+ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::
+  ComputeMovingTransformJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  -> NumberOfParametersType
+{
+  GetValueAndDerivativePerThreadStruct & perThreadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  // Threaders may compute the jacobian at other points than the samples
+  if (this->m_UseSampleCacheJacobians &&
+      virtualPoint == this->m_Associate->m_VirtualSampledPointSet->GetPoint(perThreadVariables.SampleIndex))
+  {
+    const NumberOfParametersType numberOfIndices = this->m_CachedNumberOfNonZeroJacobianIndices;
+    const SizeValueType          jacobianSize = TImageToImageMetricv4::VirtualImageDimension * numberOfIndices;
+    std::copy_n(&this->m_Associate->m_SampleCacheJacobians[perThreadVariables.SampleIndex * jacobianSize],
+                jacobianSize,
+                perThreadVariables.MovingTransformJacobian.data_block());
+    std::copy_n(
+      &this->m_Associate->m_SampleCacheNonZeroJacobianIndices[perThreadVariables.SampleIndex * numberOfIndices],
+      numberOfIndices,
+      perThreadVariables.NonZeroJacobianIndices.begin());
+  }
+  else if (this->m_UseSparseJacobian)
+  {
+    this->m_Associate->m_MovingTransform->ComputeSparseJacobianWithRespectToParameters(
+      virtualPoint, perThreadVariables.MovingTransformJacobian, perThreadVariables.NonZeroJacobianIndices);
+  }
+  else
+  {
+    /** For dense transforms, this returns identity */
+    this->m_Associate->m_MovingTransform->ComputeJacobianWithRespectToParametersCachedTemporaries(
+      virtualPoint, perThreadVariables.MovingTransformJacobian, perThreadVariables.MovingTransformJacobianPositional);
+  }
+  return this->m_CachedNumberOfNonZeroJacobianIndices;
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetricv4>
 bool
 ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImageToImageMetricv4>::GetComputeDerivative()
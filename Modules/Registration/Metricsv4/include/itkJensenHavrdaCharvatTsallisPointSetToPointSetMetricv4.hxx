@@ -18,8 +18,11 @@
 #ifndef itkJensenHavrdaCharvatTsallisPointSetToPointSetMetricv4_hxx
 #define itkJensenHavrdaCharvatTsallisPointSetToPointSetMetricv4_hxx
 
+#include "itkCompensatedSummation.h"
 #include "itkMath.h"
 
+#include <numeric>
+
 namespace itk
 {
 
@@ -103,12 +106,34 @@ JensenHavrdaCharvatTsallisPointSetToPointSetMetricv4<TPointSet, TInternalComputa
   /**
    * first term only
    */
-  typename PointSetType::PointIdentifier numberOfMovingPoints =
-    this->m_MovingDensityFunction->GetInputPointSet()->GetNumberOfPoints();
-  RealType probabilityStar =
-    this->m_MovingDensityFunction->Evaluate(samplePoint) * static_cast<RealType>(numberOfMovingPoints);
+  // The moving density at the sample point, i.e., the mean of the Gaussians of
+  // its nearest moving points, and the derivative both use these Gaussians:
+  // search the nearest neighbors and evaluate the Gaussians only once.
+  const SizeValueType numberOfMovingPoints = this->m_MovingDensityFunction->GetInputPointSet()->GetNumberOfPoints();
+
+  typename DensityFunctionType::NeighborsIdentifierType neighbors;
+  if (this->m_EvaluationKNeighborhood < numberOfMovingPoints)
+  {
+    this->m_MovingDensityFunction->GetPointsLocator()->FindClosestNPoints(
+      samplePoint, this->m_EvaluationKNeighborhood, neighbors);
+  }
+  else
+  {
+    neighbors.resize(numberOfMovingPoints);
+    std::iota(neighbors.begin(), neighbors.end(), 0);
+  }
+
+  std::vector<const GaussianType *> gaussians(neighbors.size());
+  std::vector<RealType>             gaussianValues(neighbors.size());
+  CompensatedSummation<RealType>    gaussianSum;
+  for (SizeValueType n = 0; n < neighbors.size(); ++n)
+  {
+    gaussians[n] = this->m_MovingDensityFunction->GetGaussian(neighbors[n]);
+    gaussianValues[n] = gaussians[n]->Evaluate(samplePoint);
+    gaussianSum += gaussianValues[n];
+  }
 
-  probabilityStar /= this->m_TotalNumberOfPoints;
+  RealType probabilityStar = gaussianSum.GetSum() / this->m_TotalNumberOfPoints;
 
   if (Math::AlmostEquals(probabilityStar, NumericTraits<RealType>::ZeroValue()))
   {
@@ -133,22 +158,18 @@ JensenHavrdaCharvatTsallisPointSetToPointSetMetricv4<TPointSet, TInternalComputa
   {
     RealType probabilityStarFactor = std::pow(probabilityStar, static_cast<RealType>(2.0 - this->m_Alpha));
 
-    typename DensityFunctionType::NeighborsIdentifierType neighbors;
-    this->m_MovingDensityFunction->GetPointsLocator()->FindClosestNPoints(
-      samplePoint, this->m_EvaluationKNeighborhood, neighbors);
-
     for (SizeValueType n = 0; n < neighbors.size(); ++n)
     {
-      RealType gaussian = this->m_MovingDensityFunction->GetGaussian(neighbors[n])->Evaluate(samplePoint);
+      const RealType gaussian = gaussianValues[n];
 
       if (Math::AlmostEquals(gaussian, NumericTraits<RealType>::ZeroValue()))
       {
         continue;
       }
 
-      typename GaussianType::MeanVectorType mean = this->m_MovingDensityFunction->GetGaussian(neighbors[n])->GetMean();
+      const typename GaussianType::MeanVectorType & mean = gaussians[n]->GetMean();
 
-      Array<CoordRepType> diffMean(PointDimension);
+      Vector<CoordRepType, PointDimension> diffMean;
       for (unsigned int i = 0; i < PointDimension; ++i)
       {
         diffMean[i] = mean[i] - samplePoint[i];
@@ -156,13 +177,22 @@ JensenHavrdaCharvatTsallisPointSetToPointSetMetricv4<TPointSet, TInternalComputa
 
       if (this->m_UseAnisotropicCovariances)
       {
-        typename GaussianType::CovarianceMatrixType Ci =
-          this->m_MovingDensityFunction->GetGaussian(neighbors[n])->GetInverseCovariance();
-        diffMean = Ci * diffMean;
+        const typename GaussianType::CovarianceMatrixType & Ci = gaussians[n]->GetInverseCovariance();
+
+        Vector<CoordRepType, PointDimension> weightedDiffMean;
+        for (unsigned int i = 0; i < PointDimension; ++i)
+        {
+          weightedDiffMean[i] = 0.0;
+          for (unsigned int j = 0; j < PointDimension; ++j)
+          {
+            weightedDiffMean[i] += Ci(i, j) * diffMean[j];
+          }
+        }
+        diffMean = weightedDiffMean;
       }
       else
       {
-        diffMean /= this->m_MovingDensityFunction->GetGaussian(neighbors[n])->GetCovariance()(0, 0);
+        diffMean /= gaussians[n]->GetCovariance()(0, 0);
       }
 
       DerivativeValueType factor = this->m_Prefactor1 * gaussian / probabilityStarFactor;
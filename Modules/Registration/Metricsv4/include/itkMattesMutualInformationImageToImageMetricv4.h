@@ -136,6 +136,7 @@ public:
 
   using typename Superclass::MovingTransformType;
   using typename Superclass::JacobianType;
+  using NonZeroJacobianIndicesType = typename MovingTransformType::NonZeroJacobianIndicesType;
   using VirtualImageType = typename Superclass::VirtualImageType;
   using typename Superclass::VirtualIndexType;
   using typename Superclass::VirtualPointType;
@@ -157,9 +158,45 @@ public:
   itkSetClampMacro(NumberOfHistogramBins, SizeValueType, 5, NumericTraits<SizeValueType>::max());
   itkGetConstReferenceMacro(NumberOfHistogramBins, SizeValueType);
 
+  /** This variable selects the method to be used for computing the metric
+   * derivatives with respect to the parameters of a transform without local
+   * support. The choice is a trade-off between computation speed and memory.
+   *
+   * UseExplicitPDFDerivatives = True
+   * will compute the metric derivative by first calculating the derivatives of
+   * each one of the joint PDF bins with respect to each one of the transform
+   * parameters, and then accumulating these contributions in the final metric
+   * derivative array by using a bin-specific weight. The derivatives of the
+   * joint PDF are a 3D array of size (number of histogram bins)^2 times the
+   * number of transform parameters, shared by the threads, which update it
+   * under a lock. This method is well suited for transforms with a small
+   * number of parameters.
+   *
+   * UseExplicitPDFDerivatives = False
+   * will compute the metric derivative in two passes over the samples. The
+   * first pass computes the joint PDF, the metric value and the weight of each
+   * one of the joint PDF bins. The second pass accumulates the derivative of
+   * the Parzen window of each sample, weighted by its bins, in a derivative
+   * array per thread, and these arrays are summed in parallel at the end. No
+   * lock is needed, and the memory is (number of histogram bins)^2 plus the
+   * number of transform parameters per thread, at the cost of evaluating the
+   * samples twice. This method is well suited for transforms with a large
+   * number of parameters, such as BSplineTransform, and for many threads.
+   *
+   * Transforms with local support, such as displacement field transforms,
+   * always use the implicit computation. */
+  itkSetMacro(UseExplicitPDFDerivatives, bool);
+  itkGetConstReferenceMacro(UseExplicitPDFDerivatives, bool);
+  itkBooleanMacro(UseExplicitPDFDerivatives);
+
   void
   Initialize() override;
 
+  /** Compute the metric value and derivative, in two passes over the
+   * samples when UseExplicitPDFDerivatives is off. */
+  void
+  GetValueAndDerivative(MeasureType & value, DerivativeType & derivative) const override;
+
   /** The marginal PDFs are stored as std::vector. */
   // NOTE:  floating point precision is not as stable.
   // Double precision proves faster and more robust in real-world testing.
@@ -186,8 +223,8 @@ public:
   /**
    * Get the internal JointPDFDeriviative image that was used in
    * creating the metric derivative value.
-   * This is only created when a global support transform is used, and
-   * derivatives are requested.
+   * This is only created when a global support transform is used,
+   * derivatives are requested, and UseExplicitPDFDerivatives is on.
    */
   const typename JointPDFDerivativesType::Pointer
   GetJointPDFDerivatives() const
@@ -291,11 +328,15 @@ protected:
   public:
     /* All these methods are thread safe except ReduceBuffer */
 
+    /* When useNonZeroJacobianIndices is true, each element of the buffer
+     * holds the derivatives of cachedNumberOfLocalParameters parameters,
+     * whose indices are given to GetNextElementAndAddOffset(). */
     void
     Initialize(size_t                                    maxBufferLength,
                const size_t                              cachedNumberOfLocalParameters,
                std::mutex *                              parentDerivativeMutexPtr,
-               typename JointPDFDerivativesType::Pointer parentJointPDFDerivatives);
+               typename JointPDFDerivativesType::Pointer parentJointPDFDerivatives,
+               const bool                                useNonZeroJacobianIndices = false);
 
     void
     DoubleBufferSize();
@@ -335,6 +376,18 @@ protected:
       return PDFBufferForWriting;
     }
 
+    // Same as above, for a buffer that holds the derivatives of the
+    // parameters given by nonZeroJacobianIndices only.
+    PDFValueType *
+    GetNextElementAndAddOffset(const OffsetValueType &                              offset,
+                               const typename NonZeroJacobianIndicesType::value_type * nonZeroJacobianIndices)
+    {
+      std::copy_n(nonZeroJacobianIndices,
+                  m_CachedNumberOfLocalParameters,
+                  m_BufferIndicesBlock.begin() + m_CurrentFillSize * m_CachedNumberOfLocalParameters);
+      return this->GetNextElementAndAddOffset(offset);
+    }
+
     /**
      * Apply the operations stored in the buffer.
      * This method is not thread safe and requires a lock while threading.
@@ -353,6 +406,9 @@ protected:
     std::vector<OffsetValueType> m_BufferOffsetContainer;
     size_t                       m_CachedNumberOfLocalParameters;
     size_t                       m_MaxBufferSize;
+    // Parameter indices of the elements of the buffer, when the derivatives
+    // are sparse. Empty otherwise.
+    NonZeroJacobianIndicesType m_BufferIndicesBlock;
     // Pointer handle to parent version
     std::mutex * m_ParentJointPDFDerivativesMutexPtr;
     // Smart pointer handle to parent version
@@ -365,6 +421,12 @@ protected:
 
   PDFValueType m_JointPDFSum{};
 
+  bool m_UseExplicitPDFDerivatives{ true };
+
+  /** Whether the threaders are running the second pass of the implicit
+   * computation of the derivative. */
+  mutable bool m_ImplicitDerivativesSecondPass{ false };
+
   /** Store the per-point local derivative result by parzen window bin.
    * For local-support transforms only. */
   mutable std::vector<DerivativeType> m_LocalDerivativeByParzenBin{};
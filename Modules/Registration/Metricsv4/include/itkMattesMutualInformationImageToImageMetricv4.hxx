@@ -271,6 +271,46 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
    * is now performed in the threader BeforeThreadedExecution method */
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+void
+MattesMutualInformationImageToImageMetricv4<TFixedImage,
+                                            TMovingImage,
+                                            TVirtualImage,
+                                            TInternalComputationValueType,
+                                            TMetricTraits>::GetValueAndDerivative(MeasureType &    value,
+                                                                                  DerivativeType & derivative) const
+{
+  this->m_ImplicitDerivativesSecondPass = false;
+  if (this->m_UseExplicitPDFDerivatives || this->HasLocalSupport())
+  {
+    Superclass::GetValueAndDerivative(value, derivative);
+    return;
+  }
+
+  // First pass: the joint PDF, the value and the pRatio of each bin,
+  // without the gradients and Jacobians of the samples.
+  this->GetValue();
+
+  // Second pass: the derivative, from the derivatives of the Parzen
+  // windows of the samples weighted by the pRatio of their bins. The
+  // value of the first pass is kept.
+  this->m_ImplicitDerivativesSecondPass = true;
+  try
+  {
+    Superclass::GetValueAndDerivative(value, derivative);
+  }
+  catch (...)
+  {
+    this->m_ImplicitDerivativesSecondPass = false;
+    throw;
+  }
+  this->m_ImplicitDerivativesSecondPass = false;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -283,7 +323,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) && !this->m_ImplicitDerivativesSecondPass)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -389,7 +429,14 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
           const PDFValueType pRatio = std::log(jointPDFValue / movingImageMarginalPDF);
           sum += jointPDFValue * (pRatio - logfixedImageMarginalPDFValue);
 
-          if (this->GetComputeDerivative())
+          if (!this->m_UseExplicitPDFDerivatives && !this->HasLocalSupport())
+          {
+            // Collect the pRatio per pdf indices, for the second pass
+            // of the implicit computation of the derivative.
+            const OffsetValueType index = movingIndex + (fixedIndex * this->m_NumberOfHistogramBins);
+            this->m_PRatioArray[index] = pRatio * nFactor;
+          }
+          else if (this->GetComputeDerivative())
           {
             if (!this->HasLocalSupport())
             {
@@ -501,6 +548,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TMetricTraits>::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseExplicitPDFDerivatives: " << (m_UseExplicitPDFDerivatives ? "On" : "Off") << std::endl;
 }
 
 template <typename TFixedImage,
@@ -556,7 +605,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   Initialize(size_t                                    maxBufferLength,
              const size_t                              cachedNumberOfLocalParameters,
              std::mutex *                              parentDerivativeMutexPtr,
-             typename JointPDFDerivativesType::Pointer parentJointPDFDerivatives)
+             typename JointPDFDerivativesType::Pointer parentJointPDFDerivatives,
+             const bool                                useNonZeroJacobianIndices)
 {
   m_CurrentFillSize = 0;
   m_MemoryBlockSize = cachedNumberOfLocalParameters * maxBufferLength;
@@ -570,6 +620,11 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   // operator)
   // the memory as a single block
   m_MemoryBlock.resize(m_MemoryBlockSize, 0.0);
+  m_BufferIndicesBlock.clear();
+  if (useNonZeroJacobianIndices)
+  {
+    m_BufferIndicesBlock.resize(m_MemoryBlockSize);
+  }
   for (size_t index = 0; index < maxBufferLength; ++index)
   {
     this->m_BufferPDFValuesContainer[index] = &(this->m_MemoryBlock[0]) + index * m_CachedNumberOfLocalParameters;
@@ -593,6 +648,10 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   m_BufferPDFValuesContainer.resize(m_MaxBufferSize, nullptr);
   m_BufferOffsetContainer.resize(m_MaxBufferSize, 0);
   m_MemoryBlock.resize(m_MemoryBlockSize, 0.0);
+  if (!m_BufferIndicesBlock.empty())
+  {
+    m_BufferIndicesBlock.resize(m_MemoryBlockSize);
+  }
   for (size_t index = 0; index < m_MaxBufferSize; ++index)
   {
     this->m_BufferPDFValuesContainer[index] = &(this->m_MemoryBlock[0]) + index * m_CachedNumberOfLocalParameters;
@@ -682,6 +741,17 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 
     PDFValueType *             derivativeContribution = *BufferPDFValuesContainerIter;
     const PDFValueType * const endContribution = derivativeContribution + m_CachedNumberOfLocalParameters;
+    if (!m_BufferIndicesBlock.empty())
+    {
+      // Scatter the derivatives of the parameters in the support of the sample
+      const typename NonZeroJacobianIndicesType::value_type * parameterIndex =
+        m_BufferIndicesBlock.data() + bufferIndex * m_CachedNumberOfLocalParameters;
+      while (derivativeContribution < endContribution)
+      {
+        derivPtr[*(parameterIndex++)] += *(derivativeContribution);
+        *(derivativeContribution++) = 0.0;
+      }
+    }
     while (derivativeContribution < endContribution)
     {
       *(derivPtr) += *(derivativeContribution);
@@ -120,6 +120,16 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Accumulate the derivative of a sample in the per-thread derivative,
+   * for the second pass of the implicit computation of the derivative. */
+  void
+  AccumulateImplicitDerivative(const VirtualPointType &        virtualPoint,
+                               const MovingImageGradientType & movingImageGradient,
+                               const OffsetValueType           fixedImageParzenWindowIndex,
+                               const OffsetValueType           pdfMovingIndex,
+                               PDFValueType                    movingImageParzenWindowArg,
+                               const ThreadIdType              threadId) const;
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
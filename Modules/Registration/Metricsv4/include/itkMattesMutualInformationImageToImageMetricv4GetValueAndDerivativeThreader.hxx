@@ -44,6 +44,13 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     itkExceptionMacro("Dynamic casting of associate pointer failed.");
   }
 
+  /* The second pass of the implicit computation of the derivative only
+   * uses the per-thread derivatives, and the pRatio of the first pass. */
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    return;
+  }
+
   /* Porting: these next blocks of code are from MattesMutualImageToImageMetric::Initialize */
 
   /*
@@ -130,8 +137,17 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   //
   if (!this->m_MattesAssociate->GetComputeDerivative())
   {
-    // We only need these if we're computing derivatives.
-    this->m_MattesAssociate->m_PRatioArray.clear();
+    // We only need these if we're computing derivatives, except for the
+    // pRatio of the first pass of the implicit computation of the derivative.
+    if (!this->m_MattesAssociate->m_UseExplicitPDFDerivatives && !this->m_MattesAssociate->HasLocalSupport())
+    {
+      this->m_MattesAssociate->m_PRatioArray.assign(
+        this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+    }
+    else
+    {
+      this->m_MattesAssociate->m_PRatioArray.clear();
+    }
     this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
     this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
     this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
@@ -205,10 +221,13 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
         std::max<size_t>(500,
                          this->m_MattesAssociate->m_NumberOfHistogramBins *
                            this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
-        this->GetCachedNumberOfLocalParameters(),
+        // With a sparse jacobian, each element holds the derivatives of the
+        // parameters in the support of the sample only
+        this->m_CachedNumberOfNonZeroJacobianIndices,
         // Need address of the lock
         &this->m_MattesAssociate->m_JointPDFDerivativesLock,
-        this->m_MattesAssociate->m_JointPDFDerivatives);
+        this->m_MattesAssociate->m_JointPDFDerivatives,
+        this->GetUseSparseJacobian());
     }
   }
 }
@@ -270,6 +289,18 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   const OffsetValueType fixedImageParzenWindowIndex =
     this->m_MattesAssociate->ComputeSingleFixedImageParzenWindowIndex(fixedImageValue);
 
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    this->AccumulateImplicitDerivative(virtualPoint,
+                                       movingImageGradient,
+                                       fixedImageParzenWindowIndex,
+                                       pdfMovingIndex,
+                                       static_cast<PDFValueType>(pdfMovingIndex) - movingImageParzenWindowTerm,
+                                       threadId);
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].NumberOfValidPoints++;
+    return false;
+  }
+
   // Since a zero-order BSpline (box car) kernel is used for
   // the fixed image marginal pdf, we need only increment the
   // fixedImageParzenWindowIndex by value of 1.0.
@@ -313,14 +344,13 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   }
 
   // Compute the transform Jacobian.
-  using JacobianReferenceType = JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  const JacobianType & jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
+  const auto * const nonZeroJacobianIndices =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].NonZeroJacobianIndices.data();
+  NumberOfParametersType numberOfJacobianColumns = 0;
   if (doComputeDerivative)
   {
-    JacobianReferenceType jacobianPositional =
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
-    this->m_MattesAssociate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-      virtualPoint, jacobian, jacobianPositional);
+    numberOfJacobianColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
   }
 
   SizeValueType movingParzenBin = 0;
@@ -358,9 +388,12 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
           (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
         PDFValueType * derivativeContributionPtr =
-          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
-        for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
-             ++mu)
+          this->GetUseSparseJacobian()
+            ? this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(
+                ThisIndexOffset, nonZeroJacobianIndices)
+            : this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(
+                ThisIndexOffset);
+        for (NumberOfParametersType mu = 0; mu < numberOfJacobianColumns; ++mu)
         {
           PDFValueType innerProduct = 0.0;
           for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
@@ -411,6 +444,53 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomain
   }
 }
 
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<TDomainPartitioner,
+                                                                         TImageToImageMetric,
+                                                                         TMattesMutualInformationMetric>::
+  AccumulateImplicitDerivative(const VirtualPointType &        virtualPoint,
+                               const MovingImageGradientType & movingImageGradient,
+                               const OffsetValueType           fixedImageParzenWindowIndex,
+                               const OffsetValueType           pdfMovingIndex,
+                               PDFValueType                    movingImageParzenWindowArg,
+                               const ThreadIdType              threadId) const
+{
+  // Weight of the sample: the sum of the derivatives of its Parzen window,
+  // weighted by the pRatio of the bins of the window.
+  const PDFValueType * pRatioPtr =
+    this->m_MattesAssociate->m_PRatioArray.data() +
+    (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins) + pdfMovingIndex;
+  PDFValueType weight = 0.0;
+  for (unsigned int bin = 0; bin < 4; ++bin)
+  {
+    weight += pRatioPtr[bin] * CubicBSplineDerivativeFunctionType::FastEvaluate(movingImageParzenWindowArg);
+    movingImageParzenWindowArg += 1.0;
+  }
+  if (weight == 0.0)
+  {
+    return;
+  }
+
+  const NumberOfParametersType numberOfJacobianColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+
+  auto &               perThreadVariables = this->m_GetValueAndDerivativePerThreadVariables[threadId];
+  const JacobianType & jacobian = perThreadVariables.MovingTransformJacobian;
+  for (NumberOfParametersType mu = 0; mu < numberOfJacobianColumns; ++mu)
+  {
+    PDFValueType innerProduct = 0.0;
+    for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+    {
+      innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+    }
+    const NumberOfParametersType parameter =
+      this->GetUseSparseJacobian() ? perThreadVariables.NonZeroJacobianIndices[mu] : mu;
+    // Ref: eqn 23 of Thevenaz & Unser paper [3], with the pRatio
+    // scaled by the normalization factor of the derivatives.
+    perThreadVariables.CompensatedDerivatives[parameter] -= innerProduct * weight;
+  }
+}
+
 template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
 void
 MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
@@ -429,6 +509,26 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_GetValueAndDerivativePerThreadVariables[workUnitID].NumberOfValidPoints;
   }
 
+  if (this->m_MattesAssociate->m_ImplicitDerivativesSecondPass)
+  {
+    /* Sum the derivatives of the threads, the parameters being split
+     * between the threads. The value was computed by the first pass. */
+    DerivativeType & derivative = *(this->m_MattesAssociate->m_DerivativeResult);
+    this->GetMultiThreader()->ParallelizeArray(
+      0,
+      derivative.Size(),
+      [this, &derivative, localNumberOfWorkUnitsUsed](SizeValueType p) {
+        CompensatedSummation<DerivativeValueType> sum;
+        for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+        {
+          sum += this->m_GetValueAndDerivativePerThreadVariables[workUnitID].CompensatedDerivatives[p].GetSum();
+        }
+        derivative[p] += sum.GetSum();
+      },
+      nullptr);
+    return;
+  }
+
   /* Porting: This code is from
    * MattesMutualInformationImageToImageMetric::GetValueAndDerivativeThreadPostProcess */
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
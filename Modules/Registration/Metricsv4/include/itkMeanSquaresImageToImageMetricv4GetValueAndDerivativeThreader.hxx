@@ -57,16 +57,11 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
   }
 
   /* Use a pre-allocated jacobian object for efficiency */
-  using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
-  JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  JacobianReferenceType jacobianPositional =
-    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
+  const NumberOfParametersType numberOfJacobianColumns = this->ComputeMovingTransformJacobian(virtualPoint, threadId);
+  const typename TImageToImageMetric::JacobianType & jacobian =
+    this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
 
-  /** For dense transforms, this returns identity */
-  this->m_Associate->GetMovingTransform()->ComputeJacobianWithRespectToParametersCachedTemporaries(
-    virtualPoint, jacobian, jacobianPositional);
-
-  for (unsigned int par = 0; par < this->GetCachedNumberOfLocalParameters(); ++par)
+  for (NumberOfParametersType par = 0; par < numberOfJacobianColumns; ++par)
   {
     localDerivativeReturn[par] = NumericTraits<DerivativeValueType>::ZeroValue();
     for (unsigned int nc = 0; nc < nComponents; ++nc)
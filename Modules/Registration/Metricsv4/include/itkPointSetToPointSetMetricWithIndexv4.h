@@ -58,6 +58,14 @@ namespace itk
  *
  * See ObjectToObjectMetric documentation for more discussion on the virtual domain.
  *
+ * The points are transformed, and the local values and derivatives of the
+ * metric are computed, on the threads of the default multi-threader.  The
+ * points locators, i.e., the k-d trees of the transformed point sets, are
+ * rebuilt whenever the transformed points change.  With a positive
+ * PointsLocatorRebuildTolerance, they are only rebuilt once the points have
+ * moved farther than the tolerance since they were built, which trades the
+ * exactness of the nearest neighbors for the time of the rebuilds.
+ *
  * \note When used with an RegistrationParameterScalesEstimator estimator, a VirtualDomainPointSet
  * must be defined and assigned to the estimator, for use in shift estimation.
  * The virtual domain point set can be retrieved from the metric using the
@@ -159,6 +167,7 @@ public:
   /** Typedef for points locator class to speed up finding neighboring points */
   using PointsLocatorType = PointsLocator<PointsContainer>;
   using NeighborsIdentifierType = typename PointsLocatorType::NeighborsIdentifierType;
+  using PointsSTLContainerType = typename PointsContainer::STLContainerType;
 
   using FixedTransformedPointSetType = PointSet<FixedPixelType, Self::PointDimension>;
   using MovingTransformedPointSetType = PointSet<MovingPixelType, Self::PointDimension>;
@@ -314,6 +323,20 @@ public:
   itkGetConstMacro(CalculateValueAndDerivativeInTangentSpace, bool);
   itkBooleanMacro(CalculateValueAndDerivativeInTangentSpace);
 
+  /**
+   * Set/Get the distance which the transformed points may move, since their
+   * points locator was built, before it is built again.  In between, the
+   * points locator searches the moved points with the k-d tree of their
+   * previous positions, and the distance to a nearest neighbor found exceeds
+   * the distance to the exact nearest neighbor by at most the tolerance.
+   * This is useful when the points move by small steps at each iteration,
+   * e.g., when the value and derivative are calculated in tangent space.
+   * Zero, the default, always rebuilds the points locators, so that the
+   * nearest neighbors are exact.
+   */
+  itkSetMacro(PointsLocatorRebuildTolerance, CoordRepType);
+  itkGetConstMacro(PointsLocatorRebuildTolerance, CoordRepType);
+
 protected:
   PointSetToPointSetMetricWithIndexv4();
   ~PointSetToPointSetMetricWithIndexv4() override = default;
@@ -398,6 +421,17 @@ protected:
   void
   InitializePointsLocators() const;
 
+  /**
+   * Whether a points locator may keep searching the given points with its
+   * current k-d tree, because they are the points it was built with and
+   * they have not moved farther than the PointsLocatorRebuildTolerance from
+   * their positions \c locatorPoints at that time.
+   */
+  bool
+  CanReusePointsLocator(PointsLocatorType *            locator,
+                        const PointsContainer *        points,
+                        const PointsSTLContainerType & locatorPoints) const;
+
   /**
    * Store a derivative from a single point in a field.
    * Only relevant when active transform has local support.
@@ -469,6 +503,12 @@ private:
   mutable ModifiedTimeType m_MovingTransformedPointSetTime{};
   mutable ModifiedTimeType m_FixedTransformedPointSetTime{};
 
+  // Positions of the transformed points when their points locators were
+  // built, kept when the points locators may be reused
+  CoordRepType                   m_PointsLocatorRebuildTolerance{};
+  mutable PointsSTLContainerType m_FixedPointsLocatorPoints{};
+  mutable PointsSTLContainerType m_MovingPointsLocatorPoints{};
+
   // Create ranges over the point set for multithreaded computation of value and derivatives
   using PointIdentifierPair = std::pair<PointIdentifier, PointIdentifier>;
   using PointIdentifierRanges = std::vector<PointIdentifierPair>;
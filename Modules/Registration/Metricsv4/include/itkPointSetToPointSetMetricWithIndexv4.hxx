@@ -20,6 +20,7 @@
 
 #include "itkIdentityTransform.h"
 #include "itkCompensatedSummation.h"
+#include "itkMath.h"
 
 namespace itk
 {
@@ -421,15 +422,33 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
 {
   // Determine the number of valid fixed points, using
   // their positions in the virtual domain.
-  SizeValueType       numberOfValidPoints{};
-  PointsConstIterator virtualIt = this->m_VirtualTransformedPointSet->GetPoints()->Begin();
-  while (virtualIt != this->m_VirtualTransformedPointSet->GetPoints()->End())
+  using VirtualPointsContainer = typename VirtualPointSetType::PointsContainer;
+  using VirtualVectorContainer = typename VirtualPointsContainer::STLContainerType;
+  const VirtualVectorContainer & virtualTransformedPointSet =
+    this->m_VirtualTransformedPointSet->GetPoints()->CastToSTLConstContainer();
+
+  PointIdentifierRanges      ranges = this->CreateRanges();
+  std::vector<SizeValueType> threadNumberOfValidPoints(ranges.size());
+  MultiThreaderBase::New()->ParallelizeArray(
+    (SizeValueType)0,
+    (SizeValueType)ranges.size(),
+    [this, &threadNumberOfValidPoints, &ranges, &virtualTransformedPointSet](SizeValueType rangeIndex) {
+      SizeValueType threadNumberOfPoints = 0;
+      for (PointIdentifier index = ranges[rangeIndex].first; index < ranges[rangeIndex].second; ++index)
+      {
+        if (this->IsInsideVirtualDomain(virtualTransformedPointSet[index]))
+        {
+          ++threadNumberOfPoints;
+        }
+      }
+      threadNumberOfValidPoints[rangeIndex] = threadNumberOfPoints;
+    },
+    nullptr);
+
+  SizeValueType numberOfValidPoints{};
+  for (const SizeValueType threadNumberOfPoints : threadNumberOfValidPoints)
   {
-    if (this->IsInsideVirtualDomain(virtualIt.Value()))
-    {
-      ++numberOfValidPoints;
-    }
-    ++virtualIt;
+    numberOfValidPoints += threadNumberOfPoints;
   }
   return numberOfValidPoints;
 }
@@ -493,27 +512,49 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
   if (update)
   {
     this->m_MovingTransformPointLocatorsNeedInitialization = true;
-    this->m_MovingTransformedPointSet = MovingTransformedPointSetType::New();
-    this->m_MovingTransformedPointSet->Initialize();
 
-    typename MovingTransformType::InverseTransformBasePointer inverseTransform =
-      this->m_MovingTransform->GetInverseTransform();
+    // The points locator searches the transformed points: update them in
+    // place when it may be reused
+    const bool updateInPlace = this->m_PointsLocatorRebuildTolerance > 0 && this->RequiresMovingPointsLocator() &&
+                               this->m_MovingTransformedPointSet &&
+                               this->m_MovingTransformedPointSet->GetNumberOfPoints() ==
+                                 this->m_MovingPointSet->GetNumberOfPoints();
+    if (!updateInPlace)
+    {
+      this->m_MovingTransformedPointSet = MovingTransformedPointSetType::New();
+      this->m_MovingTransformedPointSet->Initialize();
+    }
 
+    // evaluation is performed in moving space, so just copy, unless it is
+    // performed in tangent space, where the copies are transformed in parallel
     typename MovingPointsContainer::ConstIterator It = this->m_MovingPointSet->GetPoints()->Begin();
     while (It != this->m_MovingPointSet->GetPoints()->End())
     {
-      if (this->m_CalculateValueAndDerivativeInTangentSpace)
-      {
-        PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_MovingTransformedPointSet->SetPoint(It.Index(), point);
-      }
-      else
-      {
-        // evaluation is performed in moving space, so just copy
-        this->m_MovingTransformedPointSet->SetPoint(It.Index(), It.Value());
-      }
+      this->m_MovingTransformedPointSet->SetPoint(It.Index(), It.Value());
       ++It;
     }
+
+    if (this->m_CalculateValueAndDerivativeInTangentSpace)
+    {
+      typename MovingTransformType::InverseTransformBasePointer inverseTransform =
+        this->m_MovingTransform->GetInverseTransform();
+
+      const MovingPointsContainer * movingPoints = this->m_MovingPointSet->GetPoints();
+      PointsSTLContainerType &      transformedPoints =
+        this->m_MovingTransformedPointSet->GetPoints()->CastToSTLContainer();
+      MultiThreaderBase::New()->ParallelizeArray(
+        (SizeValueType)0,
+        (SizeValueType)transformedPoints.size(),
+        [&inverseTransform, movingPoints, &transformedPoints](SizeValueType index) {
+          MovingPointType movingPoint;
+          if (movingPoints->GetElementIfIndexExists(index, &movingPoint))
+          {
+            PointType point = inverseTransform->TransformPoint(movingPoint);
+            transformedPoints[index] = point;
+          }
+        },
+        nullptr);
+    }
     this->m_MovingTransformedPointSetTime = this->GetMTime();
     if (!this->m_CalculateValueAndDerivativeInTangentSpace)
     {
@@ -539,35 +580,58 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
   if (update)
   {
     this->m_FixedTransformPointLocatorsNeedInitialization = true;
-    this->m_FixedTransformedPointSet = FixedTransformedPointSetType::New();
-    this->m_FixedTransformedPointSet->Initialize();
-    this->m_VirtualTransformedPointSet = VirtualPointSetType::New();
-    this->m_VirtualTransformedPointSet->Initialize();
 
-    using InverseTransformBasePointer = typename FixedTransformType::InverseTransformBasePointer;
-    InverseTransformBasePointer inverseTransform = this->m_FixedTransform->GetInverseTransform();
+    // The points locator searches the transformed points: update them in
+    // place when it may be reused
+    const bool updateInPlace = this->m_PointsLocatorRebuildTolerance > 0 && this->RequiresFixedPointsLocator() &&
+                               this->m_FixedTransformedPointSet && this->m_VirtualTransformedPointSet &&
+                               this->m_FixedTransformedPointSet->GetNumberOfPoints() ==
+                                 this->m_FixedPointSet->GetNumberOfPoints();
+    if (!updateInPlace)
+    {
+      this->m_FixedTransformedPointSet = FixedTransformedPointSetType::New();
+      this->m_FixedTransformedPointSet->Initialize();
+      this->m_VirtualTransformedPointSet = VirtualPointSetType::New();
+      this->m_VirtualTransformedPointSet->Initialize();
+    }
 
+    // Allocate the transformed points with the identifiers of the fixed
+    // points, then transform them in parallel
     typename FixedPointsContainer::ConstIterator It = this->m_FixedPointSet->GetPoints()->Begin();
     while (It != this->m_FixedPointSet->GetPoints()->End())
     {
-      if (this->m_CalculateValueAndDerivativeInTangentSpace)
-      {
-        // txf into virtual space
-        PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_VirtualTransformedPointSet->SetPoint(It.Index(), point);
-        this->m_FixedTransformedPointSet->SetPoint(It.Index(), point);
-      }
-      else
-      {
-        // txf into virtual space
-        PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_VirtualTransformedPointSet->SetPoint(It.Index(), point);
-        // txf into moving space
-        point = this->m_MovingTransform->TransformPoint(point);
-        this->m_FixedTransformedPointSet->SetPoint(It.Index(), point);
-      }
+      this->m_VirtualTransformedPointSet->SetPoint(It.Index(), It.Value());
+      this->m_FixedTransformedPointSet->SetPoint(It.Index(), It.Value());
       ++It;
     }
+
+    using InverseTransformBasePointer = typename FixedTransformType::InverseTransformBasePointer;
+    InverseTransformBasePointer inverseTransform = this->m_FixedTransform->GetInverseTransform();
+
+    using VirtualVectorContainer = typename VirtualPointSetType::PointsContainer::STLContainerType;
+    const FixedPointsContainer * fixedPoints = this->m_FixedPointSet->GetPoints();
+    VirtualVectorContainer &     virtualPoints = this->m_VirtualTransformedPointSet->GetPoints()->CastToSTLContainer();
+    PointsSTLContainerType &     transformedPoints =
+      this->m_FixedTransformedPointSet->GetPoints()->CastToSTLContainer();
+    MultiThreaderBase::New()->ParallelizeArray(
+      (SizeValueType)0,
+      (SizeValueType)transformedPoints.size(),
+      [this, &inverseTransform, fixedPoints, &virtualPoints, &transformedPoints](SizeValueType index) {
+        FixedPointType fixedPoint;
+        if (fixedPoints->GetElementIfIndexExists(index, &fixedPoint))
+        {
+          // txf into virtual space
+          PointType point = inverseTransform->TransformPoint(fixedPoint);
+          virtualPoints[index] = point;
+          if (!this->m_CalculateValueAndDerivativeInTangentSpace)
+          {
+            // txf into moving space
+            point = this->m_MovingTransform->TransformPoint(point);
+          }
+          transformedPoints[index] = point;
+        }
+      },
+      nullptr);
     this->m_FixedTransformedPointSetTime = std::max(this->GetMTime(), this->m_FixedTransform->GetMTime());
     if (!this->m_CalculateValueAndDerivativeInTangentSpace)
     {
@@ -603,8 +667,17 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     {
       this->m_FixedTransformedPointsLocator = PointsLocatorType::New();
     }
-    this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
-    this->m_FixedTransformedPointsLocator->Initialize();
+    if (!this->CanReusePointsLocator(this->m_FixedTransformedPointsLocator,
+                                     this->m_FixedTransformedPointSet->GetPoints(),
+                                     this->m_FixedPointsLocatorPoints))
+    {
+      this->m_FixedTransformedPointsLocator->SetPoints(this->m_FixedTransformedPointSet->GetPoints());
+      this->m_FixedTransformedPointsLocator->Initialize();
+      if (this->m_PointsLocatorRebuildTolerance > 0)
+      {
+        this->m_FixedPointsLocatorPoints = this->m_FixedTransformedPointSet->GetPoints()->CastToSTLConstContainer();
+      }
+    }
     this->m_FixedTransformPointLocatorsNeedInitialization = false;
   }
 
@@ -618,12 +691,46 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     {
       this->m_MovingTransformedPointsLocator = PointsLocatorType::New();
     }
-    this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
-    this->m_MovingTransformedPointsLocator->Initialize();
+    if (!this->CanReusePointsLocator(this->m_MovingTransformedPointsLocator,
+                                     this->m_MovingTransformedPointSet->GetPoints(),
+                                     this->m_MovingPointsLocatorPoints))
+    {
+      this->m_MovingTransformedPointsLocator->SetPoints(this->m_MovingTransformedPointSet->GetPoints());
+      this->m_MovingTransformedPointsLocator->Initialize();
+      if (this->m_PointsLocatorRebuildTolerance > 0)
+      {
+        this->m_MovingPointsLocatorPoints = this->m_MovingTransformedPointSet->GetPoints()->CastToSTLConstContainer();
+      }
+    }
     this->m_MovingTransformPointLocatorsNeedInitialization = false;
   }
 }
 
+template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
+bool
+PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
+  CanReusePointsLocator(PointsLocatorType *            locator,
+                        const PointsContainer *        points,
+                        const PointsSTLContainerType & locatorPoints) const
+{
+  if (this->m_PointsLocatorRebuildTolerance <= 0 || locator->GetPoints() != points ||
+      locatorPoints.size() != points->Size())
+  {
+    return false;
+  }
+
+  const PointsSTLContainerType & currentPoints = points->CastToSTLConstContainer();
+  const CoordRepType             squaredTolerance = Math::sqr(this->m_PointsLocatorRebuildTolerance);
+  for (size_t i = 0; i < currentPoints.size(); ++i)
+  {
+    if (currentPoints[i].SquaredEuclideanDistanceTo(locatorPoints[i]) > squaredTolerance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <typename TFixedPointSet, typename TMovingPointSet, class TInternalComputationValueType>
 const typename PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalComputationValueType>::
   PointIdentifierRanges
@@ -678,6 +785,8 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
      << std::endl;
   os << indent << "StoreDerivativeAsSparseFieldForLocalSupportTransforms: "
      << (m_StoreDerivativeAsSparseFieldForLocalSupportTransforms ? "On" : "Off") << std::endl;
+  os << indent << "PointsLocatorRebuildTolerance: "
+     << static_cast<typename NumericTraits<CoordRepType>::PrintType>(m_PointsLocatorRebuildTolerance) << std::endl;
 
   os << indent << "MovingTransformedPointSetTime: "
      << static_cast<typename NumericTraits<ModifiedTimeType>::PrintType>(m_MovingTransformedPointSetTime) << std::endl;
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkTranslationTransform.h"
+
+#include <cmath>
+
+/*
+ * Compare the value and derivative of the dense ANTS neighborhood
+ * correlation metric with a brute force computation, which sums the terms
+ * of the local cross correlation over the window of each voxel.
+ *
+ * The images are 3-D, with a region which does not start at the origin and
+ * an anisotropic radius. Their rows along the first dimension and the
+ * radius along the last one are large enough for the buffer of the filtered
+ * slices to exceed its maximum size with a single work unit, so that the
+ * threader splits its region into tiles along the second dimension, and
+ * their number of slices exceeds the length of the window along the last
+ * dimension, so that the ring of filtered slices wraps around.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using ImageType = itk::Image<double, Dimension>;
+using MetricType = itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+
+ImageType::Pointer
+CreateImage(const ImageType::RegionType & region, const bool moving)
+{
+  auto image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0];
+    const double y = it.GetIndex()[1];
+    const double z = it.GetIndex()[2];
+    it.Set(moving ? 40.0 * std::sin(0.19 * x + 0.15 * y + 0.05 * z) + 0.02 * y * z
+                  : 50.0 * std::sin(0.21 * x + 0.13 * y) * std::cos(0.17 * z) + 0.3 * x);
+  }
+  return image;
+}
+} // namespace
+
+int
+itkANTSNeighborhoodCorrelationImageToImageMetricv4Test2(int, char *[])
+{
+  const ImageType::RegionType region({ { -3, 5, 2 } }, { { 96, 112, 30 } });
+  const ImageType::SizeType   radius = { { 1, 2, 12 } };
+
+  const auto fixedImage = CreateImage(region, false);
+  const auto movingImage = CreateImage(region, true);
+
+  auto metric = MetricType::New();
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetMovingTransform(TransformType::New());
+  metric->SetRadius(radius);
+  metric->SetUseMovingImageGradientFilter(false);
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+
+  // Brute force sums over the windows, clipped to the region
+  const auto fixed = fixedImage->GetBufferPointer();
+  const auto moving = movingImage->GetBufferPointer();
+
+  const auto * const gradientCalculator = metric->GetMovingImageGradientCalculator();
+
+  double                     bruteForceValue = 0.0;
+  MetricType::DerivativeType bruteForceDerivative(metric->GetNumberOfParameters());
+  bruteForceDerivative.Fill(0.0);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(fixedImage, region); !it.IsAtEnd(); ++it)
+  {
+    ImageType::RegionType window(it.GetIndex(), ImageType::SizeType::Filled(1));
+    window.PadByRadius(radius);
+    window.Crop(region);
+
+    double count = 0.0;
+    double sumFixed = 0.0;
+    double sumMoving = 0.0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> wt(fixedImage, window); !wt.IsAtEnd(); ++wt)
+    {
+      const auto offset = fixedImage->ComputeOffset(wt.GetIndex());
+      count += 1.0;
+      sumFixed += fixed[offset];
+      sumMoving += moving[offset];
+    }
+    const double fixedMean = sumFixed / count;
+    const double movingMean = sumMoving / count;
+
+    double sFixedFixed = 0.0;
+    double sMovingMoving = 0.0;
+    double sFixedMoving = 0.0;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> wt(fixedImage, window); !wt.IsAtEnd(); ++wt)
+    {
+      const auto   offset = fixedImage->ComputeOffset(wt.GetIndex());
+      const double fixedA = fixed[offset] - fixedMean;
+      const double movingA = moving[offset] - movingMean;
+      sFixedFixed += fixedA * fixedA;
+      sMovingMoving += movingA * movingA;
+      sFixedMoving += fixedA * movingA;
+    }
+
+    bruteForceValue -= sFixedMoving * sFixedMoving / (sFixedFixed * sMovingMoving);
+
+    // The Jacobian of the translation is the identity
+    const auto           offset = fixedImage->ComputeOffset(it.GetIndex());
+    const double         fixedI = fixed[offset] - fixedMean;
+    const double         movingI = moving[offset] - movingMean;
+    ImageType::PointType point;
+    fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const auto gradient = gradientCalculator->Evaluate(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      bruteForceDerivative[d] += 2.0 * sFixedMoving / (sFixedFixed * sMovingMoving) *
+                                 (fixedI - sFixedMoving / sMovingMoving * movingI) * gradient[d];
+    }
+  }
+  bruteForceValue /= region.GetNumberOfPixels();
+  bruteForceDerivative /= region.GetNumberOfPixels();
+
+  std::cout << "Brute force value: " << bruteForceValue << ", derivative: " << bruteForceDerivative << std::endl;
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 4 })
+  {
+    metric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    metric->GetValueAndDerivative(value, derivative);
+    std::cout << numberOfWorkUnits << " work units: value " << value << ", derivative " << derivative << std::endl;
+
+    ITK_TEST_EXPECT_EQUAL(metric->GetNumberOfValidPoints(), region.GetNumberOfPixels());
+    ITK_TEST_EXPECT_TRUE(std::abs(value - bruteForceValue) <= 1e-10 * std::abs(bruteForceValue));
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(std::abs(derivative[d] - bruteForceDerivative[d]) <=
+                           1e-8 * bruteForceDerivative.inf_norm());
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
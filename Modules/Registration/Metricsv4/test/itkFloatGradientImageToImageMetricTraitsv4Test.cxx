@@ -0,0 +1,194 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkFloatGradientImageToImageMetricTraitsv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*
+ * Verify that the four main image metrics give the same values, and the
+ * same derivatives up to the single precision of the gradient images, with
+ * FloatGradientImageToImageMetricTraitsv4 as with the default traits, and
+ * report the time taken with both.  Usage:
+ * itkFloatGradientImageToImageMetricTraitsv4Test [image-size [number-of-reps]]
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using ImageType = itk::Image<double, Dimension>;
+using FloatTraitsType = itk::FloatGradientImageToImageMetricTraitsv4<ImageType, ImageType, ImageType>;
+using TransformType = itk::AffineTransform<double, Dimension>;
+
+ImageType::Pointer
+CreateImage(const unsigned int imageSize, const double shift)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(imageSize));
+  image->Allocate();
+
+  const double                                 center = 0.5 * imageSize + shift;
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - center;
+    const double y = it.GetIndex()[1] - center;
+    const double z = it.GetIndex()[2] - center;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y + 1.5 * z * z) / (0.1 * imageSize * imageSize)) + 0.2 * x);
+  }
+  return image;
+}
+
+template <typename TMetric>
+void
+RunMetric(TMetric *                          metric,
+          const ImageType *                  fixedImage,
+          const ImageType *                  movingImage,
+          const unsigned int                 numberOfReps,
+          typename TMetric::MeasureType &    value,
+          typename TMetric::DerivativeType & derivative)
+{
+  auto transform = TransformType::New();
+  transform->SetCenter(itk::MakePoint(10.0, 10.0, 10.0));
+  transform->Translate(itk::MakeVector(0.5, -0.25, 0.75));
+
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetMovingTransform(transform);
+
+  itk::TimeProbe initializeProbe;
+  initializeProbe.Start();
+  metric->Initialize();
+  initializeProbe.Stop();
+
+  itk::TimeProbe evaluateProbe;
+  evaluateProbe.Start();
+  for (unsigned int r = 0; r < numberOfReps; ++r)
+  {
+    metric->GetValueAndDerivative(value, derivative);
+  }
+  evaluateProbe.Stop();
+
+  std::cout << "  " << metric->GetNameOfClass() << " with "
+            << (std::is_same_v<typename TMetric::MetricTraits, FloatTraitsType> ? "float" : "default")
+            << " gradients: Initialize " << initializeProbe.GetTotal() << " s, GetValueAndDerivative "
+            << evaluateProbe.GetMean() / numberOfReps << " s" << std::endl;
+}
+
+template <typename TDefaultMetric, typename TFloatMetric>
+bool
+CompareMetrics(TDefaultMetric *   defaultMetric,
+               TFloatMetric *     floatMetric,
+               const ImageType *  fixedImage,
+               const ImageType *  movingImage,
+               const unsigned int numberOfReps)
+{
+  typename TDefaultMetric::MeasureType    defaultValue;
+  typename TDefaultMetric::DerivativeType defaultDerivative;
+  RunMetric(defaultMetric, fixedImage, movingImage, numberOfReps, defaultValue, defaultDerivative);
+
+  typename TFloatMetric::MeasureType    floatValue;
+  typename TFloatMetric::DerivativeType floatDerivative;
+  RunMetric(floatMetric, fixedImage, movingImage, numberOfReps, floatValue, floatDerivative);
+
+  bool passed = true;
+  if (std::abs(floatValue - defaultValue) > 1e-6 * (1.0 + std::abs(defaultValue)))
+  {
+    std::cerr << "Value " << floatValue << " differs from " << defaultValue << std::endl;
+    passed = false;
+  }
+
+  double maximumDerivative = 0.0;
+  for (unsigned int i = 0; i < defaultDerivative.GetSize(); ++i)
+  {
+    maximumDerivative = std::max(maximumDerivative, std::abs(defaultDerivative[i]));
+  }
+  if (floatDerivative.GetSize() != defaultDerivative.GetSize() || maximumDerivative == 0.0)
+  {
+    std::cerr << "Unexpected derivative " << floatDerivative << " vs " << defaultDerivative << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < defaultDerivative.GetSize(); ++i)
+  {
+    if (std::abs(floatDerivative[i] - defaultDerivative[i]) > 1e-5 * maximumDerivative)
+    {
+      std::cerr << "Derivative[" << i << "] " << floatDerivative[i] << " differs from " << defaultDerivative[i]
+                << std::endl;
+      passed = false;
+    }
+  }
+
+  // The gradient image of the moving image is stored in single precision
+  const auto * gradientImage = floatMetric->GetMovingImageGradientImage();
+  if (gradientImage == nullptr ||
+      !std::is_same_v<typename std::remove_pointer_t<decltype(gradientImage)>::PixelType::ValueType, float>)
+  {
+    std::cerr << "The moving image gradient image is not stored as float" << std::endl;
+    passed = false;
+  }
+  return passed;
+}
+
+template <template <typename...> class TMetric>
+bool
+TestMetric(const ImageType * fixedImage, const ImageType * movingImage, const unsigned int numberOfReps)
+{
+  using DefaultMetricType = TMetric<ImageType, ImageType>;
+  using FloatMetricType = TMetric<ImageType, ImageType, ImageType, double, FloatTraitsType>;
+
+  auto defaultMetric = DefaultMetricType::New();
+  auto floatMetric = FloatMetricType::New();
+  return CompareMetrics(defaultMetric.GetPointer(), floatMetric.GetPointer(), fixedImage, movingImage, numberOfReps);
+}
+} // namespace
+
+int
+itkFloatGradientImageToImageMetricTraitsv4Test(int argc, char * argv[])
+{
+  const unsigned int imageSize = argc > 1 ? std::stoi(argv[1]) : 24;
+  const unsigned int numberOfReps = argc > 2 ? std::stoi(argv[2]) : 1;
+  std::cout << "Image size: " << imageSize << ", reps: " << numberOfReps << std::endl;
+
+  const auto fixedImage = CreateImage(imageSize, 0.0);
+  const auto movingImage = CreateImage(imageSize, 1.5);
+
+  bool passed = true;
+  passed &= TestMetric<itk::MeanSquaresImageToImageMetricv4>(fixedImage, movingImage, numberOfReps);
+  passed &= TestMetric<itk::MattesMutualInformationImageToImageMetricv4>(fixedImage, movingImage, numberOfReps);
+  passed &= TestMetric<itk::ANTSNeighborhoodCorrelationImageToImageMetricv4>(fixedImage, movingImage, numberOfReps);
+  passed &=
+    TestMetric<itk::JointHistogramMutualInformationImageToImageMetricv4>(fixedImage, movingImage, numberOfReps);
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
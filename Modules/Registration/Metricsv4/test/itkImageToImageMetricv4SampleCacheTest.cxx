@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkImageToImageMetricv4TestSupport.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkTestingMacros.h"
+#include "itkTranslationTransform.h"
+
+/* Verify that the image metrics evaluated over a sampled point set give the
+ * same values and derivatives with the sample cache as without it, across
+ * updates of the moving transform parameters, of the fixed transform, and
+ * with memory limits that only fit part of the cache. */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<double, Dimension>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+using TranslationTransformType = itk::TranslationTransform<double, Dimension>;
+
+itk::TransformBaseTemplate<double>::Pointer
+CreateMovingTransform(const ImageType * image, const bool useBSpline)
+{
+  if (useBSpline)
+  {
+    return ImageToImageMetricv4TestSupport::CreateBSplineTransform<BSplineTransformType>(image, 5).GetPointer();
+  }
+  auto transform = AffineTransformType::New();
+  transform->SetCenter(itk::MakePoint(15.0, 13.0));
+  return transform.GetPointer();
+}
+
+template <typename TMetric>
+bool
+TestSampleCache(const char * metricName, const bool useBSpline)
+{
+  const ImageType::SizeType size = { { 32, 28 } };
+
+  const auto fixedImage = ImageToImageMetricv4TestSupport::CreateBlobImage<ImageType>(size, 15.0, 13.0, 60.0);
+  const auto movingImage = ImageToImageMetricv4TestSupport::CreateBlobImage<ImageType>(size, 16.5, 12.0, 60.0);
+  const auto pointSet =
+    ImageToImageMetricv4TestSupport::CreateRandomPointSet<typename TMetric::FixedSampledPointSetType>(
+      fixedImage.GetPointer(), 300);
+
+  bool passed = true;
+
+  // Everything cached, the fixed samples only, and nothing cached
+  for (const itk::SizeValueType memoryLimit : { itk::SizeValueType{ 256 * 1024 * 1024 },
+                                                itk::SizeValueType{ 300 * sizeof(double) * 8 },
+                                                itk::SizeValueType{ 0 } })
+  {
+    using MovingTransformType = typename TMetric::MovingTransformType;
+    const auto cachedMovingTransform = CreateMovingTransform(fixedImage, useBSpline);
+    const auto movingTransform = CreateMovingTransform(fixedImage, useBSpline);
+    const auto cachedFixedTransform = TranslationTransformType::New();
+    const auto fixedTransform = TranslationTransformType::New();
+
+    const auto cachedMetric = TMetric::New();
+    const auto metric = TMetric::New();
+
+    ITK_TEST_SET_GET_BOOLEAN(cachedMetric, UseSampleCache, false);
+    cachedMetric->UseSampleCacheOn();
+    cachedMetric->SetSampleCacheMemoryLimit(memoryLimit);
+    ITK_TEST_SET_GET_VALUE(memoryLimit, cachedMetric->GetSampleCacheMemoryLimit());
+
+    for (TMetric * const m : { cachedMetric.GetPointer(), metric.GetPointer() })
+    {
+      const bool isCached = m == cachedMetric.GetPointer();
+      m->SetFixedImage(fixedImage);
+      m->SetMovingImage(movingImage);
+      m->SetFixedTransform(isCached ? cachedFixedTransform : fixedTransform);
+      m->SetMovingTransform(
+        dynamic_cast<MovingTransformType *>((isCached ? cachedMovingTransform : movingTransform).GetPointer()));
+      m->SetFixedSampledPointSet(pointSet);
+      m->UseSampledPointSetOn();
+      m->SetUseMovingImageGradientFilter(false);
+      m->SetUseFixedImageGradientFilter(false);
+      m->Initialize();
+    }
+
+    // Update the moving transforms as an optimizer would, then move the
+    // fixed transforms, which requires the cache to be built again
+    auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+    randomGenerator->SetSeed(1234);
+    for (unsigned int iteration = 0; iteration < 4; ++iteration)
+    {
+      if (iteration == 3)
+      {
+        const auto translation = itk::MakeVector(0.7, -0.4);
+        cachedFixedTransform->Translate(translation);
+        fixedTransform->Translate(translation);
+      }
+      if (!ImageToImageMetricv4TestSupport::CompareValueAndDerivative(
+            cachedMetric.GetPointer(), metric.GetPointer(), metricName, 1e-9, 1e-9))
+      {
+        std::cerr << metricName << ": the cached evaluation differs with memory limit " << memoryLimit
+                  << " at iteration " << iteration << std::endl;
+        passed = false;
+      }
+
+      const auto update = ImageToImageMetricv4TestSupport::CreateRandomUpdate(
+        metric.GetPointer(), randomGenerator, useBSpline ? 0.2 : 0.01);
+      cachedMetric->UpdateTransformParameters(update, 1.0);
+      metric->UpdateTransformParameters(update, 1.0);
+    }
+  }
+  std::cout << metricName << (useBSpline ? " with BSplineTransform: " : " with AffineTransform: ")
+            << (passed ? "passed" : "failed") << std::endl;
+  return passed;
+}
+
+template <typename TMetric>
+bool
+TestSampleCache(const char * metricName)
+{
+  bool passed = TestSampleCache<TMetric>(metricName, true);
+  passed &= TestSampleCache<TMetric>(metricName, false);
+  return passed;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4SampleCacheTest(int, char *[])
+{
+  bool passed = true;
+
+  passed &= TestSampleCache<itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>>("MeanSquares");
+  passed &= TestSampleCache<itk::CorrelationImageToImageMetricv4<ImageType, ImageType>>("Correlation");
+  passed &= TestSampleCache<itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>>(
+    "ANTSNeighborhoodCorrelation");
+  passed &= TestSampleCache<itk::JointHistogramMutualInformationImageToImageMetricv4<ImageType, ImageType>>(
+    "JointHistogramMutualInformation");
+  passed &= TestSampleCache<itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>>(
+    "MattesMutualInformation");
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkImageToImageMetricv4TestSupport.h"
+#include "itkJointHistogramMutualInformationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+
+#include <utility>
+
+/* Verify that the derivatives of the image metrics computed with the sparse
+ * jacobian of a BSplineTransform are the same as those computed with its
+ * dense jacobian. */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<double, Dimension>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+
+/* A BSplineTransform whose jacobian is used as a dense jacobian by the
+ * metrics, as it reports one non-zero jacobian index per parameter. */
+class DenseJacobianBSplineTransform : public BSplineTransformType
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(DenseJacobianBSplineTransform);
+
+  using Self = DenseJacobianBSplineTransform;
+  using Superclass = BSplineTransformType;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+
+  NumberOfParametersType
+  GetNumberOfNonZeroJacobianIndices() const override
+  {
+    return this->GetNumberOfLocalParameters();
+  }
+
+protected:
+  DenseJacobianBSplineTransform() = default;
+  ~DenseJacobianBSplineTransform() override = default;
+};
+
+template <typename TTransform>
+typename TTransform::Pointer
+CreateTransform(const ImageType * image)
+{
+  auto transform = ImageToImageMetricv4TestSupport::CreateBSplineTransform<TTransform>(image, 5);
+
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(1234);
+  auto parameters = transform->GetParameters();
+  for (unsigned int i = 0; i < parameters.GetSize(); ++i)
+  {
+    parameters[i] = randomGenerator->GetUniformVariate(-0.5, 0.5);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+template <typename TMetric>
+bool
+TestSparseJacobian(const char * metricName)
+{
+  const ImageType::SizeType size = { { 32, 28 } };
+
+  const auto fixedImage = ImageToImageMetricv4TestSupport::CreateBlobImage<ImageType>(size, 15.0, 13.0, 60.0);
+  const auto movingImage = ImageToImageMetricv4TestSupport::CreateBlobImage<ImageType>(size, 16.5, 12.0, 60.0);
+
+  const auto sparseTransform = CreateTransform<BSplineTransformType>(fixedImage);
+  const auto denseTransform = CreateTransform<DenseJacobianBSplineTransform>(fixedImage);
+  const auto sparseMetric = TMetric::New();
+  const auto denseMetric = TMetric::New();
+
+  const std::pair<TMetric *, BSplineTransformType *> metricsAndTransforms[] = {
+    { sparseMetric.GetPointer(), sparseTransform.GetPointer() },
+    { denseMetric.GetPointer(), denseTransform.GetPointer() }
+  };
+  for (const auto & metricAndTransform : metricsAndTransforms)
+  {
+    TMetric * const metric = metricAndTransform.first;
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    metric->SetMovingTransform(metricAndTransform.second);
+    metric->Initialize();
+  }
+
+  const bool passed = ImageToImageMetricv4TestSupport::CompareValueAndDerivative(
+    sparseMetric.GetPointer(), denseMetric.GetPointer(), metricName, 1e-12, 1e-9);
+  std::cout << metricName << ": " << (passed ? "passed" : "failed") << std::endl;
+  return passed;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4SparseJacobianTest(int, char *[])
+{
+  bool passed = true;
+
+  passed &= TestSparseJacobian<itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>>("MeanSquares");
+  passed &= TestSparseJacobian<itk::CorrelationImageToImageMetricv4<ImageType, ImageType>>("Correlation");
+  passed &= TestSparseJacobian<itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>>(
+    "ANTSNeighborhoodCorrelation");
+  passed &= TestSparseJacobian<itk::JointHistogramMutualInformationImageToImageMetricv4<ImageType, ImageType>>(
+    "JointHistogramMutualInformation");
+  passed &= TestSparseJacobian<itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>>(
+    "MattesMutualInformation");
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkImageToImageMetricv4TestSupport_h
+#define itkImageToImageMetricv4TestSupport_h
+
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+// Fixtures shared by the tests which compare two ways of evaluating the
+// same image metric: 2-D images of a smooth blob, a BSplineTransform
+// covering them, sampled point sets, and the comparison of the values and
+// derivatives of a pair of metrics.
+
+namespace ImageToImageMetricv4TestSupport
+{
+/** Image of an elongated Gaussian blob centered at (centerX, centerY), of
+ * the given width, on top of a ramp along x, so that no transform leaves it
+ * unchanged. */
+template <typename TImage>
+typename TImage::Pointer
+CreateBlobImage(const typename TImage::SizeType & size, double centerX, double centerY, double width)
+{
+  auto image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - centerX;
+    const double y = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / width) + 0.5 * x);
+  }
+  return image;
+}
+
+/** BSplineTransform whose domain covers the image with a margin of two
+ * pixels. */
+template <typename TTransform, typename TImage>
+typename TTransform::Pointer
+CreateBSplineTransform(const TImage * image, unsigned int meshSize)
+{
+  const typename TImage::SizeType size = image->GetLargestPossibleRegion().GetSize();
+
+  auto transform = TTransform::New();
+  transform->SetTransformDomainOrigin(itk::MakePoint(-2.0, -2.0));
+  transform->SetTransformDomainPhysicalDimensions(itk::MakeVector(size[0] + 4.0, size[1] + 4.0));
+  transform->SetTransformDomainMeshSize(TTransform::MeshSizeType::Filled(meshSize));
+  return transform;
+}
+
+/** Points drawn uniformly at least one pixel away from the border of the
+ * image. */
+template <typename TPointSet, typename TImage>
+typename TPointSet::Pointer
+CreateRandomPointSet(const TImage * image, unsigned int numberOfPoints)
+{
+  const typename TImage::SizeType size = image->GetLargestPossibleRegion().GetSize();
+
+  auto pointSet = TPointSet::New();
+  pointSet->Initialize();
+
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(5678);
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    typename TPointSet::PointType point;
+    point[0] = randomGenerator->GetUniformVariate(1.0, size[0] - 2.0);
+    point[1] = randomGenerator->GetUniformVariate(1.0, size[1] - 2.0);
+    pointSet->SetPoint(i, point);
+  }
+  return pointSet;
+}
+
+/** Random update of the parameters of the metric, within [-range, range]. */
+template <typename TMetric>
+typename TMetric::DerivativeType
+CreateRandomUpdate(const TMetric *                                       metric,
+                   itk::Statistics::MersenneTwisterRandomVariateGenerator * randomGenerator,
+                   double                                                range)
+{
+  typename TMetric::DerivativeType update(metric->GetNumberOfParameters());
+  for (unsigned int i = 0; i < update.GetSize(); ++i)
+  {
+    update[i] = randomGenerator->GetUniformVariate(-range, range);
+  }
+  return update;
+}
+
+/** Compare the value and derivative of metric with those of
+ * referenceMetric. The tolerances are relative to the magnitude of the
+ * reference value and of the largest reference derivative. */
+template <typename TMetric>
+bool
+CompareValueAndDerivative(const TMetric * metric,
+                          const TMetric * referenceMetric,
+                          const char *    metricName,
+                          double          valueTolerance,
+                          double          derivativeTolerance)
+{
+  typename TMetric::MeasureType    value;
+  typename TMetric::MeasureType    referenceValue;
+  typename TMetric::DerivativeType derivative;
+  typename TMetric::DerivativeType referenceDerivative;
+  metric->GetValueAndDerivative(value, derivative);
+  referenceMetric->GetValueAndDerivative(referenceValue, referenceDerivative);
+
+  double maximumDerivative = 0.0;
+  for (unsigned int i = 0; i < referenceDerivative.GetSize(); ++i)
+  {
+    maximumDerivative = std::max(maximumDerivative, std::abs(referenceDerivative[i]));
+  }
+
+  bool passed = true;
+  if (std::abs(value - referenceValue) > valueTolerance * (1.0 + std::abs(referenceValue)))
+  {
+    std::cerr << metricName << ": value " << value << " differs from " << referenceValue << std::endl;
+    passed = false;
+  }
+  if (derivative.GetSize() != referenceDerivative.GetSize() || maximumDerivative == 0.0)
+  {
+    std::cerr << metricName << ": unexpected derivative " << derivative << " vs " << referenceDerivative << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < referenceDerivative.GetSize(); ++i)
+  {
+    if (std::abs(derivative[i] - referenceDerivative[i]) > derivativeTolerance * (1.0 + maximumDerivative))
+    {
+      std::cerr << metricName << ": derivative[" << i << "] " << derivative[i] << " differs from "
+                << referenceDerivative[i] << std::endl;
+      passed = false;
+    }
+  }
+  return passed;
+}
+} // namespace ImageToImageMetricv4TestSupport
+
+#endif
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkImageToImageMetricv4TestSupport.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkTestingMacros.h"
+
+/* Verify that the Mattes mutual information metric gives the same values
+ * and derivatives when the derivatives of the joint PDF are computed
+ * implicitly as when they are computed explicitly, for a transform with a
+ * dense Jacobian and for one with a sparse Jacobian, over the whole
+ * virtual domain and over a sampled point set. */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<double, Dimension>;
+using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+using BSplineTransformType = itk::BSplineTransform<double, Dimension, 3>;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+
+MetricType::MovingTransformType::Pointer
+CreateMovingTransform(const ImageType * image, const bool useBSpline)
+{
+  if (useBSpline)
+  {
+    return ImageToImageMetricv4TestSupport::CreateBSplineTransform<BSplineTransformType>(image, 6).GetPointer();
+  }
+  auto transform = AffineTransformType::New();
+  transform->SetCenter(itk::MakePoint(23.0, 19.0));
+  return transform.GetPointer();
+}
+
+bool
+TestImplicitDerivatives(const bool useBSpline, const bool useSampling)
+{
+  using namespace ImageToImageMetricv4TestSupport;
+
+  const ImageType::SizeType size = { { 48, 40 } };
+  const auto                fixedImage = CreateBlobImage<ImageType>(size, 23.0, 19.0, 150.0);
+  const auto                movingImage = CreateBlobImage<ImageType>(size, 25.5, 17.0, 150.0);
+
+  const auto pointSet = CreateRandomPointSet<MetricType::FixedSampledPointSetType>(fixedImage.GetPointer(), 600);
+
+  const auto explicitMovingTransform = CreateMovingTransform(fixedImage, useBSpline);
+  const auto implicitMovingTransform = CreateMovingTransform(fixedImage, useBSpline);
+
+  const auto explicitMetric = MetricType::New();
+  const auto implicitMetric = MetricType::New();
+
+  ITK_TEST_SET_GET_BOOLEAN(implicitMetric, UseExplicitPDFDerivatives, true);
+  implicitMetric->UseExplicitPDFDerivativesOff();
+
+  for (MetricType * const m : { explicitMetric.GetPointer(), implicitMetric.GetPointer() })
+  {
+    m->SetFixedImage(fixedImage);
+    m->SetMovingImage(movingImage);
+    m->SetMovingTransform(m == explicitMetric ? explicitMovingTransform : implicitMovingTransform);
+    m->SetNumberOfHistogramBins(32);
+    if (useSampling)
+    {
+      m->SetFixedSampledPointSet(pointSet);
+      m->UseSampledPointSetOn();
+    }
+    m->SetUseMovingImageGradientFilter(false);
+    m->SetUseFixedImageGradientFilter(false);
+    m->Initialize();
+  }
+
+  bool passed = true;
+
+  auto randomGenerator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  randomGenerator->SetSeed(1234);
+  for (unsigned int iteration = 0; iteration < 3; ++iteration)
+  {
+    if (!CompareValueAndDerivative(implicitMetric.GetPointer(), explicitMetric.GetPointer(), "Implicit", 1e-12, 1e-9))
+    {
+      passed = false;
+    }
+    if (implicitMetric->GetJointPDFDerivatives().IsNotNull())
+    {
+      std::cerr << "The joint PDF derivatives are allocated with implicit derivatives" << std::endl;
+      passed = false;
+    }
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+    implicitMetric->GetValueAndDerivative(value, derivative);
+    if (value != implicitMetric->GetValue())
+    {
+      std::cerr << "GetValue " << implicitMetric->GetValue() << " differs from " << value << std::endl;
+      passed = false;
+    }
+
+    const auto update = CreateRandomUpdate(explicitMetric.GetPointer(), randomGenerator, useBSpline ? 0.5 : 0.01);
+    explicitMetric->UpdateTransformParameters(update, 1.0);
+    implicitMetric->UpdateTransformParameters(update, 1.0);
+  }
+
+  std::cout << (useBSpline ? "BSplineTransform" : "AffineTransform")
+            << (useSampling ? " with sampling: " : " without sampling: ") << (passed ? "passed" : "failed")
+            << std::endl;
+  return passed;
+}
+} // namespace
+
+int
+itkMattesMutualInformationImageToImageMetricv4ImplicitDerivativesTest(int, char *[])
+{
+  bool passed = true;
+  for (const bool useBSpline : { true, false })
+  {
+    for (const bool useSampling : { false, true })
+    {
+      passed &= TestImplicitDerivatives(useBSpline, useSampling);
+    }
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
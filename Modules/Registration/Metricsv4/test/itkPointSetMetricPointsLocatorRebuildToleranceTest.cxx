@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkEuclideanDistancePointSetToPointSetMetricv4.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Move the points by small steps, in tangent space, and verify that the
+ * Euclidean distance metric which reuses its points locator within a
+ * rebuild tolerance gives values within the tolerance of the exact ones.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using PointSetType = itk::PointSet<float, Dimension>;
+using PointType = PointSetType::PointType;
+using MetricType = itk::EuclideanDistancePointSetToPointSetMetricv4<PointSetType>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+
+PointSetType::Pointer
+CreatePointSet(const unsigned int numberOfPoints, const double noise)
+{
+  using GeneratorType = itk::Statistics::MersenneTwisterRandomVariateGenerator;
+  auto generator = GeneratorType::New();
+  generator->Initialize(1234 + numberOfPoints);
+
+  auto pointSet = PointSetType::New();
+  pointSet->Initialize();
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    // Points along a spiral
+    const double angle = 12.0 * i / numberOfPoints;
+    const double radius = 1.0 + angle;
+    PointType    point;
+    point[0] = radius * std::cos(angle) + noise * generator->GetNormalVariate();
+    point[1] = radius * std::sin(angle) + noise * generator->GetNormalVariate();
+    pointSet->SetPoint(i, point);
+  }
+  return pointSet;
+}
+
+MetricType::Pointer
+CreateMetric(const PointSetType *           fixedPoints,
+             const PointSetType *           movingPoints,
+             const MetricType::CoordRepType tolerance)
+{
+  auto metric = MetricType::New();
+  metric->SetFixedPointSet(fixedPoints);
+  metric->SetMovingPointSet(movingPoints);
+  metric->SetMovingTransform(TransformType::New());
+  metric->SetCalculateValueAndDerivativeInTangentSpace(true);
+  metric->SetStoreDerivativeAsSparseFieldForLocalSupportTransforms(false);
+  metric->SetPointsLocatorRebuildTolerance(tolerance);
+  metric->Initialize();
+  return metric;
+}
+} // namespace
+
+int
+itkPointSetMetricPointsLocatorRebuildToleranceTest(int, char *[])
+{
+  const auto fixedPoints = CreatePointSet(3000, 0.05);
+  const auto movingPoints = CreatePointSet(5000, 0.02);
+
+  constexpr MetricType::CoordRepType tolerance = 0.05;
+  auto                               exactMetric = CreateMetric(fixedPoints, movingPoints, 0.0);
+  auto                               metric = CreateMetric(fixedPoints, movingPoints, tolerance);
+  ITK_TEST_SET_GET_VALUE(0.0f, exactMetric->GetPointsLocatorRebuildTolerance());
+  ITK_TEST_SET_GET_VALUE(tolerance, metric->GetPointsLocatorRebuildTolerance());
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(metric, EuclideanDistancePointSetToPointSetMetricv4, PointSetToPointSetMetricv4);
+
+  MetricType::ParametersType parameters(Dimension);
+  parameters.Fill(0.0);
+  const MetricType::MovingTransformedPointSetType * transformedPoints = nullptr;
+  unsigned int                                      numberOfInexactValues = 0;
+  for (unsigned int step = 0; step < 40; ++step)
+  {
+    parameters[0] = 0.013 * step;
+    parameters[1] = -0.007 * step;
+    exactMetric->SetParameters(parameters);
+    metric->SetParameters(parameters);
+
+    const MetricType::MeasureType exactValue = exactMetric->GetValue();
+    MetricType::MeasureType       value;
+    MetricType::DerivativeType    derivative;
+    metric->GetValueAndDerivative(value, derivative);
+
+    // The nearest neighbors found may be farther than the exact ones, by at
+    // most the tolerance
+    if (value < exactValue - 1e-6 || value > exactValue + tolerance)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error at step " << step << ": value " << value << " is not within [" << exactValue << ", "
+                << exactValue + tolerance << ']' << std::endl;
+      return EXIT_FAILURE;
+    }
+    numberOfInexactValues += itk::Math::NotAlmostEquals(value, exactValue) ? 1 : 0;
+
+    // The transformed points are updated in place, for the points locator
+    if (step > 0)
+    {
+      ITK_TEST_EXPECT_TRUE(metric->GetMovingTransformedPointSet() == transformedPoints);
+    }
+    transformedPoints = metric->GetMovingTransformedPointSet();
+  }
+  std::cout << "Number of inexact values: " << numberOfInexactValues << std::endl;
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -54,10 +54,11 @@ namespace itk
  * of smoothing is governed by a set of user defined standard deviations
  * (one for each dimension).
  *
- * In terms of memory, this filter keeps two internal buffers: one for storing
- * the intermediate updates to the field and one for double-buffering when
- * smoothing the displacement field. Both buffers are the same type and size as the
- * output displacement field.
+ * In terms of memory, this filter keeps one internal buffer for storing the
+ * intermediate updates to the field, of the same type and size as the output
+ * displacement field. The displacement field and the update buffer are
+ * smoothed in place, one line at a time, so that smoothing allocates no
+ * further field.
  *
  * This class make use of the finite difference solver hierarchy. Update
  * for each iteration is computed using a PDEDeformableRegistrationFunction.
@@ -248,12 +249,13 @@ protected:
   virtual void
   SmoothUpdateField();
 
-  /** Release the memory of the internal buffers.
-   *
-   * Called after the solution has been generated.
-   */
+  /** Smooth the given field in place using a separable Gaussian kernel of the
+   * given standard deviations. Along each dimension, the lines of the field
+   * are copied to a line buffer and convolved back into the field, with a zero
+   * flux Neumann boundary condition at the ends of the buffered region. The
+   * lines are processed in parallel. */
   void
-  PostProcessOutput() override;
+  SmoothFieldInPlace(DisplacementFieldType * field, const StandardDeviationsType & standardDeviations);
 
   /** Initialize flags.
    *
@@ -287,10 +289,6 @@ private:
   bool m_SmoothDisplacementField{};
   bool m_SmoothUpdateField{};
 
-  /** Temporary displacement field use for smoothing the
-   * the displacement field. */
-  DisplacementFieldPointer m_TempField{};
-
 private:
   /** Maximum error for Gaussian operator approximation. */
   double m_MaximumError{};
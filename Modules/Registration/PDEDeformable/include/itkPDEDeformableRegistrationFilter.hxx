@@ -24,10 +24,13 @@
 #include "itkDataObject.h"
 
 #include "itkGaussianOperator.h"
-#include "itkVectorNeighborhoodOperatorImageFilter.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itkMath.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace itk
 {
 
@@ -54,7 +57,6 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
     m_UpdateFieldStandardDeviations[j] = 1.0;
   }
 
-  m_TempField = DisplacementFieldType::New();
   m_MaximumError = 0.1;
   m_MaximumKernelWidth = 30;
   m_StopRegistrationFlag = false;
@@ -145,8 +147,6 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
   os << indent << "SmoothDisplacementField: " << (m_SmoothDisplacementField ? "On" : "Off") << std::endl;
   os << indent << "SmoothUpdateField: " << (m_SmoothUpdateField ? "On" : "Off") << std::endl;
 
-  itkPrintSelfObjectMacro(TempField);
-
   os << indent << "MaximumError: " << m_MaximumError << std::endl;
   os << indent << "MaximumKernelWidth: " << m_MaximumKernelWidth << std::endl;
   os << indent << "StopRegistrationFlag: " << (m_StopRegistrationFlag ? "On" : "Off") << std::endl;
@@ -266,14 +266,6 @@ PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::
   }
 }
 
-template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
-void
-PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::PostProcessOutput()
-{
-  this->Superclass::PostProcessOutput();
-  m_TempField->Initialize();
-}
-
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
 void
 PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::Initialize()
@@ -286,61 +278,7 @@ template <typename TFixedImage, typename TMovingImage, typename TDisplacementFie
 void
 PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothDisplacementField()
 {
-  DisplacementFieldPointer field = this->GetOutput();
-
-  // copy field to TempField
-  m_TempField->SetOrigin(field->GetOrigin());
-  m_TempField->SetSpacing(field->GetSpacing());
-  m_TempField->SetDirection(field->GetDirection());
-  m_TempField->SetLargestPossibleRegion(field->GetLargestPossibleRegion());
-  m_TempField->SetRequestedRegion(field->GetRequestedRegion());
-  m_TempField->SetBufferedRegion(field->GetBufferedRegion());
-  m_TempField->Allocate();
-
-  using VectorType = typename DisplacementFieldType::PixelType;
-  using ScalarType = typename VectorType::ValueType;
-  using OperatorType = GaussianOperator<ScalarType, ImageDimension>;
-  using SmootherType = VectorNeighborhoodOperatorImageFilter<DisplacementFieldType, DisplacementFieldType>;
-
-  auto * oper = new OperatorType;
-  auto   smoother = SmootherType::New();
-
-  using PixelContainerPointer = typename DisplacementFieldType::PixelContainerPointer;
-  PixelContainerPointer swapPtr;
-
-  // graft the output field onto the mini-pipeline
-  smoother->GraftOutput(m_TempField);
-
-  for (unsigned int j = 0; j < ImageDimension; ++j)
-  {
-    // smooth along this dimension
-    oper->SetDirection(j);
-    double variance = itk::Math::sqr(m_StandardDeviations[j]);
-    oper->SetVariance(variance);
-    oper->SetMaximumError(m_MaximumError);
-    oper->SetMaximumKernelWidth(m_MaximumKernelWidth);
-    oper->CreateDirectional();
-
-    // todo: make sure we only smooth within the buffered region
-    smoother->SetOperator(*oper);
-    smoother->SetInput(field);
-    smoother->Update();
-
-    if (j + 1 < ImageDimension)
-    {
-      // swap the containers
-      swapPtr = smoother->GetOutput()->GetPixelContainer();
-      smoother->GraftOutput(field);
-      field->SetPixelContainer(swapPtr);
-      smoother->Modified();
-    }
-  }
-
-  // graft the output back to this filter
-  m_TempField->SetPixelContainer(field->GetPixelContainer());
-  this->GraftOutput(smoother->GetOutput());
-
-  delete oper;
+  this->SmoothFieldInPlace(this->GetOutput(), m_StandardDeviations);
 }
 
 template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
@@ -348,47 +286,79 @@ void
 PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothUpdateField()
 {
   // The update buffer will be overwritten with new data.
-  DisplacementFieldPointer field = this->GetUpdateBuffer();
+  this->SmoothFieldInPlace(this->GetUpdateBuffer(), m_UpdateFieldStandardDeviations);
+}
 
+template <typename TFixedImage, typename TMovingImage, typename TDisplacementField>
+void
+PDEDeformableRegistrationFilter<TFixedImage, TMovingImage, TDisplacementField>::SmoothFieldInPlace(
+  DisplacementFieldType *        field,
+  const StandardDeviationsType & standardDeviations)
+{
   using VectorType = typename DisplacementFieldType::PixelType;
   using ScalarType = typename VectorType::ValueType;
   using OperatorType = GaussianOperator<ScalarType, ImageDimension>;
-  using SmootherType = VectorNeighborhoodOperatorImageFilter<DisplacementFieldType, DisplacementFieldType>;
+  using RegionType = typename DisplacementFieldType::RegionType;
+  using IteratorType = ImageLinearIteratorWithIndex<DisplacementFieldType>;
+
+  const RegionType region = field->GetBufferedRegion();
 
-  OperatorType                   opers[ImageDimension];
-  typename SmootherType::Pointer smoothers[ImageDimension];
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   for (unsigned int j = 0; j < ImageDimension; ++j)
   {
     // smooth along this dimension
-    opers[j].SetDirection(j);
-    double variance = itk::Math::sqr(this->GetUpdateFieldStandardDeviations()[j]);
-    // double variance = itk::Math::sqr( 1.0 );
-    opers[j].SetVariance(variance);
-    opers[j].SetMaximumError(this->GetMaximumError());
-    opers[j].SetMaximumKernelWidth(this->GetMaximumKernelWidth());
-    opers[j].CreateDirectional();
-
-    smoothers[j] = SmootherType::New();
-    smoothers[j]->SetOperator(opers[j]);
-    smoothers[j]->ReleaseDataFlagOn();
-
-    if (j > 0)
-    {
-      smoothers[j]->SetInput(smoothers[j - 1]->GetOutput());
-    }
+    OperatorType oper;
+    oper.SetDirection(j);
+    oper.SetVariance(itk::Math::sqr(standardDeviations[j]));
+    oper.SetMaximumError(m_MaximumError);
+    oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
+    oper.CreateDirectional();
+
+    const std::vector<ScalarType> coefficients(oper.Begin(), oper.End());
+    const auto                    radius = static_cast<OffsetValueType>(oper.GetRadius(j));
+    const auto                    lineLength = static_cast<OffsetValueType>(region.GetSize(j));
+
+    multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      j,
+      region,
+      [field, j, &coefficients, radius, lineLength](const RegionType & lineRegion) {
+        std::vector<VectorType> line(lineLength);
+
+        IteratorType it(field, lineRegion);
+        it.SetDirection(j);
+        for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+        {
+          for (auto & value : line)
+          {
+            value = it.Get();
+            ++it;
+          }
+          it.GoToBeginOfLine();
+
+          // The coefficients are applied in the same order as by
+          // VectorNeighborhoodInnerProduct, and the ends of the line are
+          // repeated as by ZeroFluxNeumannBoundaryCondition.
+          for (OffsetValueType i = 0; i < lineLength; ++i)
+          {
+            VectorType sum{};
+            for (OffsetValueType k = 0; k <= 2 * radius; ++k)
+            {
+              const VectorType & neighbor = line[std::clamp(i + k - radius, OffsetValueType{ 0 }, lineLength - 1)];
+              for (unsigned int d = 0; d < VectorType::Dimension; ++d)
+              {
+                sum[d] += coefficients[k] * neighbor[d];
+              }
+            }
+            it.Set(sum);
+            ++it;
+          }
+        }
+      },
+      nullptr);
   }
-  smoothers[0]->SetInput(field);
-  smoothers[ImageDimension - 1]->GetOutput()->SetRequestedRegion(field->GetBufferedRegion());
-
-  smoothers[ImageDimension - 1]->Update();
-
-  // field to contain the final smoothed data, do the equivalent of a graft
-  field->SetPixelContainer(smoothers[ImageDimension - 1]->GetOutput()->GetPixelContainer());
-  field->SetRequestedRegion(smoothers[ImageDimension - 1]->GetOutput()->GetRequestedRegion());
-  field->SetBufferedRegion(smoothers[ImageDimension - 1]->GetOutput()->GetBufferedRegion());
-  field->SetLargestPossibleRegion(smoothers[ImageDimension - 1]->GetOutput()->GetLargestPossibleRegion());
-  field->CopyInformation(smoothers[ImageDimension - 1]->GetOutput());
+  field->Modified();
 }
 } // end namespace itk
 
@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDemonsRegistrationFilter.h"
+#include "itkGaussianOperator.h"
+#include "itkImageAlgorithm.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkVectorNeighborhoodOperatorImageFilter.h"
+
+#include <cmath>
+
+/*
+ * Compare the in place smoothing of a displacement field by
+ * PDEDeformableRegistrationFilter::SmoothFieldInPlace with the
+ * VectorNeighborhoodOperatorImageFilter pipeline it replaces, with
+ * anisotropic standard deviations, on a field whose buffered region does not
+ * start at the origin and is smaller than its largest possible region: the
+ * field is only smoothed over its buffered region, with a zero flux Neumann
+ * boundary condition at its ends, as the pipeline does on a field made of
+ * the buffered region only.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using VectorType = itk::Vector<double, Dimension>;
+using FieldType = itk::Image<VectorType, Dimension>;
+using ImageType = itk::Image<float, Dimension>;
+
+// Expose the smoothing of PDEDeformableRegistrationFilter to the test
+class SmoothingRegistrationFilter : public itk::DemonsRegistrationFilter<ImageType, ImageType, FieldType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SmoothingRegistrationFilter);
+
+  using Self = SmoothingRegistrationFilter;
+  using Superclass = itk::DemonsRegistrationFilter<ImageType, ImageType, FieldType>;
+  using Pointer = itk::SmartPointer<Self>;
+  using ConstPointer = itk::SmartPointer<const Self>;
+
+  itkNewMacro(Self);
+  itkOverrideGetNameOfClassMacro(SmoothingRegistrationFilter);
+
+  using Superclass::SmoothFieldInPlace;
+
+protected:
+  SmoothingRegistrationFilter() = default;
+  ~SmoothingRegistrationFilter() override = default;
+};
+
+using StandardDeviationsType = SmoothingRegistrationFilter::StandardDeviationsType;
+
+FieldType::Pointer
+SmoothWithOperatorFilters(const FieldType *                   field,
+                          const StandardDeviationsType &      standardDeviations,
+                          const SmoothingRegistrationFilter * registrationFilter)
+{
+  using OperatorType = itk::GaussianOperator<double, Dimension>;
+  using SmootherType = itk::VectorNeighborhoodOperatorImageFilter<FieldType, FieldType>;
+
+  FieldType::Pointer smoothedField = FieldType::New();
+  smoothedField->Graft(field);
+  for (unsigned int j = 0; j < Dimension; ++j)
+  {
+    OperatorType oper;
+    oper.SetDirection(j);
+    oper.SetVariance(itk::Math::sqr(standardDeviations[j]));
+    oper.SetMaximumError(registrationFilter->GetMaximumError());
+    oper.SetMaximumKernelWidth(registrationFilter->GetMaximumKernelWidth());
+    oper.CreateDirectional();
+
+    auto smoother = SmootherType::New();
+    smoother->SetOperator(oper);
+    smoother->SetInput(smoothedField);
+    smoother->Update();
+    smoothedField = smoother->GetOutput();
+    smoothedField->DisconnectPipeline();
+  }
+  return smoothedField;
+}
+} // namespace
+
+int
+itkPDEDeformableRegistrationFilterSmoothingTest(int, char *[])
+{
+  const FieldType::RegionType largestRegion({ { -4, 3, 2 } }, { { 24, 20, 18 } });
+  const FieldType::RegionType bufferedRegion({ { -1, 6, 5 } }, { { 17, 13, 11 } });
+
+  auto field = FieldType::New();
+  field->SetLargestPossibleRegion(largestRegion);
+  field->SetBufferedRegion(bufferedRegion);
+  field->SetRequestedRegion(bufferedRegion);
+  field->SetSpacing(itk::MakeVector(0.8, 1.0, 1.5));
+  field->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<FieldType> it(field, bufferedRegion); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0];
+    const double y = it.GetIndex()[1];
+    const double z = it.GetIndex()[2];
+    it.Set(itk::MakeVector(std::sin(0.7 * x + 0.3 * y) + 0.1 * z,
+                           std::cos(0.5 * y - 0.9 * z) * x,
+                           std::sin(1.3 * z) + 0.2 * x * y));
+  }
+
+  // The reference pipeline smooths a copy of the field whose largest
+  // possible region is its buffered region
+  auto bufferedField = FieldType::New();
+  bufferedField->CopyInformation(field);
+  bufferedField->SetRegions(bufferedRegion);
+  bufferedField->Allocate();
+
+  auto filter = SmoothingRegistrationFilter::New();
+
+  const StandardDeviationsType standardDeviations{ { 0.8, 1.6, 2.5 } };
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1, 3 })
+  {
+    itk::ImageAlgorithm::Copy(field.GetPointer(), bufferedField.GetPointer(), bufferedRegion, bufferedRegion);
+    const auto expected = SmoothWithOperatorFilters(bufferedField, standardDeviations, filter);
+
+    auto smoothedField = FieldType::New();
+    smoothedField->CopyInformation(field);
+    smoothedField->SetBufferedRegion(bufferedRegion);
+    smoothedField->SetRequestedRegion(bufferedRegion);
+    smoothedField->Allocate();
+    itk::ImageAlgorithm::Copy(field.GetPointer(), smoothedField.GetPointer(), bufferedRegion, bufferedRegion);
+
+    filter->SetNumberOfWorkUnits(numberOfWorkUnits);
+    filter->SmoothFieldInPlace(smoothedField, standardDeviations);
+
+    ITK_TEST_EXPECT_EQUAL(smoothedField->GetBufferedRegion(), bufferedRegion);
+    ITK_TEST_EXPECT_EQUAL(smoothedField->GetLargestPossibleRegion(), largestRegion);
+    for (itk::ImageRegionConstIteratorWithIndex<FieldType> it(smoothedField, bufferedRegion); !it.IsAtEnd(); ++it)
+    {
+      const VectorType expectedValue = expected->GetPixel(it.GetIndex());
+      if ((it.Get() - expectedValue).GetNorm() > 1e-12 * (1.0 + expectedValue.GetNorm()))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error with " << numberOfWorkUnits << " work units at index " << it.GetIndex() << ": expected "
+                  << expectedValue << ", but got " << it.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
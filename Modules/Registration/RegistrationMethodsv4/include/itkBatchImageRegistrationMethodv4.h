@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBatchImageRegistrationMethodv4_h
+#define itkBatchImageRegistrationMethodv4_h
+
+#include "itkImageRegistrationPyramidCache.h"
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <string>
+#include <vector>
+
+namespace itk
+{
+/** \class BatchImageRegistrationMethodv4
+ * \brief Registers many moving images to the same fixed image concurrently.
+ *
+ * Atlas and template construction pipelines register one fixed image to
+ * many moving images.  This class runs a batch of registration methods of
+ * type TRegistrationMethod, one per moving image, which share the fixed
+ * image and the data derived from it:
+ *
+ *   \li all the registration methods are given the same fixed image,
+ *   \li all the registration methods are given the same
+ *       ImageRegistrationPyramidCache, so that the smoothed fixed images and
+ *       the shrunk virtual domains of the levels are only computed once.
+ *       The smoothed copies of a moving image are removed from the cache
+ *       when its registration is done, so that the cache does not grow with
+ *       the number of moving images.
+ *
+ * Each registration method is configured by the user, with its own moving
+ * image, metric, optimizer and transforms, and added with AddRegistration().
+ * The metrics may share a fixed image mask, which is only read.  The fixed
+ * image must not be modified while Update() runs.
+ *
+ * Update() runs N registration methods at a time, at most
+ * GetMaximumNumberOfConcurrentRegistrations().  A memory budget may further
+ * limit N, based on an estimate of the memory used by each registration
+ * method (see EstimateMemoryOfRegistration()).  Each registration method
+ * runs on a thread of its own, outside of the pool of the default
+ * multi-threader, and multi-threads its own computations on the P threads
+ * of the default multi-threader with max(1, P / N) work units (see
+ * SetNumberOfWorkUnitsOfRegistration()), so that the batch does not use
+ * more than P threads for these computations.
+ *
+ * After Update(), the transform of each registration method is available
+ * from GetRegistration(i)->GetTransform(), and the values of its metric at
+ * each iteration of its optimizer from GetMetricValues(i).  Registration
+ * methods which do not iterate an optimizer, such as
+ * SyNImageRegistrationMethod, have no metric values.  A registration method
+ * which fails does not stop the others: Update() throws an exception once
+ * all of them have run, and GetErrorDescription(i) describes the failure.
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TRegistrationMethod>
+class ITK_TEMPLATE_EXPORT BatchImageRegistrationMethodv4 : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(BatchImageRegistrationMethodv4);
+
+  /** Standard class type aliases. */
+  using Self = BatchImageRegistrationMethodv4;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(BatchImageRegistrationMethodv4);
+
+  /** Registration method type alias. */
+  using RegistrationMethodType = TRegistrationMethod;
+  using RegistrationMethodPointer = typename RegistrationMethodType::Pointer;
+  using FixedImageType = typename RegistrationMethodType::FixedImageType;
+  using FixedImageConstPointer = typename FixedImageType::ConstPointer;
+  using MovingImageType = typename RegistrationMethodType::MovingImageType;
+  using MeasureType = typename RegistrationMethodType::OptimizerType::MeasureType;
+  using MetricValuesType = std::vector<MeasureType>;
+
+  /** Set/Get the fixed image shared by all the registration methods. */
+  itkSetConstObjectMacro(FixedImage, FixedImageType);
+  itkGetConstObjectMacro(FixedImage, FixedImageType);
+
+  /** Set/Get the pyramid cache shared by all the registration methods.  By
+   * default, the batch creates its own cache. */
+  itkSetObjectMacro(PyramidCache, ImageRegistrationPyramidCache);
+  itkGetModifiableObjectMacro(PyramidCache, ImageRegistrationPyramidCache);
+
+  /** Add a registration method, configured with its moving image, to the
+   * batch. */
+  void
+  AddRegistration(RegistrationMethodType * registration);
+
+  /** Get the registration method of the given index, in the order in which
+   * they were added. */
+  RegistrationMethodType *
+  GetRegistration(SizeValueType index) const;
+
+  /** Get the number of registration methods of the batch. */
+  SizeValueType
+  GetNumberOfRegistrations() const
+  {
+    return static_cast<SizeValueType>(m_Registrations.size());
+  }
+
+  /** Remove all the registration methods, and their results, from the
+   * batch. */
+  void
+  ClearRegistrations();
+
+  /** Set/Get the maximum number of registration methods which run at the
+   * same time.  Defaults to the global default number of threads. */
+  itkSetClampMacro(MaximumNumberOfConcurrentRegistrations, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(MaximumNumberOfConcurrentRegistrations, ThreadIdType);
+
+  /** Set/Get the memory, in bytes, which the registration methods running
+   * at the same time may use.  Zero, the default, means no limit.  At least
+   * one registration method runs, whatever the budget. */
+  itkSetMacro(MemoryBudget, SizeValueType);
+  itkGetConstMacro(MemoryBudget, SizeValueType);
+
+  /** Get the number of registration methods which ran at the same time
+   * during the last Update(). */
+  itkGetConstMacro(NumberOfConcurrentRegistrations, ThreadIdType);
+
+  /** Run all the registration methods of the batch. */
+  virtual void
+  Update();
+
+  /** Get the values of the metric of a registration method at each
+   * iteration of its optimizer, over all its levels, during the last
+   * Update(). */
+  const MetricValuesType &
+  GetMetricValues(SizeValueType index) const;
+
+  /** Get the description of the exception thrown by a registration method
+   * during the last Update(), or an empty string if it succeeded. */
+  const std::string &
+  GetErrorDescription(SizeValueType index) const;
+
+protected:
+  BatchImageRegistrationMethodv4();
+  ~BatchImageRegistrationMethodv4() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Estimate the memory, in bytes, used by a registration method, which is
+   * not shared with the other registration methods of the batch, while it
+   * runs.  The default estimate is the memory of a smoothed copy of the
+   * moving image and of its gradient image.  Subclasses may refine it, e.g.,
+   * to account for the displacement fields of deformable transforms. */
+  virtual SizeValueType
+  EstimateMemoryOfRegistration(const RegistrationMethodType * registration) const;
+
+  /** Set the number of work units of a registration method: those of the
+   * registration method itself, which smooths the images and samples the
+   * virtual domain, of its optimizer and of its image metrics.  Subclasses
+   * may extend it, e.g., to the filters of deformable registration
+   * methods. */
+  virtual void
+  SetNumberOfWorkUnitsOfRegistration(RegistrationMethodType * registration, ThreadIdType numberOfWorkUnits) const;
+
+  /** Run the registration method of the given index. */
+  void
+  RunRegistration(SizeValueType index);
+
+private:
+  FixedImageConstPointer                 m_FixedImage{};
+  ImageRegistrationPyramidCache::Pointer m_PyramidCache{};
+  std::vector<RegistrationMethodPointer> m_Registrations{};
+  std::vector<MetricValuesType>          m_MetricValues{};
+  std::vector<std::string>               m_ErrorDescriptions{};
+  ThreadIdType                           m_MaximumNumberOfConcurrentRegistrations{};
+  SizeValueType                          m_MemoryBudget{};
+  ThreadIdType                           m_NumberOfConcurrentRegistrations{};
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkBatchImageRegistrationMethodv4.hxx"
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBatchImageRegistrationMethodv4_hxx
+#define itkBatchImageRegistrationMethodv4_hxx
+
+#include "itkCovariantVector.h"
+#include "itkMultiThreaderBase.h"
+#include "itkPlatformMultiThreader.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace itk
+{
+
+template <typename TRegistrationMethod>
+BatchImageRegistrationMethodv4<TRegistrationMethod>::BatchImageRegistrationMethodv4()
+  : m_PyramidCache(ImageRegistrationPyramidCache::New())
+  , m_MaximumNumberOfConcurrentRegistrations(MultiThreaderBase::GetGlobalDefaultNumberOfThreads())
+{}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::AddRegistration(RegistrationMethodType * registration)
+{
+  if (registration == nullptr)
+  {
+    itkExceptionMacro("The registration method is null.");
+  }
+  m_Registrations.push_back(registration);
+  this->Modified();
+}
+
+template <typename TRegistrationMethod>
+auto
+BatchImageRegistrationMethodv4<TRegistrationMethod>::GetRegistration(const SizeValueType index) const
+  -> RegistrationMethodType *
+{
+  if (index >= m_Registrations.size())
+  {
+    itkExceptionMacro("Registration index " << index << " is out of range [0, " << m_Registrations.size() << ").");
+  }
+  return m_Registrations[index];
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::ClearRegistrations()
+{
+  m_Registrations.clear();
+  m_MetricValues.clear();
+  m_ErrorDescriptions.clear();
+  this->Modified();
+}
+
+template <typename TRegistrationMethod>
+auto
+BatchImageRegistrationMethodv4<TRegistrationMethod>::GetMetricValues(const SizeValueType index) const
+  -> const MetricValuesType &
+{
+  if (index >= m_MetricValues.size())
+  {
+    itkExceptionMacro("No metric values for registration " << index << ": Update() has not been called.");
+  }
+  return m_MetricValues[index];
+}
+
+template <typename TRegistrationMethod>
+const std::string &
+BatchImageRegistrationMethodv4<TRegistrationMethod>::GetErrorDescription(const SizeValueType index) const
+{
+  if (index >= m_ErrorDescriptions.size())
+  {
+    itkExceptionMacro("No error description for registration " << index << ": Update() has not been called.");
+  }
+  return m_ErrorDescriptions[index];
+}
+
+template <typename TRegistrationMethod>
+SizeValueType
+BatchImageRegistrationMethodv4<TRegistrationMethod>::EstimateMemoryOfRegistration(
+  const RegistrationMethodType * registration) const
+{
+  using MovingPixelType = typename MovingImageType::PixelType;
+  using GradientPixelType = CovariantVector<double, MovingImageType::ImageDimension>;
+
+  const MovingImageType * movingImage = registration->GetMovingImage();
+  if (movingImage == nullptr)
+  {
+    return 0;
+  }
+  return static_cast<SizeValueType>(movingImage->GetLargestPossibleRegion().GetNumberOfPixels()) *
+         (sizeof(MovingPixelType) + sizeof(GradientPixelType));
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::SetNumberOfWorkUnitsOfRegistration(
+  RegistrationMethodType * registration,
+  const ThreadIdType       numberOfWorkUnits) const
+{
+  using MetricType = typename RegistrationMethodType::MetricType;
+  using ImageMetricType = typename RegistrationMethodType::ImageMetricType;
+  using MultiMetricType = typename RegistrationMethodType::MultiMetricType;
+
+  registration->SetNumberOfWorkUnits(numberOfWorkUnits);
+  if (auto * optimizer = registration->GetModifiableOptimizer())
+  {
+    optimizer->SetNumberOfWorkUnits(numberOfWorkUnits);
+  }
+
+  std::vector<MetricType *> metrics{ registration->GetModifiableMetric() };
+  if (auto * multiMetric = dynamic_cast<MultiMetricType *>(metrics.front()))
+  {
+    metrics.clear();
+    for (const auto & metric : multiMetric->GetMetricQueue())
+    {
+      metrics.push_back(metric);
+    }
+  }
+  for (MetricType * metric : metrics)
+  {
+    if (auto * imageMetric = dynamic_cast<ImageMetricType *>(metric))
+    {
+      imageMetric->SetMaximumNumberOfWorkUnits(numberOfWorkUnits);
+    }
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::Update()
+{
+  if (m_FixedImage.IsNull())
+  {
+    itkExceptionMacro("The fixed image is not set.");
+  }
+
+  const auto numberOfRegistrations = static_cast<SizeValueType>(m_Registrations.size());
+  m_MetricValues.assign(numberOfRegistrations, MetricValuesType());
+  m_ErrorDescriptions.assign(numberOfRegistrations, std::string());
+  if (numberOfRegistrations == 0)
+  {
+    m_NumberOfConcurrentRegistrations = 0;
+    return;
+  }
+
+  SizeValueType maximumMemoryOfRegistration = 0;
+  for (const auto & registration : m_Registrations)
+  {
+    registration->SetFixedImage(m_FixedImage);
+    registration->SetPyramidCache(m_PyramidCache);
+    maximumMemoryOfRegistration =
+      std::max(maximumMemoryOfRegistration, this->EstimateMemoryOfRegistration(registration));
+  }
+
+  SizeValueType numberOfConcurrentRegistrations =
+    std::min<SizeValueType>(numberOfRegistrations, m_MaximumNumberOfConcurrentRegistrations);
+  if (m_MemoryBudget > 0 && maximumMemoryOfRegistration > 0)
+  {
+    const SizeValueType numberOfRegistrationsInBudget = m_MemoryBudget / maximumMemoryOfRegistration;
+    numberOfConcurrentRegistrations =
+      std::min(numberOfConcurrentRegistrations, std::max<SizeValueType>(1, numberOfRegistrationsInBudget));
+  }
+  m_NumberOfConcurrentRegistrations = static_cast<ThreadIdType>(numberOfConcurrentRegistrations);
+
+  const ThreadIdType numberOfWorkUnitsPerRegistration = std::max<ThreadIdType>(
+    1, MultiThreaderBase::GetGlobalDefaultNumberOfThreads() / m_NumberOfConcurrentRegistrations);
+  for (const auto & registration : m_Registrations)
+  {
+    this->SetNumberOfWorkUnitsOfRegistration(registration, numberOfWorkUnitsPerRegistration);
+  }
+
+  // Each work unit runs the next registration which has not been started
+  // yet until there is none left, so that registrations of different
+  // durations keep all the work units busy.  The work units are threads of
+  // their own, which mostly wait for the computations of their registration
+  // on the default multi-threader: were they threads of its pool, these
+  // computations could wait for a thread of the pool forever.
+  std::atomic<SizeValueType> nextIndex{ 0 };
+
+  auto multiThreader = PlatformMultiThreader::New();
+  multiThreader->SetMaximumNumberOfThreads(m_NumberOfConcurrentRegistrations);
+  multiThreader->SetNumberOfWorkUnits(m_NumberOfConcurrentRegistrations);
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfConcurrentRegistrations,
+    [this, &nextIndex, numberOfRegistrations](SizeValueType) {
+      for (SizeValueType index = nextIndex++; index < numberOfRegistrations; index = nextIndex++)
+      {
+        this->RunRegistration(index);
+      }
+    },
+    nullptr);
+
+  SizeValueType numberOfFailures = 0;
+  for (const auto & errorDescription : m_ErrorDescriptions)
+  {
+    numberOfFailures += errorDescription.empty() ? 0 : 1;
+  }
+  if (numberOfFailures > 0)
+  {
+    itkExceptionMacro(<< numberOfFailures << " of the " << numberOfRegistrations
+                      << " registrations failed; see GetErrorDescription().");
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::RunRegistration(const SizeValueType index)
+{
+  RegistrationMethodType * registration = m_Registrations[index];
+  MetricValuesType &       metricValues = m_MetricValues[index];
+
+  auto *              optimizer = registration->GetModifiableOptimizer();
+  const unsigned long observerTag =
+    optimizer->AddObserver(IterationEvent(), [optimizer, &metricValues](const EventObject &) {
+      metricValues.push_back(optimizer->GetCurrentMetricValue());
+    });
+
+  try
+  {
+    registration->Update();
+  }
+  catch (const ExceptionObject & exception)
+  {
+    m_ErrorDescriptions[index] = exception.GetDescription();
+  }
+  catch (const std::exception & exception)
+  {
+    m_ErrorDescriptions[index] = exception.what();
+  }
+  optimizer->RemoveObserver(observerTag);
+
+  // The smoothed copies of the moving images are not needed by the other
+  // registrations, unless they are the fixed image
+  using MultiMetricType = typename RegistrationMethodType::MultiMetricType;
+  const auto *        multiMetric = dynamic_cast<const MultiMetricType *>(registration->GetMetric());
+  const SizeValueType numberOfMovingImages = multiMetric != nullptr ? multiMetric->GetNumberOfMetrics() : 1;
+  for (SizeValueType n = 0; n < numberOfMovingImages; ++n)
+  {
+    const MovingImageType * movingImage = registration->GetMovingImage(n);
+    if (movingImage != nullptr && movingImage != m_FixedImage.GetPointer())
+    {
+      m_PyramidCache->RemoveImages(movingImage);
+    }
+  }
+}
+
+template <typename TRegistrationMethod>
+void
+BatchImageRegistrationMethodv4<TRegistrationMethod>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(FixedImage);
+  itkPrintSelfObjectMacro(PyramidCache);
+  os << indent << "NumberOfRegistrations: " << m_Registrations.size() << std::endl;
+  os << indent << "MaximumNumberOfConcurrentRegistrations: " << m_MaximumNumberOfConcurrentRegistrations << std::endl;
+  os << indent << "MemoryBudget: " << m_MemoryBudget << std::endl;
+  os << indent << "NumberOfConcurrentRegistrations: " << m_NumberOfConcurrentRegistrations << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -25,6 +25,7 @@
 #include "itkObjectToObjectMetricBase.h"
 #include "itkObjectToObjectMultiMetricv4.h"
 #include "itkObjectToObjectOptimizerBase.h"
+#include "itkImageRegistrationPyramidCache.h"
 #include "itkImageToImageMetricv4.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
@@ -47,12 +48,17 @@ public:
    * \class MetricSamplingStrategy
    * \ingroup ITKRegistrationMethodsv4
    * \brief enum type for metric sampling strategy
+   *
+   * REGULAR and RANDOM samples are drawn once per level.  STOCHASTIC samples
+   * are stratified random samples which are drawn again after each iteration
+   * of the optimizer, for stochastic gradient descent.
    */
   enum class MetricSamplingStrategy : uint8_t
   {
     NONE,
     REGULAR,
-    RANDOM
+    RANDOM,
+    STOCHASTIC
   };
 };
 // Define how to print enumeration
@@ -102,6 +108,12 @@ extern ITKRegistrationMethodsv4_EXPORT std::ostream &
  * given stage so typical use will be to assign the base adaptor class to
  * level 0 of all stages but we leave that open to the user.
  *
+ * Pyramid cache:  The stages of a multistage registration usually smooth
+ * the same fixed and moving images, and shrink the same virtual domain, with
+ * the same schedule.  Giving all the stages the same
+ * ImageRegistrationPyramidCache computes these images only once, as well as
+ * across the registrations of many images to the same template.
+ *
  * Output: The output is the updated transform.
  *
  * \author Nick Tustison
@@ -303,7 +315,15 @@ public:
   itkSetObjectMacro(Metric, MetricType);
   itkGetModifiableObjectMacro(Metric, MetricType);
 
-  /** Set/Get the metric sampling strategy. */
+  /** Set/Get the metric sampling strategy.
+   *
+   * With the STOCHASTIC strategy, the metric is evaluated on a new random
+   * sample, of the size given by the metric sampling percentage, at each
+   * iteration of the optimizer: each iteration is cheap, but its metric value
+   * and gradient are noisy.  The learning rate decay of
+   * GradientDescentOptimizerv4 averages out this noise, and the window of
+   * its convergence monitoring should be larger than with fixed samples.
+   */
   itkSetEnumMacro(MetricSamplingStrategy, MetricSamplingStrategyEnum);
   itkGetEnumMacro(MetricSamplingStrategy, MetricSamplingStrategyEnum);
 
@@ -433,6 +453,14 @@ public:
   itkGetConstMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits, bool);
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
 
+  /**
+   * Set/Get the cache of the smoothed images and of the shrunk virtual domains
+   * of the levels, which may be shared with other registration methods.  By
+   * default, there is no cache and these images are computed at each level.
+   */
+  itkSetObjectMacro(PyramidCache, ImageRegistrationPyramidCache);
+  itkGetModifiableObjectMacro(PyramidCache, ImageRegistrationPyramidCache);
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -560,6 +588,7 @@ protected:
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel{};
   SmoothingSigmasArrayType                            m_SmoothingSigmasPerLevel{};
   bool                                                m_SmoothingSigmasAreSpecifiedInPhysicalUnits{};
+  ImageRegistrationPyramidCache::Pointer              m_PyramidCache{};
 
   bool m_ReseedIterator{};
   int  m_RandomSeed{};
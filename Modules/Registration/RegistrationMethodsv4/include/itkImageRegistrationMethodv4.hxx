@@ -20,6 +20,7 @@
 
 
 #include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "itkCommand.h"
 #include "itkGradientDescentOptimizerv4.h"
 #include "itkImageRandomConstIteratorWithIndex.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
@@ -27,6 +28,7 @@
 #include "itkIterationReporter.h"
 #include "itkMattesMutualInformationImageToImageMetricv4.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkMultiThreaderBase.h"
 #include "itkRegistrationParameterScalesFromPhysicalShift.h"
 #include "itkPrintHelper.h"
 
@@ -462,15 +464,20 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   //   1. subsample the reference domain (typically the fixed image) and/or
   //   2. smooth the fixed and moving images.
 
-  typename VirtualImageType::Pointer currentLevelVirtualDomainImage = nullptr;
-  if (this->m_VirtualDomainImage.IsNotNull())
+  typename VirtualImageType::ConstPointer currentLevelVirtualDomainImage = nullptr;
+  if (this->m_VirtualDomainImage.IsNotNull() && this->m_PyramidCache.IsNotNull())
+  {
+    currentLevelVirtualDomainImage = this->m_PyramidCache->template GetShrunkDomainImage<VirtualImageType>(
+      this->m_VirtualDomainImage, this->m_ShrinkFactorsPerLevel[level]);
+  }
+  else if (this->m_VirtualDomainImage.IsNotNull())
   {
     auto shrinkFilter = ShrinkFilterType::New();
     shrinkFilter->SetShrinkFactors(this->m_ShrinkFactorsPerLevel[level]);
     shrinkFilter->SetInput(this->m_VirtualDomainImage);
+    shrinkFilter->Update();
 
     currentLevelVirtualDomainImage = shrinkFilter->GetOutput();
-    currentLevelVirtualDomainImage->Update();
   }
   else
   {
@@ -612,8 +619,6 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       if (this->m_SmoothingSigmasPerLevel[level] > 0)
       {
         using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
-        typename FixedImageSmoothingFilterType::Pointer fixedImageSmoothingFilter =
-          FixedImageSmoothingFilterType::New();
         typename FixedImageSmoothingFilterType::SigmaArrayType fixedImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -625,16 +630,8 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             fixedImageSigmaArray[i] *= fixedSpacing[i];
           }
         }
-        fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
-        fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
-
-        this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
-        fixedImageSmoothingFilter->Update();
-        fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
 
         using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
-        typename MovingImageSmoothingFilterType::Pointer movingImageSmoothingFilter =
-          MovingImageSmoothingFilterType::New();
         typename MovingImageSmoothingFilterType::SigmaArrayType movingImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -646,12 +643,36 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             movingImageSigmaArray[i] *= movingSpacing[i];
           }
         }
-        movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
-        movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
 
-        this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
-        movingImageSmoothingFilter->Update();
-        movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        if (this->m_PyramidCache.IsNotNull())
+        {
+          this->m_FixedSmoothImages[n] = this->m_PyramidCache->GetSmoothedImage(
+            this->GetFixedImage(n), fixedImageSigmaArray, this->GetNumberOfWorkUnits());
+          this->m_MovingSmoothImages[n] = this->m_PyramidCache->GetSmoothedImage(
+            this->GetMovingImage(n), movingImageSigmaArray, this->GetNumberOfWorkUnits());
+        }
+        else
+        {
+          typename FixedImageSmoothingFilterType::Pointer fixedImageSmoothingFilter =
+            FixedImageSmoothingFilterType::New();
+          fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
+          fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
+          fixedImageSmoothingFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+          this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
+          fixedImageSmoothingFilter->Update();
+          fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+
+          typename MovingImageSmoothingFilterType::Pointer movingImageSmoothingFilter =
+            MovingImageSmoothingFilterType::New();
+          movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
+          movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
+          movingImageSmoothingFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
+          this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
+          movingImageSmoothingFilter->Update();
+          movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        }
       }
       else
       {
@@ -818,13 +839,38 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   // Ensure the same seed is used for each update
   this->m_CurrentRandomSeed = this->m_RandomSeed;
 
-  for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+  // With stochastic sampling, new samples are drawn after each iteration
+  unsigned long samplingObserverTag = 0;
+  if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
   {
-    this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
+    auto samplingCommand = SimpleMemberCommand<Self>::New();
+    samplingCommand->SetCallbackFunction(this, &Self::SetMetricSamplePoints);
+    samplingObserverTag = this->m_Optimizer->AddObserver(IterationEvent(), samplingCommand);
+  }
+
+  try
+  {
+    for (this->m_CurrentLevel = 0; this->m_CurrentLevel < this->m_NumberOfLevels; this->m_CurrentLevel++)
+    {
+      this->InitializeRegistrationAtEachLevel(this->m_CurrentLevel);
 
-    this->m_Metric->Initialize();
+      this->m_Metric->Initialize();
+
+      this->m_Optimizer->StartOptimization();
+    }
+  }
+  catch (...)
+  {
+    if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
+    {
+      this->m_Optimizer->RemoveObserver(samplingObserverTag);
+    }
+    throw;
+  }
 
-    this->m_Optimizer->StartOptimization();
+  if (this->m_MetricSamplingStrategy == MetricSamplingStrategyEnum::STOCHASTIC)
+  {
+    this->m_Optimizer->RemoveObserver(samplingObserverTag);
   }
 }
 
@@ -1029,6 +1075,72 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
         }
         break;
       }
+      case MetricSamplingStrategyEnum::STOCHASTIC:
+      {
+        // Stratified sampling: the voxels of the virtual domain, in memory
+        // order, are split into strata of equal size, and a random voxel is
+        // drawn in each stratum.  The samples are drawn in parallel, in
+        // blocks whose seeds only depend on the sampling seed, so that
+        // they do not depend on the number of threads.
+        const SizeValueType totalVirtualDomainVoxels = virtualDomainRegion.GetNumberOfPixels();
+        const SizeValueType sampleCount = std::max(
+          SizeValueType{ 1 },
+          static_cast<SizeValueType>(static_cast<double>(totalVirtualDomainVoxels) *
+                                     this->m_MetricSamplingPercentagePerLevel[this->m_CurrentLevel]));
+        const double stratumSize = static_cast<double>(totalVirtualDomainVoxels) / static_cast<double>(sampleCount);
+
+        std::vector<SamplePointType> points(sampleCount);
+        std::vector<unsigned char>   isInside(sampleCount);
+
+        constexpr SizeValueType blockSize = 4096;
+        const auto              blockSeed = randomizer->GetIntegerVariate();
+        auto                    multiThreader = MultiThreaderBase::New();
+        multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+        multiThreader->ParallelizeArray(
+          0,
+          (sampleCount + blockSize - 1) / blockSize,
+          [&](SizeValueType block) {
+            auto blockRandomizer = RandomizerType::New();
+            blockRandomizer->SetSeed(static_cast<typename RandomizerType::IntegerType>(blockSeed + block));
+
+            const SizeValueType blockEnd = std::min(sampleCount, (block + 1) * blockSize);
+            for (SizeValueType k = block * blockSize; k < blockEnd; ++k)
+            {
+              auto offset = std::min(
+                totalVirtualDomainVoxels - 1,
+                static_cast<SizeValueType>((static_cast<double>(k) + blockRandomizer->GetVariateWithOpenUpperRange()) *
+                                           stratumSize));
+              typename VirtualDomainImageType::IndexType voxelIndex;
+              for (unsigned int d = 0; d < ImageDimension; ++d)
+              {
+                voxelIndex[d] = virtualDomainRegion.GetIndex(d) +
+                                static_cast<IndexValueType>(offset % virtualDomainRegion.GetSize(d));
+                offset /= virtualDomainRegion.GetSize(d);
+              }
+
+              SamplePointType & point = points[k];
+              virtualImage->TransformIndexToPhysicalPoint(voxelIndex, point);
+
+              // randomly perturb the point within a voxel (approximately)
+              for (unsigned int d = 0; d < ImageDimension; ++d)
+              {
+                point[d] += blockRandomizer->GetNormalVariate() * oneThirdVirtualSpacing[d];
+              }
+              isInside[k] = !fixedMaskImage || fixedMaskImage->IsInsideInWorldSpace(point);
+            }
+          },
+          nullptr);
+
+        for (SizeValueType k = 0; k < sampleCount; ++k)
+        {
+          if (isInside[k])
+          {
+            samplePointSet->SetPoint(index, points[k]);
+            ++index;
+          }
+        }
+        break;
+      }
       default:
       {
         itkExceptionMacro("Invalid sampling strategy requested.");
@@ -1195,6 +1307,8 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
      << "SmoothingSigmasAreSpecifiedInPhysicalUnits: " << (m_SmoothingSigmasAreSpecifiedInPhysicalUnits ? "On" : "Off")
      << std::endl;
 
+  itkPrintSelfObjectMacro(PyramidCache);
+
   os << indent << "ReseedIterator: " << (m_ReseedIterator ? "On" : "Off") << std::endl;
   os << indent << "RandomSeed: " << m_RandomSeed << std::endl;
   os << indent << "CurrentRandomSeed: " << m_CurrentRandomSeed << std::endl;
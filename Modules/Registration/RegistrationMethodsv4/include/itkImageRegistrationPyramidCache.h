@@ -0,0 +1,235 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_h
+#define itkImageRegistrationPyramidCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkShrinkImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+#include "ITKRegistrationMethodsv4Export.h"
+
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <typeindex>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageRegistrationPyramidCache
+ * \brief Shares the images of the resolution levels between registrations.
+ *
+ * At each level, ImageRegistrationMethodv4 and its subclasses smooth the
+ * fixed and moving images and shrink the virtual domain.  The stages of a
+ * multi-stage registration which use the same images (e.g., rigid, then
+ * affine, then SyN), or the registrations of many subjects to the same
+ * template, compute the same images again and again.  Giving all these
+ * registration methods the same cache, with SetPyramidCache(), computes
+ * each of these images only once.
+ *
+ * Smoothed images are keyed by the address and the modification time of
+ * the input image and by the smoothing sigmas, so that an input which is
+ * modified, and which therefore has a new modification time, is smoothed
+ * again.  Its new smoothed images replace the former ones.  Shrunk domains
+ * only depend on the geometry of the input domain and on the shrink
+ * factors.  The images stay in the cache until RemoveImages() is called
+ * with their input, Clear() is called or the cache is destroyed.  The
+ * smoothed copies of an image which is no longer registered, e.g., a moving
+ * image whose registration is done, should be removed with RemoveImages()
+ * for the cache not to grow with the number of images.
+ *
+ * The cache may be used by several threads at once.  The images are
+ * computed outside of its lock, so that threads requesting different images
+ * do not wait for each other.
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+class ITKRegistrationMethodsv4_EXPORT ImageRegistrationPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegistrationPyramidCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegistrationPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** \see LightObject::GetNameOfClass() */
+  itkOverrideGetNameOfClassMacro(ImageRegistrationPyramidCache);
+
+  /** Get the image smoothed by SmoothingRecursiveGaussianImageFilter with
+   * the given sigmas, in physical units.  If the image is not in the cache,
+   * the filter runs with the given number of work units, or with its
+   * default number of work units if it is zero. */
+  template <typename TImage>
+  typename TImage::ConstPointer
+  GetSmoothedImage(const TImage *                                                                         image,
+                   const typename SmoothingRecursiveGaussianImageFilter<TImage, TImage>::SigmaArrayType & sigmas,
+                   ThreadIdType numberOfWorkUnits = 0);
+
+  /** Get an image on the domain which ShrinkImageFilter produces from an
+   * image on the given domain with the given shrink factors.  As for the
+   * virtual domain of the registration, only the geometry of the returned
+   * image is meaningful: its buffer is allocated but not initialized. */
+  template <typename TImage>
+  typename TImage::ConstPointer
+  GetShrunkDomainImage(const ImageBase<TImage::ImageDimension> *                             domain,
+                       const typename ShrinkImageFilter<TImage, TImage>::ShrinkFactorsType & shrinkFactors);
+
+  /** Remove the images computed from the given input image from the
+   * cache.  The registrations which already got them keep them. */
+  void
+  RemoveImages(const DataObject * image);
+
+  /** Remove all the images from the cache. */
+  void
+  Clear();
+
+  /** Get the number of images in the cache. */
+  SizeValueType
+  GetNumberOfImages() const;
+
+protected:
+  ImageRegistrationPyramidCache() = default;
+  ~ImageRegistrationPyramidCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The input image, its modification time, the type of the output image
+   * and the parameters of the operation identify a cached image.  The
+   * parameters start with a code of the operation. */
+  struct KeyType
+  {
+    const void *        Image;
+    ModifiedTimeType    ModifiedTime;
+    std::type_index     ImageType;
+    std::vector<double> Parameters;
+
+    bool
+    operator<(const KeyType & other) const
+    {
+      return std::tie(Image, ModifiedTime, ImageType, Parameters) <
+             std::tie(other.Image, other.ModifiedTime, other.ImageType, other.Parameters);
+    }
+  };
+
+  /** Get the image of the key, or nullptr if it is not in the cache. */
+  DataObject::ConstPointer
+  FindImage(const KeyType & key) const;
+
+  /** Add the image of the key to the cache and return the cached image,
+   * which is the one of another thread which added it first, if any.  The
+   * images computed from an older version of the input are removed. */
+  DataObject::ConstPointer
+  AddImage(const KeyType & key, const DataObject * image);
+
+  mutable std::mutex                          m_Mutex{};
+  std::map<KeyType, DataObject::ConstPointer> m_Images{};
+};
+
+
+template <typename TImage>
+typename TImage::ConstPointer
+ImageRegistrationPyramidCache::GetSmoothedImage(
+  const TImage *                                                                         image,
+  const typename SmoothingRecursiveGaussianImageFilter<TImage, TImage>::SigmaArrayType & sigmas,
+  const ThreadIdType                                                                     numberOfWorkUnits)
+{
+  KeyType key{ image, image->GetMTime(), std::type_index(typeid(TImage)), { 0.0 } };
+  key.Parameters.insert(key.Parameters.end(), sigmas.cbegin(), sigmas.cend());
+
+  const DataObject::ConstPointer cachedImage = this->FindImage(key);
+  if (cachedImage.IsNotNull())
+  {
+    return static_cast<const TImage *>(cachedImage.GetPointer());
+  }
+
+  using SmoothingFilterType = SmoothingRecursiveGaussianImageFilter<TImage, TImage>;
+  auto smoothingFilter = SmoothingFilterType::New();
+  smoothingFilter->SetSigmaArray(sigmas);
+  smoothingFilter->SetInput(image);
+  if (numberOfWorkUnits > 0)
+  {
+    smoothingFilter->SetNumberOfWorkUnits(numberOfWorkUnits);
+  }
+  smoothingFilter->Update();
+
+  typename TImage::Pointer smoothedImage = smoothingFilter->GetOutput();
+  smoothedImage->DisconnectPipeline();
+  return static_cast<const TImage *>(this->AddImage(key, smoothedImage).GetPointer());
+}
+
+
+template <typename TImage>
+typename TImage::ConstPointer
+ImageRegistrationPyramidCache::GetShrunkDomainImage(
+  const ImageBase<TImage::ImageDimension> *                             domain,
+  const typename ShrinkImageFilter<TImage, TImage>::ShrinkFactorsType & shrinkFactors)
+{
+  constexpr unsigned int ImageDimension = TImage::ImageDimension;
+
+  KeyType key{ nullptr, 0, std::type_index(typeid(TImage)), { 1.0 } };
+  const auto & region = domain->GetLargestPossibleRegion();
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    key.Parameters.insert(key.Parameters.end(),
+                          { static_cast<double>(shrinkFactors[d]),
+                            domain->GetOrigin()[d],
+                            domain->GetSpacing()[d],
+                            static_cast<double>(region.GetIndex(d)),
+                            static_cast<double>(region.GetSize(d)) });
+    for (unsigned int e = 0; e < ImageDimension; ++e)
+    {
+      key.Parameters.push_back(domain->GetDirection()(d, e));
+    }
+  }
+
+  const DataObject::ConstPointer cachedImage = this->FindImage(key);
+  if (cachedImage.IsNotNull())
+  {
+    return static_cast<const TImage *>(cachedImage.GetPointer());
+  }
+
+  // The filter only needs the information of its input to compute the
+  // information of its output
+  auto domainImage = TImage::New();
+  domainImage->CopyInformation(domain);
+  domainImage->SetRegions(region);
+
+  using ShrinkFilterType = ShrinkImageFilter<TImage, TImage>;
+  auto shrinkFilter = ShrinkFilterType::New();
+  shrinkFilter->SetShrinkFactors(shrinkFactors);
+  shrinkFilter->SetInput(domainImage);
+  shrinkFilter->UpdateOutputInformation();
+
+  auto shrunkDomainImage = TImage::New();
+  shrunkDomainImage->CopyInformation(shrinkFilter->GetOutput());
+  shrunkDomainImage->SetRegions(shrinkFilter->GetOutput()->GetLargestPossibleRegion());
+  shrunkDomainImage->Allocate();
+  return static_cast<const TImage *>(this->AddImage(key, shrunkDomainImage).GetPointer());
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageRegistrationPyramidCache.h"
+
+#include <iterator>
+
+namespace itk
+{
+
+void
+ImageRegistrationPyramidCache::RemoveImages(const DataObject * image)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto it = m_Images.begin(); it != m_Images.end();)
+  {
+    it = it->first.Image == image ? m_Images.erase(it) : std::next(it);
+  }
+}
+
+
+void
+ImageRegistrationPyramidCache::Clear()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Images.clear();
+}
+
+
+SizeValueType
+ImageRegistrationPyramidCache::GetNumberOfImages() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_Images.size());
+}
+
+
+DataObject::ConstPointer
+ImageRegistrationPyramidCache::FindImage(const KeyType & key) const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto                        it = m_Images.find(key);
+  return it == m_Images.end() ? nullptr : it->second;
+}
+
+
+DataObject::ConstPointer
+ImageRegistrationPyramidCache::AddImage(const KeyType & key, const DataObject * image)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  if (key.Image != nullptr)
+  {
+    for (auto it = m_Images.begin(); it != m_Images.end();)
+    {
+      it = it->first.Image == key.Image && it->first.ModifiedTime < key.ModifiedTime ? m_Images.erase(it)
+                                                                                      : std::next(it);
+    }
+  }
+  return m_Images.emplace(key, image).first->second;
+}
+
+
+void
+ImageRegistrationPyramidCache::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfImages: " << this->GetNumberOfImages() << std::endl;
+}
+
+} // end namespace itk
@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBatchImageRegistrationMethodv4.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegistrationMethodv4TestSupport.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+#include "itkTranslationTransform.h"
+
+#include <cmath>
+
+/*
+ * Verify that a batch of translation registrations to the same fixed image,
+ * run concurrently, gives the same transforms, up to rounding, as the
+ * registrations run one after the other, in less time when there are threads
+ * to share, that the registrations share the threads of the default
+ * multi-threader, that only the images of the fixed image are left in the
+ * pyramid cache, and that a failing registration does not stop the others.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+constexpr unsigned int NumberOfMovingImages = 6;
+
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType, ImageType>;
+using BatchType = itk::BatchImageRegistrationMethodv4<RegistrationType>;
+
+RegistrationType::Pointer
+CreateRegistration(const ImageType * movingImage)
+{
+  auto registration = RegistrationType::New();
+  ImageRegistrationMethodv4TestSupport::SetUpMeanSquaresRegistration(
+    registration.GetPointer(), 20, { 2, 1 }, { 1.0, 0.0 });
+  registration->SetMovingImage(movingImage);
+  return registration;
+}
+
+// The registrations of the batch use fewer work units than those run one
+// after the other, which changes the rounding of the sums of the metric
+bool
+AreParametersClose(const TransformType::ParametersType & parameters,
+                   const TransformType::ParametersType & expectedParameters)
+{
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    if (std::abs(parameters[d] - expectedParameters[d]) > 1e-6)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkBatchImageRegistrationMethodv4Test(int, char *[])
+{
+  using ImageRegistrationMethodv4TestSupport::CreateBlobImage;
+  const auto fixedImage = CreateBlobImage<ImageType>(31.0, 27.0);
+
+  std::vector<ImageType::Pointer> movingImages;
+  for (unsigned int i = 0; i < NumberOfMovingImages; ++i)
+  {
+    movingImages.push_back(CreateBlobImage<ImageType>(31.0 + 0.5 * i, 27.0 - 0.25 * i));
+  }
+
+  // The registrations run one after the other
+  std::vector<TransformType::ParametersType> expectedParameters;
+  itk::TimeProbe                             serialProbe;
+  serialProbe.Start();
+  for (const auto & movingImage : movingImages)
+  {
+    auto registration = CreateRegistration(movingImage);
+    registration->SetFixedImage(fixedImage);
+    registration->Update();
+    expectedParameters.push_back(registration->GetTransform()->GetParameters());
+  }
+  serialProbe.Stop();
+
+  auto batch = BatchType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(batch, BatchImageRegistrationMethodv4, Object);
+
+  ITK_TRY_EXPECT_EXCEPTION(batch->Update());
+
+  batch->SetFixedImage(fixedImage);
+  ITK_TEST_SET_GET_VALUE(fixedImage, batch->GetFixedImage());
+  ITK_TEST_EXPECT_TRUE(batch->GetPyramidCache() != nullptr);
+  ITK_TEST_EXPECT_EQUAL(batch->GetMaximumNumberOfConcurrentRegistrations(),
+                        itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
+  batch->SetMaximumNumberOfConcurrentRegistrations(4);
+  ITK_TEST_SET_GET_VALUE(4, batch->GetMaximumNumberOfConcurrentRegistrations());
+  ITK_TEST_SET_GET_VALUE(0, batch->GetMemoryBudget());
+
+  for (const auto & movingImage : movingImages)
+  {
+    batch->AddRegistration(CreateRegistration(movingImage));
+  }
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfRegistrations(), NumberOfMovingImages);
+
+  itk::TimeProbe batchProbe;
+  batchProbe.Start();
+  ITK_TRY_EXPECT_NO_EXCEPTION(batch->Update());
+  batchProbe.Stop();
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfConcurrentRegistrations(), 4);
+
+  // The four registrations running at the same time share the threads
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const itk::ThreadIdType numberOfWorkUnits = std::max<itk::ThreadIdType>(1, numberOfThreads / 4);
+  for (unsigned int i = 0; i < NumberOfMovingImages; ++i)
+  {
+    const RegistrationType * registration = batch->GetRegistration(i);
+    ITK_TEST_EXPECT_EQUAL(registration->GetNumberOfWorkUnits(), numberOfWorkUnits);
+    ITK_TEST_EXPECT_EQUAL(registration->GetOptimizer()->GetNumberOfWorkUnits(), numberOfWorkUnits);
+    ITK_TEST_EXPECT_TRUE(
+      dynamic_cast<const RegistrationType::ImageMetricType *>(registration->GetMetric())->GetNumberOfWorkUnitsUsed() <=
+      numberOfWorkUnits);
+  }
+
+  // The small registrations do not use many threads each: with four threads
+  // or more, running them concurrently is faster than one after the other
+  std::cout << "Serial registrations: " << serialProbe.GetTotal() << " s, batch with " << numberOfThreads
+            << " threads: " << batchProbe.GetTotal() << " s" << std::endl;
+  if (numberOfThreads >= 4)
+  {
+    ITK_TEST_EXPECT_TRUE(batchProbe.GetTotal() < serialProbe.GetTotal());
+  }
+
+  for (unsigned int i = 0; i < NumberOfMovingImages; ++i)
+  {
+    const auto parameters = batch->GetRegistration(i)->GetTransform()->GetParameters();
+    std::cout << "Registration " << i << ": " << parameters << std::endl;
+    ITK_TEST_EXPECT_TRUE(AreParametersClose(parameters, expectedParameters[i]));
+    ITK_TEST_EXPECT_EQUAL(batch->GetMetricValues(i).size(), 40);
+    ITK_TEST_EXPECT_TRUE(batch->GetMetricValues(i).back() < batch->GetMetricValues(i).front() || i == 0);
+    ITK_TEST_EXPECT_TRUE(batch->GetErrorDescription(i).empty());
+  }
+
+  // The fixed image smoothed at the first level and the two virtual domains
+  // are shared, and the smoothed moving images are removed once their
+  // registration is done
+  ITK_TEST_EXPECT_EQUAL(batch->GetPyramidCache()->GetNumberOfImages(), 3);
+
+  // The memory budget only lets two registrations run at the same time
+  const auto numberOfPixels = fixedImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  batch->SetMemoryBudget(2 * numberOfPixels * (sizeof(double) + sizeof(itk::CovariantVector<double, Dimension>)));
+  ITK_TRY_EXPECT_NO_EXCEPTION(batch->Update());
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfConcurrentRegistrations(), 2);
+
+  // A registration without moving image fails, the others succeed
+  batch->SetMemoryBudget(0);
+  batch->AddRegistration(CreateRegistration(nullptr));
+  ITK_TRY_EXPECT_EXCEPTION(batch->Update());
+  ITK_TEST_EXPECT_TRUE(!batch->GetErrorDescription(NumberOfMovingImages).empty());
+  std::cout << "Error description: " << batch->GetErrorDescription(NumberOfMovingImages) << std::endl;
+  for (unsigned int i = 0; i < NumberOfMovingImages; ++i)
+  {
+    ITK_TEST_EXPECT_TRUE(
+      AreParametersClose(batch->GetRegistration(i)->GetTransform()->GetParameters(), expectedParameters[i]));
+    ITK_TEST_EXPECT_TRUE(batch->GetErrorDescription(i).empty());
+  }
+
+  batch->ClearRegistrations();
+  ITK_TEST_EXPECT_EQUAL(batch->GetNumberOfRegistrations(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkImageRegistrationMethodv4TestSupport_h
+#define itkImageRegistrationMethodv4TestSupport_h
+
+#include "itkGradientDescentOptimizerv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkRegistrationParameterScalesFromPhysicalShift.h"
+
+#include <cmath>
+#include <vector>
+
+// Fixtures shared by the tests which run small registrations of 2-D images
+// of a smooth blob: the images, and a mean squares registration with a
+// gradient descent optimizer whose learning rate is estimated from the
+// physical shifts of the parameters.
+
+namespace ImageRegistrationMethodv4TestSupport
+{
+/** 64x56 image of an elongated Gaussian blob centered at (centerX,
+ * centerY). */
+template <typename TImage>
+typename TImage::Pointer
+CreateBlobImage(double centerX, double centerY)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 64, 56 } });
+  image->Allocate();
+
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - centerX;
+    const double y = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0));
+  }
+  return image;
+}
+
+/** Give the registration a mean squares metric and a gradient descent
+ * optimizer running numberOfIterations iterations per level, and one level
+ * per shrink factor, with the given smoothing sigmas. */
+template <typename TRegistration>
+void
+SetUpMeanSquaresRegistration(TRegistration *                   registration,
+                             unsigned int                      numberOfIterations,
+                             const std::vector<unsigned int> & shrinkFactors,
+                             const std::vector<double> &       smoothingSigmas)
+{
+  using MetricType = itk::MeanSquaresImageToImageMetricv4<typename TRegistration::FixedImageType,
+                                                          typename TRegistration::MovingImageType>;
+
+  auto metric = MetricType::New();
+  registration->SetMetric(metric);
+
+  using ScalesEstimatorType = itk::RegistrationParameterScalesFromPhysicalShift<MetricType>;
+  auto scalesEstimator = ScalesEstimatorType::New();
+  scalesEstimator->SetMetric(metric);
+  scalesEstimator->SetTransformForward(true);
+
+  auto optimizer = itk::GradientDescentOptimizerv4::New();
+  optimizer->SetNumberOfIterations(numberOfIterations);
+  optimizer->SetScalesEstimator(scalesEstimator);
+  optimizer->SetDoEstimateLearningRateOnce(false);
+  optimizer->SetDoEstimateLearningRateAtEachIteration(true);
+  optimizer->SetMaximumStepSizeInPhysicalUnits(0.5);
+  registration->SetOptimizer(optimizer);
+
+  const auto numberOfLevels = static_cast<unsigned int>(shrinkFactors.size());
+  registration->SetNumberOfLevels(numberOfLevels);
+
+  typename TRegistration::ShrinkFactorsArrayType   shrinkFactorsPerLevel(numberOfLevels);
+  typename TRegistration::SmoothingSigmasArrayType smoothingSigmasPerLevel(numberOfLevels);
+  for (unsigned int level = 0; level < numberOfLevels; ++level)
+  {
+    shrinkFactorsPerLevel[level] = shrinkFactors[level];
+    smoothingSigmasPerLevel[level] = smoothingSigmas[level];
+  }
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+}
+} // namespace ImageRegistrationMethodv4TestSupport
+
+#endif
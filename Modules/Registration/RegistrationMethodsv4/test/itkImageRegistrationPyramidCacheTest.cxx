@@ -0,0 +1,119 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAffineTransform.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegistrationMethodv4TestSupport.h"
+#include "itkTestingMacros.h"
+#include "itkTranslationTransform.h"
+
+/*
+ * Verify that a two stage registration, translation then affine, gives the
+ * same transforms with a pyramid cache shared by its stages as without it,
+ * that the images of the levels are only computed once, and that the
+ * images of an input are replaced when it is modified, and removed with
+ * RemoveImages().
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<double, Dimension>;
+using TranslationTransformType = itk::TranslationTransform<double, Dimension>;
+using AffineTransformType = itk::AffineTransform<double, Dimension>;
+using TranslationRegistrationType =
+  itk::ImageRegistrationMethodv4<ImageType, ImageType, TranslationTransformType, ImageType>;
+using AffineRegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, AffineTransformType, ImageType>;
+
+template <typename TRegistration>
+void
+SetUpRegistration(TRegistration *                      registration,
+                  const ImageType *                    fixedImage,
+                  const ImageType *                    movingImage,
+                  itk::ImageRegistrationPyramidCache * cache)
+{
+  ImageRegistrationMethodv4TestSupport::SetUpMeanSquaresRegistration(registration, 10, { 4, 2, 1 }, { 2.0, 1.0, 0.0 });
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetPyramidCache(cache);
+}
+
+AffineTransformType::ParametersType
+RunRegistration(const ImageType *                    fixedImage,
+                const ImageType *                    movingImage,
+                itk::ImageRegistrationPyramidCache * cache)
+{
+  auto translationRegistration = TranslationRegistrationType::New();
+  SetUpRegistration(translationRegistration.GetPointer(), fixedImage, movingImage, cache);
+  translationRegistration->Update();
+
+  auto affineRegistration = AffineRegistrationType::New();
+  SetUpRegistration(affineRegistration.GetPointer(), fixedImage, movingImage, cache);
+  affineRegistration->SetMovingInitialTransform(translationRegistration->GetTransform());
+  affineRegistration->Update();
+
+  return affineRegistration->GetTransform()->GetParameters();
+}
+} // namespace
+
+int
+itkImageRegistrationPyramidCacheTest(int, char *[])
+{
+  using ImageRegistrationMethodv4TestSupport::CreateBlobImage;
+  const auto fixedImage = CreateBlobImage<ImageType>(31.0, 27.0);
+  const auto movingImage = CreateBlobImage<ImageType>(34.0, 25.0);
+
+  auto cache = itk::ImageRegistrationPyramidCache::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cache, ImageRegistrationPyramidCache, Object);
+
+  const auto expectedParameters = RunRegistration(fixedImage, movingImage, nullptr);
+  const auto parameters = RunRegistration(fixedImage, movingImage, cache);
+  std::cout << "Parameters: " << parameters << std::endl;
+  ITK_TEST_EXPECT_EQUAL(parameters, expectedParameters);
+
+  // The fixed and moving images smoothed at the first two levels, and the
+  // virtual domains of the three levels, are shared by the two stages
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 7);
+
+  ITK_TEST_EXPECT_EQUAL(RunRegistration(fixedImage, movingImage, cache), expectedParameters);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 7);
+
+  // A modified image is smoothed again, and its new images replace the
+  // former ones
+  movingImage->Modified();
+  ITK_TEST_EXPECT_EQUAL(RunRegistration(fixedImage, movingImage, cache), expectedParameters);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 7);
+
+  // The images of the moving image are removed, the others are kept
+  cache->RemoveImages(movingImage);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 5);
+  ITK_TEST_EXPECT_EQUAL(RunRegistration(fixedImage, movingImage, cache), expectedParameters);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 7);
+
+  auto registration = AffineRegistrationType::New();
+  ITK_TEST_SET_GET_NULL_VALUE(registration->GetPyramidCache());
+  registration->SetPyramidCache(cache);
+  ITK_TEST_SET_GET_VALUE(cache, registration->GetPyramidCache());
+
+  cache->Clear();
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfImages(), 0);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGradientDescentOptimizerv4.h"
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegistrationMethodv4TestSupport.h"
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkTestingMacros.h"
+#include "itkTranslationTransform.h"
+
+#include <set>
+
+/*
+ * Verify that the stochastic metric sampling strategy draws new samples at
+ * each iteration of the optimizer, that it is reproducible for a given
+ * seed, and that a translation registration with a decaying learning rate
+ * converges with it.
+ */
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+
+using ImageType = itk::Image<double, Dimension>;
+using TransformType = itk::TranslationTransform<double, Dimension>;
+using RegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TransformType, ImageType>;
+using MetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+
+TransformType::ParametersType
+RunRegistration(const ImageType * fixedImage, const ImageType * movingImage, std::set<double> & firstSamples)
+{
+  auto metric = MetricType::New();
+
+  auto optimizer = itk::GradientDescentOptimizerv4::New();
+  optimizer->SetNumberOfIterations(200);
+  optimizer->SetLearningRate(0.02);
+  optimizer->SetLearningRateDecayExponent(0.602);
+  optimizer->SetLearningRateDecayOffset(20.0);
+  optimizer->SetConvergenceWindowSize(200);
+
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetMetric(metric);
+  registration->SetOptimizer(optimizer);
+  registration->SetNumberOfLevels(1);
+  registration->SetSmoothingSigmasPerLevel(RegistrationType::SmoothingSigmasArrayType(1, 0.0));
+  registration->SetMetricSamplingStrategy(RegistrationType::MetricSamplingStrategyEnum::STOCHASTIC);
+  registration->SetMetricSamplingPercentage(0.1);
+  registration->MetricSamplingReinitializeSeed(121212);
+
+  // Record the first sample of each iteration
+  optimizer->AddObserver(itk::IterationEvent(), [&metric, &firstSamples](const itk::EventObject &) {
+    const auto * samples = metric->GetVirtualSampledPointSet();
+    if (samples->GetNumberOfPoints() < 300 || samples->GetNumberOfPoints() > 360)
+    {
+      std::cerr << "Unexpected number of samples " << samples->GetNumberOfPoints() << std::endl;
+      firstSamples.clear();
+    }
+    firstSamples.insert(samples->GetPoint(0)[0]);
+  });
+
+  registration->Update();
+  return registration->GetTransform()->GetParameters();
+}
+} // namespace
+
+int
+itkImageRegistrationStochasticSamplingTest(int, char *[])
+{
+  using ImageRegistrationMethodv4TestSupport::CreateBlobImage;
+  const auto fixedImage = CreateBlobImage<ImageType>(31.0, 27.0);
+  const auto movingImage = CreateBlobImage<ImageType>(34.0, 25.0);
+
+  std::set<double> firstSamples;
+  const auto       parameters = RunRegistration(fixedImage, movingImage, firstSamples);
+  std::cout << "Parameters: " << parameters << std::endl;
+
+  // The samples are drawn again after each of the 200 iterations
+  std::cout << "Number of different first samples: " << firstSamples.size() << std::endl;
+  ITK_TEST_EXPECT_TRUE(firstSamples.size() > 190);
+
+  ITK_TEST_EXPECT_TRUE(std::abs(parameters[0] - 3.0) < 0.1 && std::abs(parameters[1] + 2.0) < 0.1);
+
+  std::set<double> firstSamplesAgain;
+  ITK_TEST_EXPECT_EQUAL(RunRegistration(fixedImage, movingImage, firstSamplesAgain), parameters);
+  ITK_TEST_EXPECT_TRUE(firstSamplesAgain == firstSamples);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}